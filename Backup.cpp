@@ -0,0 +1,1093 @@
+#include "Backup.h"
+
+#include "CancellationToken.h"
+#include "History.h"
+#include "Reflink.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <queue>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <zstd.h>
+
+#if _WIN32
+  #include <fcntl.h>
+  #include <io.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+// maximum number of worker threads used if not configured
+constexpr unsigned int MAX_THREADS{8};
+
+// content-defined chunk size limits; the average size is determined by the
+//  number of bits in the cut mask (2^18 = 256 KiB)
+// NOTE: changing any of these (or the gear table) makes new snapshots share
+//  few chunks with older ones, which costs space until the old ones are pruned
+constexpr std::size_t MIN_CHUNK{64 << 10};
+constexpr std::size_t MAX_CHUNK{1 << 20};
+constexpr std::uint64_t CUT_MASK{(1 << 18) - 1};
+
+// file read buffer size; must be at least `MAX_CHUNK`
+constexpr std::size_t READ_BUFFER{4 << 20};
+
+// snapshot manifest format version
+constexpr int MANIFEST_VERSION{1};
+
+// maximum size of a zstd frame header (ZSTD_FRAMEHEADERSIZE_MAX, which zstd
+//  only exposes through its static linking API)
+constexpr std::size_t ZSTD_HEADER_MAX{18};
+
+// suffixes appended to the names of directories being restored, and of the
+//  directories they replaced
+constexpr std::string_view RESTORE_SUFFIX{".rlsRestore"};
+constexpr std::string_view PRE_RESTORE_SUFFIX{".rlsPreRestore"};
+
+// splitmix64 step, used to fill the gear table
+constexpr std::uint64_t SplitMix64(std::uint64_t x)
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+// random value for each byte value, used by the rolling gear hash
+constexpr std::array<std::uint64_t, 256> GEAR_TABLE([]()
+{
+  std::array<std::uint64_t, 256> table{};
+  for (std::size_t i(0); i < table.size(); ++i) { table[i] = SplitMix64(i); }
+  return table;
+}());
+
+// find the length of the next chunk at the start of the given data
+// a cut is made where the low bits of a gear hash over the preceding ~64 bytes
+//  are all zero, so that cut points depend only on nearby content, and an
+//  insertion or deletion only affects the chunks around it
+std::size_t FindCut(const std::uint8_t* const data, const std::size_t size)
+{
+  if (size <= MIN_CHUNK) { return size; }
+  const std::size_t end(std::min(size, MAX_CHUNK));
+  std::uint64_t hash(0);
+  for (std::size_t i(MIN_CHUNK); i < end; ++i)
+  {
+    hash = (hash << 1) + GEAR_TABLE[data[i]];
+    if (!(hash & CUT_MASK)) { return i + 1; }
+  }
+  return end;
+}
+
+// SHA-256 hash function
+class Sha256
+{
+public:
+
+  void Update(const std::uint8_t* data, std::size_t size)
+  {
+    length_ += size;
+    while (size)
+    {
+      const std::size_t n(std::min(size, block_.size() - blockSize_));
+      std::memcpy(block_.data() + blockSize_, data, n);
+      blockSize_ += n;
+      data += n;
+      size -= n;
+      if (blockSize_ == block_.size())
+      {
+        Transform();
+        blockSize_ = 0;
+      }
+    }
+  }
+
+  // finish hashing, and return digest as lowercase hex
+  std::string Final()
+  {
+    const std::uint64_t bits(length_ * 8);
+    const std::uint8_t pad(0x80);
+    Update(&pad, 1);
+    const std::uint8_t zero(0);
+    while (blockSize_ != 56) { Update(&zero, 1); }
+    std::array<std::uint8_t, 8> lengthBytes{};
+    for (std::size_t i(0); i < 8; ++i)
+    {
+      lengthBytes[i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+    }
+    Update(lengthBytes.data(), lengthBytes.size());
+    std::ostringstream hex;
+    hex << std::hex << std::setfill('0');
+    for (const auto h : state_) { hex << std::setw(8) << h; }
+    return hex.str();
+  }
+
+private:
+
+  static constexpr std::array<std::uint32_t, 64> K
+  {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+  static std::uint32_t Rotr(const std::uint32_t x, const int n)
+  {
+    return (x >> n) | (x << (32 - n));
+  }
+
+  void Transform()
+  {
+    std::array<std::uint32_t, 64> w{};
+    for (std::size_t i(0); i < 16; ++i)
+    {
+      w[i] = static_cast<std::uint32_t>(block_[4 * i]) << 24 |
+        static_cast<std::uint32_t>(block_[4 * i + 1]) << 16 |
+        static_cast<std::uint32_t>(block_[4 * i + 2]) << 8 |
+        static_cast<std::uint32_t>(block_[4 * i + 3]);
+    }
+    for (std::size_t i(16); i < 64; ++i)
+    {
+      const std::uint32_t s0(
+        Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3));
+      const std::uint32_t s1(
+        Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10));
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    auto s(state_);
+    for (std::size_t i(0); i < 64; ++i)
+    {
+      const std::uint32_t s1(Rotr(s[4], 6) ^ Rotr(s[4], 11) ^ Rotr(s[4], 25));
+      const std::uint32_t ch((s[4] & s[5]) ^ (~s[4] & s[6]));
+      const std::uint32_t t1(s[7] + s1 + ch + K[i] + w[i]);
+      const std::uint32_t s0(Rotr(s[0], 2) ^ Rotr(s[0], 13) ^ Rotr(s[0], 22));
+      const std::uint32_t maj((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+      const std::uint32_t t2(s0 + maj);
+      s[7] = s[6];
+      s[6] = s[5];
+      s[5] = s[4];
+      s[4] = s[3] + t1;
+      s[3] = s[2];
+      s[2] = s[1];
+      s[1] = s[0];
+      s[0] = t1 + t2;
+    }
+    for (std::size_t i(0); i < state_.size(); ++i) { state_[i] += s[i]; }
+  }
+
+  std::array<std::uint32_t, 8> state_
+  {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+  std::array<std::uint8_t, 64> block_{};
+  std::size_t blockSize_{0};
+  std::uint64_t length_{0};
+};
+
+// get current local time as a snapshot name
+std::string MakeSnapshotName()
+{
+  const std::time_t t(
+    std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+  std::tm tm{};
+#if _MSC_VER
+  localtime_s(&tm, &t);
+#else
+  localtime_r(&t, &tm);
+#endif
+  std::ostringstream name;
+  name << std::put_time(&tm, "%Y%m%d-%H%M%S");
+  return name.str();
+}
+
+// list snapshot manifests in a repository, oldest first
+std::vector<std::filesystem::path> ListSnapshots(
+  const std::filesystem::path& snapshotsPath)
+{
+  std::vector<std::filesystem::path> snapshots;
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it(snapshotsPath, ec), end;
+    !ec && it != end; it.increment(ec))
+  {
+    if (it->path().extension() == ".json") { snapshots.push_back(*it); }
+  }
+  // names are timestamps, so this sorts by age
+  std::sort(snapshots.begin(), snapshots.end());
+  return snapshots;
+}
+
+// get a copy of a path with a suffix appended to its last component
+std::filesystem::path AppendSuffix(
+  std::filesystem::path path, const std::string_view suffix)
+{
+  path += suffix;
+  return path;
+}
+
+// determine whether a relative path is inside a relative directory
+bool IsWithin(
+  const std::filesystem::path& path, const std::filesystem::path& directory)
+{
+  const auto relative(path.lexically_relative(directory));
+  return !relative.empty() && *relative.begin() != "..";
+}
+
+// read a whole file into a buffer
+bool ReadFile(const std::filesystem::path& path, std::vector<char>& buffer)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) { return false; }
+  const auto size(file.tellg());
+  if (size < 0) { return false; }
+  buffer.resize(static_cast<std::size_t>(size));
+  file.seekg(0);
+  file.read(buffer.data(), size);
+  return !file.fail();
+}
+
+// write a buffer to a new file, and flush it all the way to disk
+bool WriteFileDurably(
+  const std::filesystem::path& path, const void* const data,
+  const std::size_t size)
+{
+  std::FILE* const file(std::fopen(path.string().c_str(), "wb"));
+  if (!file) { return false; }
+  bool success(
+    std::fwrite(data, 1, size, file) == size && !std::fflush(file));
+#if _WIN32
+  success = success && !_commit(_fileno(file));
+#else
+  success = success && !fsync(fileno(file));
+#endif
+  return !std::fclose(file) && success;
+}
+
+// flush an existing file's contents all the way to disk
+bool SyncFile(const std::filesystem::path& path)
+{
+#if _WIN32
+  const int fd(_wopen(path.c_str(), _O_RDWR | _O_BINARY));
+  if (fd < 0) { return false; }
+  const bool success(!_commit(fd));
+  _close(fd);
+#else
+  const int fd(open(path.c_str(), O_RDWR));
+  if (fd < 0) { return false; }
+  const bool success(!fsync(fd));
+  close(fd);
+#endif
+  return success;
+}
+
+// flush a directory's entries to disk, so that renames within it survive
+//  power loss
+// Windows doesn't support this, and NTFS journals renames anyway
+bool SyncDirectory(const std::filesystem::path& path)
+{
+#if _WIN32
+  static_cast<void>(path);
+  return true;
+#else
+  const int fd(open(path.c_str(), O_RDONLY));
+  if (fd < 0) { return false; }
+  const bool success(!fsync(fd));
+  close(fd);
+  return success;
+#endif
+}
+
+// run a worker function on the given number of threads, and wait for all of
+//  them to return
+template <typename F>
+void RunWorkers(const std::size_t threads, const F& worker)
+{
+  std::vector<std::thread> workers;
+  for (std::size_t i(0); i < threads; ++i) { workers.emplace_back(worker); }
+  for (auto& thread : workers) { thread.join(); }
+}
+}
+
+namespace rustLaunchSite
+{
+struct Backup::File
+{
+  // path relative to install directory
+  std::filesystem::path path_;
+  // number of bytes read
+  std::uintmax_t size_{0};
+  // chunk hashes, in file order
+  std::vector<std::string> chunks_;
+};
+
+Backup::Backup(const std::shared_ptr<const Config>& cfgSptr)
+  : installPath_(cfgSptr->GetInstallPath())
+  , repository_(cfgSptr->GetBackup().repository_)
+  , interval_(cfgSptr->GetBackup().intervalMinutes_)
+  , schedule_(cfgSptr->GetBackup().schedule_)
+  , retain_(static_cast<std::size_t>(cfgSptr->GetBackup().retain_))
+  , compressionLevel_(cfgSptr->GetBackup().compressionLevel_)
+  , threads_(static_cast<std::size_t>(cfgSptr->GetBackup().threads_))
+  , historyUptr_(std::make_unique<History>(
+      cfgSptr->GetPathsData() / "backupHistory.jsonl"))
+{
+  sources_.push_back(
+    std::filesystem::path("server") / cfgSptr->GetInstallIdentity());
+  for (const auto& extraPath : cfgSptr->GetBackup().extraPaths_)
+  {
+    sources_.emplace_back(extraPath);
+  }
+  for (auto& source : sources_) { source.make_preferred(); }
+  if (!threads_)
+  {
+    threads_ = std::clamp(std::thread::hardware_concurrency(), 1U, MAX_THREADS);
+  }
+}
+
+Backup::Result Backup::Run(
+  const std::string& reason, const CancellationToken& cancel)
+{
+  std::scoped_lock runLock(runMutex_);
+  Result result;
+  const auto startTime(std::chrono::steady_clock::now());
+  const auto wallTime(std::chrono::system_clock::now());
+  std::error_code ec;
+  const auto snapshotsPath(repository_ / "snapshots");
+  std::filesystem::create_directories(snapshotsPath, ec);
+  if (ec)
+  {
+    std::cout << "WARNING: Failed to create backup repository " << repository_ << ": " << ec.message() << std::endl;
+    return result;
+  }
+  // clone files first if the filesystem supports it, which is practically
+  //  instant, so that the server can't modify them while they're being read
+  const auto stagingPath(repository_ / "staging");
+  std::filesystem::remove_all(stagingPath, ec);
+  bool staged(true);
+  for (const auto& source : sources_)
+  {
+    if (!std::filesystem::exists(installPath_ / source, ec)) { continue; }
+    std::filesystem::create_directories(
+      (stagingPath / source).parent_path(), ec);
+    if (!Reflink::CloneTree(installPath_ / source, stagingPath / source))
+    {
+      staged = false;
+      break;
+    }
+  }
+  if (!staged) { std::filesystem::remove_all(stagingPath, ec); }
+  const auto& root(staged ? stagingPath : installPath_);
+  std::cout << "Starting backup (" << reason << ") from " << (staged ? "reflink clone" : "live files") << std::endl;
+
+  // chunks are queued by the file reader, and hashed, deduplicated,
+  //  compressed and stored by the workers
+  // the queue is bounded, so that memory usage stays at a few MB per worker
+  struct Job
+  {
+    std::size_t file_;
+    std::size_t chunk_;
+    std::vector<std::uint8_t> data_;
+  };
+  std::deque<File> files;
+  std::mutex mutex;
+  std::condition_variable jobAvailable;
+  std::condition_variable spaceAvailable;
+  std::queue<Job> jobs;
+  bool done(false);
+  bool failed(false);
+  // chunks claimed by a worker during this run, to avoid storing a chunk
+  //  twice when it occurs more than once
+  std::unordered_set<std::string> claimed;
+  // directories into which chunks were stored, which must be flushed before
+  //  the manifest referencing them is written
+  std::set<std::filesystem::path> chunkDirs;
+  const std::size_t maxJobs(2 * threads_);
+
+  const auto worker([&]()
+  {
+    ZSTD_CCtx* const cctx(ZSTD_createCCtx());
+    ZSTD_DCtx* const dctx(ZSTD_createDCtx());
+    std::vector<char> compressed;
+    std::vector<std::uint8_t> stored;
+    for (;;)
+    {
+      Job job;
+      {
+        std::unique_lock lock(mutex);
+        jobAvailable.wait(lock, [&]() { return done || !jobs.empty(); });
+        if (jobs.empty()) { break; }
+        job = std::move(jobs.front());
+        jobs.pop();
+      }
+      spaceAvailable.notify_one();
+      Sha256 sha;
+      sha.Update(job.data_.data(), job.data_.size());
+      const auto hash(sha.Final());
+      {
+        std::scoped_lock lock(mutex);
+        files[job.file_].chunks_[job.chunk_] = hash;
+        if (!claimed.insert(hash).second) { continue; }
+      }
+      const auto chunkPath(GetChunkPath(hash));
+      std::error_code wec;
+      bool verified(false);
+      {
+        std::scoped_lock lock(mutex);
+        verified = verifiedChunks_.count(hash) > 0;
+      }
+      if (verified && std::filesystem::file_size(chunkPath, wec) > 0 && !wec)
+      {
+        continue;
+      }
+      // a stored chunk is only reused once it has been read back and found
+      //  to match, so that one left corrupt (e.g. by a power loss) isn't
+      //  referenced by every later snapshot; this is done once per chunk
+      //  while rustLaunchSite runs
+      if (std::filesystem::exists(chunkPath, wec))
+      {
+        stored.resize(job.data_.size());
+        if (dctx && ReadFile(chunkPath, compressed) &&
+          ZSTD_decompressDCtx(
+            dctx, stored.data(), stored.size(),
+            compressed.data(), compressed.size()) == stored.size() &&
+          stored == job.data_)
+        {
+          std::scoped_lock lock(mutex);
+          verifiedChunks_.insert(hash);
+          continue;
+        }
+        std::scoped_lock lock(mutex);
+        std::cout << "WARNING: Replacing corrupt backup chunk " << chunkPath << std::endl;
+      }
+      // store chunk via a temporary file that's flushed to disk before being
+      //  renamed, so that neither an interrupted backup nor a power loss can
+      //  leave a truncated chunk behind for later snapshots to reuse
+      compressed.resize(ZSTD_compressBound(job.data_.size()));
+      const std::size_t size(cctx ? ZSTD_compressCCtx(
+        cctx, compressed.data(), compressed.size(),
+        job.data_.data(), job.data_.size(), compressionLevel_) : 0);
+      auto tempPath(chunkPath);
+      tempPath += ".tmp";
+      bool success(cctx && !ZSTD_isError(size));
+      if (success)
+      {
+        std::filesystem::create_directories(chunkPath.parent_path(), wec);
+        success = WriteFileDurably(tempPath, compressed.data(), size);
+      }
+      if (success)
+      {
+        std::filesystem::rename(tempPath, chunkPath, wec);
+        success = !wec;
+      }
+      std::scoped_lock lock(mutex);
+      if (!success)
+      {
+        std::cout << "WARNING: Failed to store backup chunk " << chunkPath << std::endl;
+        failed = true;
+        continue;
+      }
+      chunkDirs.insert(chunkPath.parent_path());
+      verifiedChunks_.insert(hash);
+      ++result.newChunks_;
+      result.newBytes_ += size;
+    }
+    ZSTD_freeCCtx(cctx);
+    ZSTD_freeDCtx(dctx);
+  });
+  std::vector<std::thread> workers;
+  for (std::size_t i(0); i < threads_; ++i) { workers.emplace_back(worker); }
+
+  // read files sequentially, cutting them into chunks
+  std::vector<std::uint8_t> buffer(READ_BUFFER);
+  for (const auto& relativePath : ListFiles(root))
+  {
+    if (cancel.IsCancelled()) { break; }
+    std::ifstream file(root / relativePath, std::ios::binary);
+    if (!file.is_open())
+    {
+      // files may legitimately disappear (e.g. database journals)
+      std::cout << "WARNING: Skipping backup of unreadable file " << relativePath << std::endl;
+      continue;
+    }
+    std::size_t fileIndex(0);
+    {
+      std::scoped_lock lock(mutex);
+      fileIndex = files.size();
+      files.push_back({relativePath, 0, {}});
+    }
+    std::size_t filled(0);
+    bool eof(false);
+    std::size_t chunkIndex(0);
+    for (;;)
+    {
+      if (!eof)
+      {
+        file.read(
+          reinterpret_cast<char*>(buffer.data() + filled),
+          static_cast<std::streamsize>(buffer.size() - filled));
+        filled += static_cast<std::size_t>(file.gcount());
+        eof = !file;
+      }
+      std::size_t pos(0);
+      while (filled - pos >= MAX_CHUNK || (eof && pos < filled))
+      {
+        const std::size_t cut(FindCut(buffer.data() + pos, filled - pos));
+        Job job{fileIndex, chunkIndex++,
+          std::vector<std::uint8_t>(
+            buffer.begin() + static_cast<std::ptrdiff_t>(pos),
+            buffer.begin() + static_cast<std::ptrdiff_t>(pos + cut))};
+        pos += cut;
+        std::unique_lock lock(mutex);
+        files[fileIndex].size_ += cut;
+        files[fileIndex].chunks_.emplace_back();
+        spaceAvailable.wait(lock, [&]() { return jobs.size() < maxJobs; });
+        jobs.push(std::move(job));
+        lock.unlock();
+        jobAvailable.notify_one();
+      }
+      std::memmove(buffer.data(), buffer.data() + pos, filled - pos);
+      filled -= pos;
+      if (eof || cancel.IsCancelled()) { break; }
+    }
+    if (file.bad())
+    {
+      std::cout << "WARNING: Failed to read file " << relativePath << " for backup" << std::endl;
+      std::scoped_lock lock(mutex);
+      failed = true;
+    }
+  }
+  {
+    std::scoped_lock lock(mutex);
+    done = true;
+  }
+  jobAvailable.notify_all();
+  for (auto& thread : workers) { thread.join(); }
+  if (staged) { std::filesystem::remove_all(stagingPath, ec); }
+  // new chunks must be on disk before the manifest referencing them is
+  // the chunks directory itself may be new as well
+  if (!chunkDirs.empty()) { chunkDirs.insert(repository_ / "chunks"); }
+  for (const auto& dir : chunkDirs)
+  {
+    if (!failed && !SyncDirectory(dir))
+    {
+      std::cout << "WARNING: Failed to flush backup chunk directory " << dir << std::endl;
+      failed = true;
+    }
+  }
+
+  result.duration_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - startTime);
+  if (cancel.IsCancelled())
+  {
+    std::cout << "WARNING: Backup cancelled; no snapshot written" << std::endl;
+    return result;
+  }
+  if (failed)
+  {
+    std::cout << "WARNING: Backup failed; no snapshot written" << std::endl;
+    return result;
+  }
+
+  // write manifest, which is what makes the snapshot exist
+  nlohmann::json jFiles(nlohmann::json::array());
+  for (const auto& file : files)
+  {
+    jFiles.push_back(
+    {
+      {"path", file.path_.generic_string()},
+      {"size", file.size_},
+      {"chunks", file.chunks_}
+    });
+    ++result.files_;
+    result.bytes_ += file.size_;
+    result.chunks_ += file.chunks_.size();
+  }
+  auto name(MakeSnapshotName());
+  while (std::filesystem::exists(snapshotsPath / (name + ".json"), ec))
+  {
+    name += "_";
+  }
+  const nlohmann::json manifest
+  {
+    {"version", MANIFEST_VERSION},
+    {"time", History::ToIsoString(wallTime)},
+    {"reason", reason},
+    {"files", jFiles}
+  };
+  const auto manifestPath(snapshotsPath / (name + ".json"));
+  auto tempPath(manifestPath);
+  tempPath += ".tmp";
+  if (const auto data(manifest.dump() + '\n');
+    !WriteFileDurably(tempPath, data.data(), data.size()))
+  {
+    std::cout << "WARNING: Failed to write backup manifest " << tempPath << std::endl;
+    return result;
+  }
+  std::filesystem::rename(tempPath, manifestPath, ec);
+  if (ec || !SyncDirectory(snapshotsPath))
+  {
+    std::cout << "WARNING: Failed to write backup manifest " << manifestPath << ": " << ec.message() << std::endl;
+    return result;
+  }
+  result.success_ = true;
+  result.snapshot_ = name;
+  std::cout << "Backup " << name << " complete: " << result.files_ << " file(s) totaling " << (result.bytes_ >> 20) << " MiB in " << result.chunks_ << " chunk(s), of which " << result.newChunks_ << " new (" << (result.newBytes_ >> 20) << " MiB compressed), in " << result.duration_.count() << " ms" << std::endl;
+  const nlohmann::json record
+  {
+    {"backupTime", History::ToIsoString(wallTime)},
+    {"snapshot", name},
+    {"reason", reason},
+    {"files", result.files_},
+    {"bytes", result.bytes_},
+    {"chunks", result.chunks_},
+    {"newChunks", result.newChunks_},
+    {"newBytes", result.newBytes_},
+    {"milliseconds", result.duration_.count()}
+  };
+  historyUptr_->Append(record.dump());
+  Prune();
+  return result;
+}
+
+bool Backup::Restore(const std::string& snapshot)
+{
+  std::scoped_lock runLock(runMutex_);
+  const auto startTime(std::chrono::steady_clock::now());
+  const auto snapshots(ListSnapshots(repository_ / "snapshots"));
+  std::filesystem::path manifestPath;
+  for (const auto& path : snapshots)
+  {
+    if (snapshot.empty() || path.stem() == snapshot) { manifestPath = path; }
+  }
+  if (manifestPath.empty())
+  {
+    std::cout << "WARNING: Backup snapshot " << (snapshot.empty() ? "(latest)" : snapshot) << " not found in " << repository_ << std::endl;
+    return false;
+  }
+  const auto name(manifestPath.stem().string());
+
+  // load manifest, and sort files by which backed up directory they're in
+  //  (files in directories that are no longer configured are skipped, since
+  //  restoring them would mean replacing directories that aren't backed up)
+  std::vector<File> files;
+  std::vector<std::size_t> fileSources;
+  std::vector<bool> restoreSource(sources_.size(), false);
+  try
+  {
+    std::ifstream file(manifestPath);
+    const auto manifest(nlohmann::json::parse(file));
+    if (manifest.at("version").get<int>() > MANIFEST_VERSION)
+    {
+      std::cout << "WARNING: Backup snapshot " << name << " has unsupported version " << manifest.at("version") << std::endl;
+      return false;
+    }
+    for (const auto& jFile : manifest.at("files"))
+    {
+      File restoreFile;
+      restoreFile.path_ = std::filesystem::path(
+        jFile.at("path").get<std::string>()).make_preferred();
+      restoreFile.size_ = jFile.at("size").get<std::uintmax_t>();
+      restoreFile.chunks_ =
+        jFile.at("chunks").get<std::vector<std::string>>();
+      const auto source(std::find_if(sources_.begin(), sources_.end(),
+        [&restoreFile](const std::filesystem::path& s)
+        {
+          return IsWithin(restoreFile.path_, s);
+        }));
+      if (restoreFile.path_.is_absolute() || source == sources_.end())
+      {
+        std::cout << "WARNING: Skipping restore of file " << restoreFile.path_ << " outside of backed up directories" << std::endl;
+        continue;
+      }
+      const auto sourceIndex(
+        static_cast<std::size_t>(source - sources_.begin()));
+      restoreSource[sourceIndex] = true;
+      fileSources.push_back(sourceIndex);
+      files.push_back(std::move(restoreFile));
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cout << "WARNING: Failed to read backup manifest " << manifestPath << ": " << e.what() << std::endl;
+    return false;
+  }
+  std::cout << "Restoring backup " << name << std::endl;
+
+  // each distinct chunk's decompressed size is recorded in its header, which
+  //  is read up front so that every chunk's offset in its file is known, and
+  //  chunks can then be written in any order
+  std::vector<std::string> hashes;
+  std::unordered_map<std::string, std::size_t> hashIndexes;
+  for (const auto& file : files)
+  {
+    for (const auto& hash : file.chunks_)
+    {
+      if (hashIndexes.emplace(hash, hashes.size()).second)
+      {
+        hashes.push_back(hash);
+      }
+    }
+  }
+  std::vector<std::uint64_t> chunkSizes(hashes.size(), 0);
+  std::mutex mutex;
+  std::atomic_size_t next(0);
+  std::atomic_bool failed(false);
+  RunWorkers(std::clamp<std::size_t>(hashes.size(), 1, threads_), [&]()
+  {
+    std::array<char, ZSTD_HEADER_MAX> header{};
+    for (std::size_t i; !failed && (i = next++) < hashes.size();)
+    {
+      std::ifstream file(GetChunkPath(hashes[i]), std::ios::binary);
+      file.read(header.data(), static_cast<std::streamsize>(header.size()));
+      const auto size(ZSTD_getFrameContentSize(
+        header.data(), static_cast<std::size_t>(file.gcount())));
+      if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR)
+      {
+        std::scoped_lock lock(mutex);
+        std::cout << "WARNING: Backup chunk " << GetChunkPath(hashes[i]) << " is missing or corrupt" << std::endl;
+        failed = true;
+        break;
+      }
+      chunkSizes[i] = size;
+    }
+  });
+  if (failed)
+  {
+    std::cout << "WARNING: Restore of backup " << name << " failed; nothing changed" << std::endl;
+    return false;
+  }
+
+  // create staging directories next to the ones they'll replace, so that
+  //  swapping them in is just a rename, and preallocate every file, so that
+  //  chunks can be written to them straight away
+  struct Job
+  {
+    std::size_t file_;
+    std::uint64_t offset_;
+    std::size_t hash_;
+  };
+  std::vector<Job> jobs;
+  std::vector<std::filesystem::path> stagedPaths;
+  std::error_code ec;
+  for (std::size_t s(0); s < sources_.size(); ++s)
+  {
+    if (!restoreSource[s]) { continue; }
+    const auto stagingPath(
+      AppendSuffix(installPath_ / sources_[s], RESTORE_SUFFIX));
+    std::filesystem::remove_all(stagingPath, ec);
+    std::filesystem::create_directories(stagingPath, ec);
+  }
+  std::uintmax_t bytes(0);
+  for (std::size_t f(0); !failed && f < files.size(); ++f)
+  {
+    const auto& source(sources_[fileSources[f]]);
+    stagedPaths.push_back(
+      AppendSuffix(installPath_ / source, RESTORE_SUFFIX) /
+      files[f].path_.lexically_relative(source));
+    std::uint64_t offset(0);
+    for (const auto& hash : files[f].chunks_)
+    {
+      const auto h(hashIndexes.at(hash));
+      jobs.push_back({f, offset, h});
+      offset += chunkSizes[h];
+    }
+    if (offset != files[f].size_)
+    {
+      std::cout << "WARNING: Backup chunks of file " << files[f].path_ << " add up to " << offset << " bytes instead of " << files[f].size_ << std::endl;
+      failed = true;
+      break;
+    }
+    std::filesystem::create_directories(stagedPaths[f].parent_path(), ec);
+    std::ofstream(stagedPaths[f], std::ios::binary | std::ios::trunc).close();
+    std::filesystem::resize_file(stagedPaths[f], offset, ec);
+    if (ec)
+    {
+      std::cout << "WARNING: Failed to create file " << stagedPaths[f] << " for restore: " << ec.message() << std::endl;
+      failed = true;
+      break;
+    }
+    bytes += offset;
+  }
+
+  // decompress, verify and write chunks in parallel; jobs are in file order,
+  //  so each worker mostly writes a run of nearby chunks to the same file
+  next = 0;
+  if (!failed)
+  {
+    RunWorkers(std::clamp<std::size_t>(jobs.size(), 1, threads_), [&]()
+    {
+      ZSTD_DCtx* const dctx(ZSTD_createDCtx());
+      std::vector<char> compressed;
+      std::vector<std::uint8_t> data;
+      std::fstream file;
+      std::size_t fileIndex(files.size());
+      for (std::size_t i; dctx && !failed && (i = next++) < jobs.size();)
+      {
+        const auto& job(jobs[i]);
+        const auto& hash(hashes[job.hash_]);
+        data.resize(static_cast<std::size_t>(chunkSizes[job.hash_]));
+        bool success(ReadFile(GetChunkPath(hash), compressed));
+        if (success)
+        {
+          const std::size_t size(ZSTD_decompressDCtx(
+            dctx, data.data(), data.size(),
+            compressed.data(), compressed.size()));
+          Sha256 sha;
+          sha.Update(data.data(), data.size());
+          success = size == data.size() && sha.Final() == hash;
+        }
+        if (!success)
+        {
+          std::scoped_lock lock(mutex);
+          std::cout << "WARNING: Backup chunk " << GetChunkPath(hash) << " is missing or corrupt" << std::endl;
+          failed = true;
+          break;
+        }
+        if (job.file_ != fileIndex)
+        {
+          file.close();
+          file.open(stagedPaths[job.file_],
+            std::ios::binary | std::ios::in | std::ios::out);
+          fileIndex = job.file_;
+        }
+        file.seekp(static_cast<std::streamoff>(job.offset_));
+        file.write(reinterpret_cast<const char*>(data.data()),
+          static_cast<std::streamsize>(data.size()));
+        file.flush();
+        if (file.fail())
+        {
+          std::scoped_lock lock(mutex);
+          std::cout << "WARNING: Failed to write file " << stagedPaths[job.file_] << " for restore" << std::endl;
+          failed = true;
+          break;
+        }
+      }
+      if (!dctx) { failed = true; }
+      ZSTD_freeDCtx(dctx);
+    });
+  }
+
+  // flush restored files and their directories to disk before swapping them
+  //  in, so that a power loss can't leave a half-written installation in
+  //  place of the original
+  if (!failed)
+  {
+    next = 0;
+    RunWorkers(std::clamp<std::size_t>(stagedPaths.size(), 1, threads_), [&]()
+    {
+      for (std::size_t i; !failed && (i = next++) < stagedPaths.size();)
+      {
+        if (SyncFile(stagedPaths[i])) { continue; }
+        std::scoped_lock lock(mutex);
+        std::cout << "WARNING: Failed to flush file " << stagedPaths[i] << " for restore" << std::endl;
+        failed = true;
+      }
+    });
+  }
+  if (!failed)
+  {
+    std::set<std::filesystem::path> stagedDirs;
+    for (const auto& path : stagedPaths)
+    {
+      auto dir(path.parent_path());
+      while (dir != installPath_ && dir.has_relative_path() &&
+        stagedDirs.insert(dir).second)
+      {
+        dir = dir.parent_path();
+      }
+    }
+    for (const auto& dir : stagedDirs)
+    {
+      if (SyncDirectory(dir)) { continue; }
+      std::cout << "WARNING: Failed to flush directory " << dir << " for restore" << std::endl;
+      failed = true;
+      break;
+    }
+  }
+
+  // swap restored directories in; if any swap fails, undo all of the earlier
+  //  ones too, so that a failed restore changes nothing
+  // each entry records a swapped source, and whether it had a live original
+  std::vector<std::pair<std::size_t, bool>> swapped;
+  for (std::size_t s(0); !failed && s < sources_.size(); ++s)
+  {
+    if (!restoreSource[s]) { continue; }
+    const auto livePath(installPath_ / sources_[s]);
+    const auto stagingPath(AppendSuffix(livePath, RESTORE_SUFFIX));
+    const auto previousPath(AppendSuffix(livePath, PRE_RESTORE_SUFFIX));
+    std::filesystem::remove_all(previousPath, ec);
+    const bool hadLive(std::filesystem::exists(livePath, ec));
+    if (hadLive) { std::filesystem::rename(livePath, previousPath, ec); }
+    if (!ec) { std::filesystem::rename(stagingPath, livePath, ec); }
+    if (ec)
+    {
+      std::cout << "WARNING: Failed to replace " << livePath << " with restored copy: " << ec.message() << std::endl;
+      if (hadLive && !std::filesystem::exists(livePath, ec))
+      {
+        std::filesystem::rename(previousPath, livePath, ec);
+      }
+      failed = true;
+      break;
+    }
+    swapped.emplace_back(s, hadLive);
+  }
+  for (auto it(swapped.rbegin()); failed && it != swapped.rend(); ++it)
+  {
+    // move the restored copy back to staging (to be cleaned up below), and
+    //  the original back into place
+    const auto livePath(installPath_ / sources_[it->first]);
+    std::filesystem::rename(
+      livePath, AppendSuffix(livePath, RESTORE_SUFFIX), ec);
+    if (!ec && it->second)
+    {
+      std::filesystem::rename(
+        AppendSuffix(livePath, PRE_RESTORE_SUFFIX), livePath, ec);
+    }
+    if (ec)
+    {
+      std::cout << "ERROR: Failed to put original " << livePath << " back after failed restore: " << ec.message() << std::endl;
+    }
+  }
+  for (const auto& [s, hadLive] : swapped)
+  {
+    const auto livePath(installPath_ / sources_[s]);
+    SyncDirectory(livePath.parent_path());
+    if (failed) { continue; }
+    restoreSource[s] = false;
+    if (!hadLive)
+    {
+      std::cout << "Restored " << livePath << std::endl;
+      continue;
+    }
+    std::cout << "Restored " << livePath << "; previous contents kept at " << AppendSuffix(livePath, PRE_RESTORE_SUFFIX) << std::endl;
+  }
+  for (std::size_t s(0); s < sources_.size(); ++s)
+  {
+    if (!restoreSource[s]) { continue; }
+    std::filesystem::remove_all(
+      AppendSuffix(installPath_ / sources_[s], RESTORE_SUFFIX), ec);
+  }
+  if (failed)
+  {
+    std::cout << "WARNING: Restore of backup " << name << " failed" << std::endl;
+    return false;
+  }
+  const auto duration(std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - startTime));
+  std::cout << "Restore of backup " << name << " complete: " << files.size() << " file(s) totaling " << (bytes >> 20) << " MiB in " << duration.count() << " ms" << std::endl;
+  return true;
+}
+
+std::vector<std::filesystem::path> Backup::ListFiles(
+  const std::filesystem::path& root) const
+{
+  std::vector<std::filesystem::path> files;
+  for (const auto& source : sources_)
+  {
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator
+      it(root / source, ec), end;
+      !ec && it != end; it.increment(ec))
+    {
+      if (std::error_code fec; it->is_regular_file(fec))
+      {
+        files.push_back(it->path().lexically_relative(root));
+      }
+    }
+    if (ec && ec != std::errc::no_such_file_or_directory)
+    {
+      std::cout << "WARNING: Failed to list files in " << root / source << " for backup: " << ec.message() << std::endl;
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+std::filesystem::path Backup::GetChunkPath(const std::string& hash) const
+{
+  // fan out by hash prefix, to keep directories reasonably small
+  return repository_ / "chunks" / hash.substr(0, 2) / (hash + ".zst");
+}
+
+void Backup::Prune() const
+{
+  auto snapshots(ListSnapshots(repository_ / "snapshots"));
+  if (!retain_ || snapshots.size() <= retain_) { return; }
+  std::error_code ec;
+  const auto excess(static_cast<std::ptrdiff_t>(snapshots.size() - retain_));
+  for (auto it(snapshots.begin()); it != snapshots.begin() + excess; ++it)
+  {
+    std::filesystem::remove(*it, ec);
+    std::cout << "Pruned backup " << it->stem() << std::endl;
+  }
+  snapshots.erase(snapshots.begin(), snapshots.begin() + excess);
+  // collect chunks still referenced; if any manifest can't be read, keep
+  //  everything rather than risk deleting chunks it needs
+  std::unordered_set<std::string> referenced;
+  for (const auto& snapshot : snapshots)
+  {
+    try
+    {
+      std::ifstream file(snapshot);
+      const auto manifest(nlohmann::json::parse(file));
+      for (const auto& jFile : manifest.at("files"))
+      {
+        for (const auto& chunk : jFile.at("chunks"))
+        {
+          referenced.insert(chunk.get<std::string>());
+        }
+      }
+    }
+    catch (const std::exception& e)
+    {
+      std::cout << "WARNING: Not deleting unreferenced backup chunks because manifest " << snapshot << " is unreadable: " << e.what() << std::endl;
+      return;
+    }
+  }
+  std::vector<std::filesystem::path> unreferenced;
+  for (std::filesystem::recursive_directory_iterator
+    it(repository_ / "chunks", ec), end;
+    !ec && it != end; it.increment(ec))
+  {
+    const auto& path(it->path());
+    // also clean up after interrupted backups
+    if (path.extension() == ".tmp" ||
+      (path.extension() == ".zst" &&
+        !referenced.count(path.stem().string())))
+    {
+      unreferenced.push_back(path);
+    }
+  }
+  std::uintmax_t bytes(0);
+  for (const auto& path : unreferenced)
+  {
+    const auto size(std::filesystem::file_size(path, ec));
+    if (std::filesystem::remove(path, ec)) { bytes += ec ? 0 : size; }
+  }
+  std::cout << "Deleted " << unreferenced.size() << " unreferenced backup chunk(s) totaling " << (bytes >> 20) << " MiB" << std::endl;
+}
+}
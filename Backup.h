@@ -0,0 +1,156 @@
+#ifndef BACKUP_H
+#define BACKUP_H
+
+#include "Config.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace rustLaunchSite
+{
+class CancellationToken;
+class History;
+
+/// @brief Deduplicating incremental backup facility
+/// @details Snapshots the server identity directory (saves, player and
+///  blueprint databases, etc.), plus any configured extra directories under
+///  the server installation (e.g. plugin data), into a local repository.
+///  Files are split into content-defined chunks, so that a change in one
+///  part of a file only affects the chunks around it; each chunk is stored
+///  once, zstd-compressed, under its SHA-256 hash, and a snapshot is just a
+///  manifest listing the chunks of each file. Unchanged data therefore costs
+///  nothing after the first snapshot. Chunks are hashed and compressed on a
+///  pool of worker threads. Chunks and manifests are flushed to disk before
+///  anything references them, and a stored chunk is read back and checked the
+///  first time a snapshot reuses it. Where the filesystem supports reflinks,
+///  files are first cloned into a staging directory in the repository, so
+///  that they are captured at the moment the backup starts, rather than while
+///  the server keeps writing to them. Snapshots beyond the retention limit
+///  are pruned, along with chunks no longer referenced by any snapshot.
+///  Restoring a snapshot decompresses and verifies chunks on the same worker
+///  pool into staging directories, which then replace the live ones. Only one
+///  backup or restore runs at a time, on the calling thread. Should not throw
+///  any exceptions.
+class Backup
+{
+public:
+
+  /// @brief Outcome of a backup
+  struct Result
+  {
+    /// @brief @c true if a snapshot was written
+    bool success_{false};
+    /// @brief Snapshot name, or empty on failure
+    std::string snapshot_;
+    /// @brief Number of files backed up
+    std::size_t files_{0};
+    /// @brief Total size of files backed up
+    std::uintmax_t bytes_{0};
+    /// @brief Number of chunks referenced by the snapshot
+    std::size_t chunks_{0};
+    /// @brief Number of chunks that weren't already in the repository
+    std::size_t newChunks_{0};
+    /// @brief Compressed size of new chunks
+    std::uintmax_t newBytes_{0};
+    /// @brief Time taken
+    std::chrono::milliseconds duration_{};
+  };
+
+  /// @brief Primary constructor
+  /// @param cfgSptr Shared pointer to application configuration instance
+  explicit Backup(const std::shared_ptr<const Config>& cfgSptr);
+
+  /// @brief Query whether periodic or scheduled backups are enabled
+  /// @return @c true if a backup interval or schedule is configured
+  bool IsEnabled() const
+    { return interval_.count() > 0 || !schedule_.empty(); }
+
+  /// @brief Get the configured backup interval
+  /// @return Backup interval, or zero if disabled
+  std::chrono::minutes GetInterval() const { return interval_; }
+
+  /// @brief Get the configured backup schedule
+  /// @return Cron expression, or empty if disabled
+  const std::string& GetSchedule() const { return schedule_; }
+
+  /// @brief Back up now, on the calling thread
+  /// @details The server should have just saved (or stopped), so that save
+  ///  files are consistent. A cancelled backup writes no snapshot; any chunks
+  ///  it stored are reused by the next one, or pruned.
+  /// @param reason Human-readable reason, recorded in the snapshot
+  /// @param cancel Token that abandons the backup early
+  /// @return Outcome of the backup
+  Result Run(const std::string& reason, const CancellationToken& cancel);
+
+  /// @brief Restore a snapshot, on the calling thread
+  /// @details Each backed up directory is rebuilt next to the original (with
+  ///  @c .rlsRestore appended to its name) by decompressing chunks in
+  ///  parallel, and writing them straight to their offsets in the files; each
+  ///  chunk is verified against its SHA-256 hash. Only once everything has
+  ///  been restored are the rebuilt directories swapped in via renames, and
+  ///  the originals kept next to them (with @c .rlsPreRestore appended to
+  ///  their names, replacing any previous ones), so that a failed restore
+  ///  changes nothing. Caller is responsible for ensuring the server is not
+  ///  running.
+  /// @param snapshot Name of snapshot to restore, or empty for the latest
+  /// @return @c true on success, or @c false if the snapshot wasn't found or
+  ///  couldn't be restored
+  bool Restore(const std::string& snapshot);
+
+private:
+
+  // file being backed up
+  struct File;
+
+  // disabled constructors/operators
+
+  Backup() = delete;
+  Backup(const Backup&) = delete;
+  Backup& operator= (const Backup&) = delete;
+
+  // collect files to back up from the install directory, or a clone of it,
+  //  with paths relative to that
+  std::vector<std::filesystem::path> ListFiles(
+    const std::filesystem::path& root) const;
+
+  // get repository path of a chunk
+  std::filesystem::path GetChunkPath(const std::string& hash) const;
+
+  // delete snapshots beyond the retention limit, and any chunks they alone
+  //  referenced
+  void Prune() const;
+
+  // server installation directory
+  std::filesystem::path installPath_;
+  // directories to back up, relative to the install directory
+  std::vector<std::filesystem::path> sources_;
+  // repository directory
+  std::filesystem::path repository_;
+  // time between periodic backups
+  std::chrono::minutes interval_;
+  // cron expression for scheduled backups
+  std::string schedule_;
+  // number of snapshots to retain, or zero for all
+  std::size_t retain_;
+  // zstd compression level
+  int compressionLevel_;
+  // number of worker threads
+  std::size_t threads_;
+  // backup history file
+  std::unique_ptr<History> historyUptr_;
+  // mutex serializing backups
+  std::mutex runMutex_;
+  // hashes of stored chunks that have been read back and found intact, or
+  //  written by this process; guarded by the running backup's worker mutex
+  std::unordered_set<std::string> verifiedChunks_;
+};
+}
+
+#endif // BACKUP_H
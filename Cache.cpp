@@ -0,0 +1,282 @@
+#include "Cache.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+
+#if _WIN32
+  #include <io.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+// cache file header: magic string, followed by format version byte
+constexpr std::string_view CACHE_MAGIC{"RLSKVS"};
+constexpr std::uint8_t CACHE_VERSION{1};
+
+// size of record header: checksum, key length, value length
+constexpr std::size_t RECORD_HEADER_SIZE{12};
+
+// number of superseded records to tolerate before compacting, on top of one
+//  per key
+constexpr std::size_t COMPACT_SLACK{256};
+
+// CRC-32 (IEEE 802.3) lookup table
+constexpr std::array<std::uint32_t, 256> CRC_TABLE([]()
+{
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i(0); i < table.size(); ++i)
+  {
+    std::uint32_t c(i);
+    for (int k(0); k < 8; ++k)
+    {
+      c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+    }
+    table[i] = c;
+  }
+  return table;
+}());
+
+std::uint32_t Crc32(const std::string_view data)
+{
+  std::uint32_t crc(0xFFFFFFFFU);
+  for (const char c : data)
+  {
+    crc = CRC_TABLE[(crc ^ static_cast<std::uint8_t>(c)) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFU;
+}
+
+// little-endian 32-bit integer I/O for record headers
+void PutU32(std::string& data, const std::uint32_t v)
+{
+  for (unsigned shift(0); shift < 32; shift += 8)
+  {
+    data.push_back(static_cast<char>((v >> shift) & 0xFF));
+  }
+}
+
+std::uint32_t GetU32(const std::string_view data, const std::size_t pos)
+{
+  std::uint32_t v(0);
+  for (unsigned shift(0); shift < 32; shift += 8)
+  {
+    v |= static_cast<std::uint32_t>(
+      static_cast<std::uint8_t>(data[pos + shift / 8])) << shift;
+  }
+  return v;
+}
+
+// encode a record as checksum, key length, value length, key, value
+// the checksum covers everything after it
+std::string EncodeRecord(const std::string& key, const std::string& value)
+{
+  std::string body;
+  PutU32(body, static_cast<std::uint32_t>(key.size()));
+  PutU32(body, static_cast<std::uint32_t>(value.size()));
+  body += key;
+  body += value;
+  std::string record;
+  PutU32(record, Crc32(body));
+  return record + body;
+}
+
+std::string EncodeHeader()
+{
+  std::string header(CACHE_MAGIC);
+  header.push_back(static_cast<char>(CACHE_VERSION));
+  return header;
+}
+
+// write data to a file, and flush it all the way to disk
+bool WriteDurably(std::FILE* file, const std::string& data)
+{
+  if (std::fwrite(data.data(), 1, data.size(), file) != data.size() ||
+    std::fflush(file))
+  {
+    return false;
+  }
+#if _WIN32
+  return !_commit(_fileno(file));
+#else
+  return !fsync(fileno(file));
+#endif
+}
+
+// flush a directory's entries to disk, so that a rename within it survives
+//  power loss
+// Windows doesn't support this, and NTFS journals renames anyway
+bool SyncDirectory(const std::filesystem::path& path)
+{
+#if _WIN32
+  static_cast<void>(path);
+  return true;
+#else
+  const int fd(open(path.empty() ? "." : path.c_str(), O_RDONLY));
+  if (fd < 0) { return false; }
+  const bool success(!fsync(fd));
+  close(fd);
+  return success;
+#endif
+}
+}
+
+namespace rustLaunchSite
+{
+Cache::Cache(std::filesystem::path path)
+  : path_(std::move(path))
+{
+  path_.make_preferred();
+  std::scoped_lock lock(mutex_);
+  Load();
+}
+
+std::string Cache::Get(const std::string& key) const
+{
+  std::scoped_lock lock(mutex_);
+  const auto it(entries_.find(key));
+  return it == entries_.end() ? std::string() : it->second;
+}
+
+bool Cache::Set(const std::string& key, const std::string& value)
+{
+  std::scoped_lock lock(mutex_);
+  if (const auto it(entries_.find(key));
+    it != entries_.end() && it->second == value)
+  {
+    return true;
+  }
+  entries_[key] = value;
+  // the log only ever grows, so rewrite it with just the current entries once
+  //  it holds a lot more than that
+  if (records_ >= 2 * entries_.size() + COMPACT_SLACK) { return Compact(); }
+  return Append(key, value);
+}
+
+void Cache::Load()
+{
+  // slurp the whole file, as it's small
+  std::ifstream file(path_, std::ios::binary);
+  if (!file.is_open()) { return; }
+  const std::string data(
+    (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const std::string_view view(data);
+  if (view.substr(0, CACHE_MAGIC.size()) != CACHE_MAGIC ||
+    view.size() <= CACHE_MAGIC.size() ||
+    static_cast<std::uint8_t>(view[CACHE_MAGIC.size()]) != CACHE_VERSION)
+  {
+    if (!data.empty())
+    {
+      std::cout << "WARNING: Ignoring cache file " << path_ << " due to unrecognized format; it will be overwritten" << std::endl;
+    }
+    // force a rewrite on first change
+    records_ = SIZE_MAX;
+    return;
+  }
+  std::size_t pos(CACHE_MAGIC.size() + 1);
+  while (view.size() - pos >= RECORD_HEADER_SIZE)
+  {
+    const std::uint32_t crc(GetU32(view, pos));
+    const std::size_t keySize(GetU32(view, pos + 4));
+    const std::size_t valueSize(GetU32(view, pos + 8));
+    const std::size_t bodySize(8 + keySize + valueSize);
+    if (view.size() - pos - 4 < bodySize ||
+      Crc32(view.substr(pos + 4, bodySize)) != crc)
+    {
+      break;
+    }
+    const auto keyPos(pos + RECORD_HEADER_SIZE);
+    entries_[data.substr(keyPos, keySize)] =
+      data.substr(keyPos + keySize, valueSize);
+    pos += 4 + bodySize;
+    ++records_;
+  }
+  // a torn record (e.g. due to power loss) ends the log; drop it and anything
+  //  after it, so that new records aren't appended behind garbage
+  if (pos != view.size())
+  {
+    std::cout << "WARNING: Discarding " << view.size() - pos << " unreadable trailing byte(s) from cache file " << path_ << std::endl;
+    records_ = SIZE_MAX;
+  }
+}
+
+bool Cache::Append(const std::string& key, const std::string& value)
+{
+  std::error_code ec;
+  if (path_.has_parent_path())
+  {
+    std::filesystem::create_directories(path_.parent_path(), ec);
+  }
+  std::FILE* file(std::fopen(path_.string().c_str(), "ab"));
+  if (!file)
+  {
+    std::cout << "WARNING: Failed to open cache file " << path_ << std::endl;
+    return false;
+  }
+  // write the header too if the file is new
+  std::fseek(file, 0, SEEK_END);
+  const std::string data(
+    (std::ftell(file) > 0 ? std::string() : EncodeHeader()) +
+    EncodeRecord(key, value));
+  const bool success(WriteDurably(file, data));
+  std::fclose(file);
+  if (!success)
+  {
+    std::cout << "WARNING: Failed to append to cache file " << path_ << std::endl;
+    // a partial append would be discarded on load, so start over
+    records_ = SIZE_MAX;
+    return false;
+  }
+  ++records_;
+  return true;
+}
+
+bool Cache::Compact()
+{
+  std::error_code ec;
+  if (path_.has_parent_path())
+  {
+    std::filesystem::create_directories(path_.parent_path(), ec);
+  }
+  auto tempPath(path_);
+  tempPath += ".tmp";
+  std::string data(EncodeHeader());
+  for (const auto& [key, value] : entries_)
+  {
+    data += EncodeRecord(key, value);
+  }
+  std::FILE* file(std::fopen(tempPath.string().c_str(), "wb"));
+  if (!file)
+  {
+    std::cout << "WARNING: Failed to open cache file " << tempPath << std::endl;
+    return false;
+  }
+  const bool success(WriteDurably(file, data));
+  std::fclose(file);
+  if (!success)
+  {
+    std::cout << "WARNING: Failed to write cache file " << tempPath << std::endl;
+    return false;
+  }
+  std::filesystem::rename(tempPath, path_, ec);
+  if (ec)
+  {
+    std::cout << "WARNING: Failed to replace cache file " << path_ << ": " << ec.message() << std::endl;
+    return false;
+  }
+  if (!SyncDirectory(path_.parent_path()))
+  {
+    std::cout << "WARNING: Failed to flush cache directory " << path_.parent_path() << std::endl;
+  }
+  records_ = entries_.size();
+  return true;
+}
+}
@@ -0,0 +1,81 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace rustLaunchSite
+{
+/// @brief Persistent key-value store for state that must survive restarts of
+///  rustLaunchSite
+/// @details Backs the configured cache file (e.g. last seen server protocol
+///  version, map seed rotation state, last installed server build). The whole
+///  store is held in memory, and the file is an append-only log of
+///  checksummed records, so that a change costs a single small append; it is
+///  loaded with one sequential read, in which later records override earlier
+///  ones. Each append is flushed to disk before returning, and a record that
+///  was torn by a crash or power loss fails its checksum and is discarded
+///  along with anything after it. Once the log holds many more records than
+///  keys, it is compacted by writing the current entries to a temporary file
+///  that then replaces the original. A missing or unreadable cache file is
+///  treated as empty. All methods are thread-safe. Should not throw any
+///  exceptions.
+class Cache
+{
+public:
+
+  /// @brief Primary constructor
+  /// @details Loads the cache file, if it exists.
+  /// @param path Path to cache file
+  explicit Cache(std::filesystem::path path);
+
+  /// @brief Get the value stored under a key
+  /// @param key Key to look up
+  /// @return Stored value, or empty if not found
+  std::string Get(const std::string& key) const;
+
+  /// @brief Store a value under a key, and save it to the cache file
+  /// @details Storing the value a key already has doesn't touch the file, so
+  ///  this is cheap to call repeatedly.
+  /// @param key Key to store value under
+  /// @param value Value to store
+  /// @return @c true on success, @c false if the cache file couldn't be
+  ///  written (value is still stored in memory)
+  bool Set(const std::string& key, const std::string& value);
+
+private:
+
+  // disabled constructors/operators
+
+  Cache() = delete;
+  Cache(const Cache&) = delete;
+  Cache& operator= (const Cache&) = delete;
+
+  // read records from the cache file
+  // caller must hold mutex
+  void Load();
+
+  // append a record to the cache file
+  // caller must hold mutex
+  bool Append(const std::string& key, const std::string& value);
+
+  // rewrite the cache file with just the current entries
+  // caller must hold mutex
+  bool Compact();
+
+  // path to cache file
+  std::filesystem::path path_;
+  // mutex protecting everything below
+  mutable std::mutex mutex_;
+  // stored entries
+  std::map<std::string, std::string> entries_;
+  // number of records in cache file, or SIZE_MAX if it needs to be rewritten
+  //  before anything can be appended (e.g. unrecognized format)
+  std::size_t records_{0};
+};
+}
+
+#endif // CACHE_H
@@ -0,0 +1,46 @@
+#include "CancellationToken.h"
+
+namespace rustLaunchSite
+{
+CancellationToken::Registration::~Registration()
+{
+  if (!id_) { return; }
+  std::scoped_lock lock(token_.mutex_);
+  token_.callbacks_.erase(id_);
+}
+
+void CancellationToken::Cancel()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    if (cancelled_) { return; }
+    cancelled_ = true;
+    // run callbacks under the lock, so that nothing they reference can be
+    //  unregistered (and destroyed) while they run
+    for (const auto& [id, callback] : callbacks_) { callback(); }
+    callbacks_.clear();
+  }
+  cv_.notify_all();
+}
+
+bool CancellationToken::WaitFor(
+  const std::chrono::steady_clock::duration duration) const
+{
+  std::unique_lock lock(mutex_);
+  return cv_.wait_for(lock, duration, [this]() { return cancelled_.load(); });
+}
+
+CancellationToken::Registration CancellationToken::OnCancel(
+  std::function<void()> callback) const
+{
+  std::scoped_lock lock(mutex_);
+  if (cancelled_)
+  {
+    callback();
+    return {*this, 0};
+  }
+  const auto id(++lastId_);
+  callbacks_.emplace(id, std::move(callback));
+  return {*this, id};
+}
+}
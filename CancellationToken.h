@@ -0,0 +1,97 @@
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace rustLaunchSite
+{
+/// @brief Cooperative cancellation facility
+/// @details Lets one thread ask a long-running operation on another thread
+///  to give up early. The operation either polls @c IsCancelled() between
+///  steps, sleeps via @c WaitFor() instead of @c std::this_thread::sleep_for(),
+///  or registers a callback that interrupts whatever it's blocked on (e.g.
+///  kills a child process it's waiting for). Cancellation is permanent. All
+///  methods are thread-safe. Should not throw any exceptions.
+class CancellationToken
+{
+public:
+
+  /// @brief Registration of a cancellation callback
+  /// @details The callback is unregistered when this is destroyed, which
+  ///  blocks until the callback has returned if it is running.
+  class Registration
+  {
+  public:
+
+    ~Registration();
+
+  private:
+
+    friend class CancellationToken;
+
+    Registration(const CancellationToken& token, std::uint64_t id)
+      : token_(token), id_(id) {}
+
+    // disabled constructors/operators
+
+    Registration() = delete;
+    Registration(const Registration&) = delete;
+    Registration& operator= (const Registration&) = delete;
+
+    // token the callback is registered with
+    const CancellationToken& token_;
+    // callback identifier, or zero if not registered
+    std::uint64_t id_;
+  };
+
+  CancellationToken() = default;
+
+  /// @brief Cancel the operation
+  /// @details Runs any registered callbacks on the calling thread, and wakes
+  ///  any threads blocked in @c WaitFor(). Does nothing if already cancelled.
+  void Cancel();
+
+  /// @brief Query whether the operation has been cancelled
+  /// @return @c true if cancelled
+  bool IsCancelled() const { return cancelled_; }
+
+  /// @brief Sleep for the given amount of time, or until cancelled
+  /// @param duration Maximum time to sleep
+  /// @return @c true if cancelled, or @c false if the time elapsed
+  bool WaitFor(std::chrono::steady_clock::duration duration) const;
+
+  /// @brief Register a callback to be run on cancellation
+  /// @details The callback is run right away if already cancelled. It must
+  ///  not call back into this token.
+  /// @param callback Function to run
+  /// @return Registration that keeps the callback registered while it lives
+  [[nodiscard]] Registration OnCancel(std::function<void()> callback) const;
+
+private:
+
+  // disabled constructors/operators
+
+  CancellationToken(const CancellationToken&) = delete;
+  CancellationToken& operator= (const CancellationToken&) = delete;
+
+  // mutex protecting everything below, and serializing callbacks with their
+  //  unregistration
+  mutable std::mutex mutex_;
+  // condition variable used to wake threads sleeping in WaitFor()
+  mutable std::condition_variable cv_;
+  // whether cancellation has been requested
+  std::atomic_bool cancelled_{false};
+  // last callback identifier issued
+  mutable std::uint64_t lastId_{0};
+  // registered callbacks
+  mutable std::map<std::uint64_t, std::function<void()>> callbacks_;
+};
+}
+
+#endif // CANCELLATION_TOKEN_H
@@ -0,0 +1,256 @@
+#include "Cgroup.h"
+
+#include <iostream>
+#if __linux__
+  #include <fcntl.h>
+  #include <fstream>
+  #include <sstream>
+  #include <system_error>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+#if __linux__
+// mount point of the unified cgroup v2 hierarchy
+const std::filesystem::path CGROUP_ROOT{"/sys/fs/cgroup"};
+
+// write a value to a cgroup interface file, logging a warning on failure
+// returns false on failure
+bool WriteInterface(const std::filesystem::path& path, const std::string& value)
+{
+  // the value is only written to the kernel when the stream is flushed, so
+  //  that's where errors (e.g. invalid value, permission denied) show up
+  std::ofstream file(path);
+  if (file.is_open()) { file << value << std::flush; }
+  if (!file.is_open() || file.fail())
+  {
+    std::cout << "WARNING: Failed to write `" << value << "` to cgroup interface file " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// read the value of a `key value` line from a cgroup interface file
+// returns false if the file or key could not be read
+bool ReadInterfaceValue(
+  const std::filesystem::path& path, const std::string& key,
+  std::uint64_t& value)
+{
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.size() <= key.size() || line[key.size()] != ' ' ||
+      line.compare(0, key.size(), key) != 0)
+    {
+      continue;
+    }
+    std::istringstream(line.substr(key.size() + 1)) >> value;
+    return true;
+  }
+  return false;
+}
+
+// get the cgroup v2 path of a process (e.g. `/system.slice/foo.service`), or
+//  empty on failure
+// `pid` may be `self`
+std::string GetProcessCgroup(const std::string& pid)
+{
+  std::ifstream file(std::filesystem::path("/proc") / pid / "cgroup");
+  // the unified hierarchy is always listed as `0::<path>`
+  for (std::string line; std::getline(file, line);)
+  {
+    if (line.compare(0, 3, "0::") == 0) { return line.substr(3); }
+  }
+  return {};
+}
+#endif
+}
+
+namespace rustLaunchSite
+{
+Cgroup::Cgroup(
+  const Config::CgroupSettings& settings, const std::string_view defaultName)
+{
+  if (!settings.enabled_) { return; }
+#if __linux__
+  if (!Setup(settings, settings.name_.empty() ? defaultName : settings.name_))
+  {
+    std::cout << "WARNING: Failed to set up cgroup; server will be launched without resource isolation" << std::endl;
+    path_.clear();
+    procsPath_.clear();
+  }
+#else
+  std::cout << "WARNING: cgroup resource isolation is only supported on Linux; ignoring cgroup settings" << std::endl;
+#endif
+}
+
+Cgroup::~Cgroup()
+{
+#if __linux__
+  // this only succeeds once nothing is running in it, and there's not much
+  //  to be done otherwise, so ignore failure
+  if (!path_.empty()) { ::rmdir(path_.c_str()); }
+#endif
+}
+
+bool Cgroup::Setup(
+  [[maybe_unused]] const Config::CgroupSettings& settings,
+  [[maybe_unused]] const std::string_view name)
+{
+#if __linux__
+  if (!std::filesystem::exists(CGROUP_ROOT / "cgroup.controllers"))
+  {
+    std::cout << "WARNING: cgroup v2 hierarchy not found at " << CGROUP_ROOT << std::endl;
+    return false;
+  }
+  std::error_code ec;
+  std::filesystem::path parent;
+  if (settings.parent_.empty())
+  {
+    const auto own(GetProcessCgroup("self"));
+    if (own.empty())
+    {
+      std::cout << "WARNING: Failed to determine rustLaunchSite's own cgroup" << std::endl;
+      return false;
+    }
+    // rustLaunchSite's own cgroup can't pass controllers on to children
+    //  while it has processes in it, and rustLaunchSite isn't moved out of
+    //  it unasked, so use the one above it, provided that it's been delegated
+    //  to this user as well (e.g. via systemd's `DelegateSubgroup=`)
+    parent = (CGROUP_ROOT / std::filesystem::path(own).relative_path())
+      .parent_path();
+    if (own == "/" ||
+      ::access((parent / "cgroup.subtree_control").c_str(), W_OK) ||
+      ::access((parent / "cgroup.procs").c_str(), W_OK))
+    {
+      std::cout << "WARNING: No parent cgroup configured, and " << parent << " (above rustLaunchSite's own cgroup) is not delegated to this user; set `process.cgroup.parent` to a delegated cgroup" << std::endl;
+      return false;
+    }
+  }
+  else
+  {
+    parent = settings.parent_.is_absolute() ?
+      settings.parent_ : CGROUP_ROOT / settings.parent_;
+    std::filesystem::create_directories(parent, ec);
+    if (ec)
+    {
+      std::cout << "WARNING: Failed to create cgroup " << parent << ": " << ec.message() << std::endl;
+      return false;
+    }
+  }
+  // enable controllers individually, so that one being unavailable doesn't
+  //  prevent the others from working; cpu and memory are always wanted, as
+  //  their statistics are read back for telemetry
+  WriteInterface(parent / "cgroup.subtree_control", "+cpu");
+  WriteInterface(parent / "cgroup.subtree_control", "+memory");
+  if (settings.ioWeight_)
+  {
+    WriteInterface(parent / "cgroup.subtree_control", "+io");
+  }
+  path_ = parent / std::string(name);
+  std::filesystem::create_directory(path_, ec);
+  if (ec)
+  {
+    std::cout << "WARNING: Failed to create cgroup " << path_ << ": " << ec.message() << std::endl;
+    return false;
+  }
+  // limits that fail to apply are logged, but don't prevent isolation
+  if (settings.cpuWeight_)
+  {
+    WriteInterface(path_ / "cpu.weight", std::to_string(settings.cpuWeight_));
+  }
+  if (settings.cpuMaxPercent_)
+  {
+    // quota per 100ms period
+    WriteInterface(
+      path_ / "cpu.max",
+      std::to_string(settings.cpuMaxPercent_ * 1000) + " 100000");
+  }
+  if (settings.memoryHighMb_)
+  {
+    WriteInterface(
+      path_ / "memory.high",
+      std::to_string(static_cast<std::uint64_t>(settings.memoryHighMb_) << 20));
+  }
+  if (settings.memoryMaxMb_)
+  {
+    WriteInterface(
+      path_ / "memory.max",
+      std::to_string(static_cast<std::uint64_t>(settings.memoryMaxMb_) << 20));
+  }
+  if (settings.ioWeight_)
+  {
+    WriteInterface(
+      path_ / "io.weight", "default " + std::to_string(settings.ioWeight_));
+  }
+  procsPath_ = (path_ / "cgroup.procs").string();
+  std::cout << "Server will be launched in cgroup " << path_ << std::endl;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void Cgroup::JoinSelf() const noexcept
+{
+#if __linux__
+  if (procsPath_.empty()) { return; }
+  // errors are ignored here, as there's no safe way to report them from a
+  //  forked child; Verify() reports them from the parent instead
+  // writing zero moves the writing process
+  if (const int fd(::open(procsPath_.c_str(), O_WRONLY | O_CLOEXEC)); fd >= 0)
+  {
+    [[maybe_unused]] const auto result(::write(fd, "0", 1));
+    ::close(fd);
+  }
+#endif
+}
+
+void Cgroup::Verify(
+  [[maybe_unused]] const int pid,
+  [[maybe_unused]] const std::string_view processName) const
+{
+#if __linux__
+  if (!IsActive()) { return; }
+  const auto expected(
+    "/" + path_.lexically_relative(CGROUP_ROOT).generic_string());
+  if (const auto actual(GetProcessCgroup(std::to_string(pid)));
+    !actual.empty() && actual != expected)
+  {
+    std::cout << "WARNING: Failed to place " << processName << " (pid=" << pid << ") in cgroup " << expected << "; actual cgroup is " << actual << " - missing delegation?" << std::endl;
+  }
+#endif
+}
+
+Cgroup::Stats Cgroup::GetStats() const
+{
+  Stats stats;
+#if __linux__
+  if (!IsActive()) { return stats; }
+  stats.valid_ = true;
+  ReadInterfaceValue(path_ / "cpu.stat", "usage_usec", stats.cpuUsageUsec_);
+  ReadInterfaceValue(
+    path_ / "cpu.stat", "nr_throttled", stats.cpuThrottledPeriods_);
+  ReadInterfaceValue(
+    path_ / "cpu.stat", "throttled_usec", stats.cpuThrottledUsec_);
+  std::ifstream(path_ / "memory.current") >> stats.memoryCurrentBytes_;
+  ReadInterfaceValue(path_ / "memory.events", "high", stats.memoryHighEvents_);
+  ReadInterfaceValue(path_ / "memory.events", "max", stats.memoryMaxEvents_);
+  ReadInterfaceValue(path_ / "memory.events", "oom_kill", stats.oomKills_);
+  // memory.pressure: `some avg10=0.00 avg60=0.00 avg300=0.00 total=123`
+  std::ifstream pressure(path_ / "memory.pressure");
+  for (std::string line; std::getline(pressure, line);)
+  {
+    if (line.compare(0, 5, "some ") != 0) { continue; }
+    if (const auto total(line.find("total=")); total != std::string::npos)
+    {
+      std::istringstream(line.substr(total + 6)) >> stats.memoryStallUsec_;
+    }
+    break;
+  }
+#endif
+  return stats;
+}
+}
@@ -0,0 +1,125 @@
+#ifndef CGROUP_H
+#define CGROUP_H
+
+#include "Config.h"
+
+#if _MSC_VER
+  // make Boost happy when building with MSVC
+  #include <SDKDDKVer.h>
+#endif
+
+#include <boost/process/extend.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace rustLaunchSite
+{
+/// @brief @c boost::process launch extension that places a child process in
+///  a dedicated Linux cgroup v2 with configurable resource limits
+/// @details The cgroup is created and configured on construction, and the
+///  child joins it between @c fork() and @c exec(), so that it never runs
+///  outside of it. Only the child is moved; if no parent cgroup is
+///  configured, the one above rustLaunchSite's own cgroup is used, as cgroup
+///  v2 doesn't allow a cgroup with processes in it to delegate resource
+///  controllers to its children. Setup failures (e.g. cgroup v2 not mounted,
+///  or the parent cgroup not delegated to the user rustLaunchSite is running
+///  as) are logged, and the child is then launched without isolation. Does
+///  nothing on other platforms, or if disabled. This is an internal header
+///  that should only be included from translation units that launch
+///  processes.
+class Cgroup : public boost::process::extend::handler
+{
+public:
+
+  /// @brief Resource usage counters read back from the cgroup
+  /// @details All values are cumulative since the cgroup was created, except
+  ///  for @c memoryCurrentBytes_.
+  struct Stats
+  {
+    /// @brief @c true if data valid, @c false if cgroup isn't active
+    bool valid_{false};
+    /// @brief Total CPU time consumed, in microseconds
+    std::uint64_t cpuUsageUsec_{0};
+    /// @brief Number of periods in which CPU usage was throttled by
+    ///  @c cpu.max
+    std::uint64_t cpuThrottledPeriods_{0};
+    /// @brief Total time CPU usage was throttled by @c cpu.max, in
+    ///  microseconds
+    std::uint64_t cpuThrottledUsec_{0};
+    /// @brief Current memory usage in bytes
+    std::uint64_t memoryCurrentBytes_{0};
+    /// @brief Number of times memory usage exceeded @c memory.high and was
+    ///  throttled/reclaimed
+    std::uint64_t memoryHighEvents_{0};
+    /// @brief Number of times memory usage hit @c memory.max
+    std::uint64_t memoryMaxEvents_{0};
+    /// @brief Number of processes killed by the OOM killer
+    std::uint64_t oomKills_{0};
+    /// @brief Total time some task was stalled waiting on memory, in
+    ///  microseconds (pressure stall information)
+    std::uint64_t memoryStallUsec_{0};
+  };
+
+  /// @brief Primary constructor
+  /// @details Creates and configures the cgroup if enabled.
+  /// @param settings Cgroup settings
+  /// @param defaultName Cgroup name to use if not configured
+  Cgroup(const Config::CgroupSettings& settings, std::string_view defaultName);
+
+  /// @brief Destructor
+  /// @details Removes the cgroup, which only succeeds if the child process
+  ///  has exited.
+  ~Cgroup();
+
+#if !_WIN32
+  template<typename Sequence>
+  void on_exec_setup(
+    [[maybe_unused]] boost::process::extend::posix_executor<Sequence>& ex
+  ) const
+  {
+    JoinSelf();
+  }
+#endif
+
+  /// @brief Query whether the cgroup was set up successfully
+  /// @return @c true if launched processes will be placed in the cgroup
+  bool IsActive() const { return !procsPath_.empty(); }
+
+  /// @brief Check whether a launched process ended up in the cgroup,
+  ///  logging a warning if not
+  /// @param pid Process ID of launched process
+  /// @param processName Human-readable process name for log messages
+  void Verify(int pid, std::string_view processName) const;
+
+  /// @brief Read resource usage counters from the cgroup
+  /// @return Counters; validity flag is unset if cgroup isn't active
+  Stats GetStats() const;
+
+private:
+
+  // disabled constructors/operators
+
+  Cgroup() = delete;
+  Cgroup(const Cgroup&) = delete;
+  Cgroup& operator= (const Cgroup&) = delete;
+
+  // create and configure cgroup
+  // returns false on failure
+  bool Setup(const Config::CgroupSettings& settings, std::string_view name);
+
+  // move the calling process into the cgroup
+  // this runs in a forked child, so it must stick to async-signal-safe calls
+  //  and must not allocate memory
+  void JoinSelf() const noexcept;
+
+  // path to cgroup directory, or empty if not active
+  std::filesystem::path path_;
+  // path to cgroup's `cgroup.procs` file as a string, so that the forked
+  //  child can use it without allocating; empty if not active
+  std::string procsPath_;
+};
+}
+
+#endif // CGROUP_H
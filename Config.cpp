@@ -1,377 +1,870 @@
-#include "Config.h"
-
-#include <iostream>
-#include <fstream>
-#include <nlohmann/json.hpp>
-#include <stdexcept>
-#include <sstream>
-#include <string_view>
-
-namespace
-{
-// return value for the given key under the given JSON object if it exists, or a
-//  default value otherwise
-// NOTE: assumes that T has a copy constructor, plus a default constructor if no
-//  default value is provided
-template<typename T>
-T GetOptionalValue(
-  const nlohmann::json& j, std::string_view key, const T& defaultValue = {})
-{
-  if (j.contains(key)) { return j.at(key).template get<T>(); }
-  return defaultValue;
-}
-
-// assign to the given object the value for the given key under the given JSON
-//  object if the key exists, or assign the default value otherwise
-// NOTE: assumes that T has an assignment operator, plus a default constructor
-//  if no default value is provided
-template<typename T>
-void GetOptionalValueTo(
-  T& dest
-, const nlohmann::json& j
-, std::string_view key
-, const T& defaultValue = {})
-{
-  if (j.contains(key))
-  {
-    j.at(key).get_to(dest);
-  }
-  else
-  {
-    dest = defaultValue;
-  }
-}
-
-// populate given parameter map with config settings under given JSON tree
-// NOTES:
-// - this is called recursively to walk the tree
-// - tree structure is flattened by concatenating successive levels' key names
-//    to `path`, using `.` as a separator
-// - it is expected that the JSON node that represents the initial `path`
-//    starting point will be passed in, and `path` will be used as its name in
-//    place of its actual key in order to support a custom parameter prefix
-void GetParametersTo(
-  rustLaunchSite::Config::ParameterMapType& pMap
-, const nlohmann::json& j
-, const std::string& path
-)
-{
-  // std::cout << "GetParametersTo(): Called with path=" << path << std::endl;
-
-  // iterate over all items under j
-  for (const auto& [key, value] : j.items())
-  {
-    // add item's name to current level starting path to get its full path
-    const std::string& itemPath{path + key};
-    // store data values in map, or recruse into objects
-    switch (value.type())
-    {
-      case nlohmann::json::value_t::boolean:
-      {
-        pMap.try_emplace(itemPath, value.template get<bool>());
-        // std::cout << "GetParametersTo(): Emplaced bool " << itemPath << " = " << pMap.at(itemPath).ToString() << std::endl;
-      }
-      break;
-      case nlohmann::json::value_t::number_float:
-      {
-        pMap.try_emplace(itemPath, value.template get<double>());
-        // std::cout << "GetParametersTo(): Emplaced double " << itemPath << " = " << pMap.at(itemPath).ToString() << std::endl;
-      }
-      break;
-      case nlohmann::json::value_t::number_integer:
-      case nlohmann::json::value_t::number_unsigned:
-      {
-        pMap.try_emplace(itemPath, value.template get<int>());
-        // std::cout << "GetParametersTo(): Emplaced int " << itemPath << " = " << pMap.at(itemPath).ToString() << std::endl;
-      }
-      break;
-      case nlohmann::json::value_t::object:
-      {
-        // std::cout << "GetParametersTo(): Recursing into " << itemPath << std::endl;
-        GetParametersTo(pMap, value, itemPath + ".");
-      }
-      break;
-      case nlohmann::json::value_t::string:
-      {
-        pMap.try_emplace(itemPath, value.template get<std::string>());
-        // std::cout << "GetParametersTo(): Emplaced string " << itemPath << " = " << pMap.at(itemPath).ToString() << std::endl;
-      }
-      break;
-      default:
-      {
-        std::cout << "WARNING: Ignoring JSON itemPath='" << itemPath << "' with unsupported type" << std::endl;
-      }
-    }
-  }
-}
-}
-namespace rustLaunchSite
-{
-Config::Config(std::filesystem::path configFile)
-{
-  configFile.make_preferred();
-  // attempt to parse configFile via nlohmann/json
-  nlohmann::json j{};
-  try
-  {
-    j = nlohmann::json::parse(std::ifstream{configFile}, nullptr, true, true);
-  }
-  catch (const nlohmann::json::parse_error& e)
-  {
-    std::stringstream s;
-    s << e.byte;
-    throw std::invalid_argument(
-      std::string("JSON parsing exception at byte ") + s.str()
-      + " of config file '" + configFile.string() + "': " + e.what()
-    );
-  }
-  catch (const nlohmann::json::exception& e)
-  {
-    throw std::invalid_argument(
-      std::string("JSON general exception while parsing config file '")
-      + configFile.string() + "': " + e.what()
-    );
-  }
-  catch (const std::exception& e)
-  {
-    throw std::invalid_argument(
-      std::string("C++ general exception while parsing config file '")
-      + configFile.string() + "': " + e.what()
-    );
-  }
-  catch (...)
-  {
-    throw std::invalid_argument(
-      std::string("Unknown exception while parsing config file '")
-      + configFile.string() + "'"
-    );
-  }
-  // at this point the parse has succeeded
-  // grab and validate settings
-
-  try
-  {
-    // *** rustLaunchSite settings ***
-    const auto& jRls{j.at("rustLaunchSite")};
-
-    // just look up required settings
-    // if they don't exist, an exception will be thrown
-
-    // install
-    const auto& jRlsInstall{jRls.at("install")};
-    jRlsInstall.at("path").get_to(installPath_);
-    installPath_.make_preferred();
-    jRlsInstall.at("identity").get_to(installIdentity_);
-
-    // paths
-    const auto& jRlsPaths{jRls.at("paths")};
-    jRlsPaths.at("cache").get_to(pathsCache_);
-    pathsCache_.make_preferred();
-    jRlsPaths.at("download").get_to(pathsDownload_);
-    pathsDownload_.make_preferred();
-
-    // process
-    if (jRls.contains("process"))
-    {
-      const auto& jRlsProcess{jRls.at("process")};
-      GetOptionalValueTo(processAutoRestart_, jRlsProcess, "autoRestart");
-      // default optional integer to zero
-      GetOptionalValueTo(
-        processShutdownDelaySeconds_, jRlsProcess, "shutdownDelaySeconds");
-      // collapse other possible "disable" values to zero
-      if (processShutdownDelaySeconds_ < 0)
-      {
-        processShutdownDelaySeconds_ = 0;
-      }
-    }
-
-    // rcon
-    const auto& jRlsRcon{jRls.at("rcon")};
-    jRlsRcon.at("password").get_to(rconPassword_);
-    jRlsRcon.at("ip").get_to(rconIP_);
-    jRlsRcon.at("port").get_to(rconPort_);
-    if (jRlsRcon.contains("passthrough"))
-    {
-      const auto& jRlsRconPassthrough{jRlsRcon.at("passthrough")};
-      GetOptionalValueTo(rconPassthroughIP_, jRlsRconPassthrough, "ip");
-      GetOptionalValueTo(rconPassthroughPort_, jRlsRconPassthrough, "port");
-    }
-    GetOptionalValueTo(rconLog_, jRlsRcon, "log");
-
-    // seed
-    if (jRls.contains("seed"))
-    {
-      const auto& jRlsSeed{jRls.at("seed")};
-      // string that needs to be converted to an enum
-      seedStrategy_ = SeedStrategy::RANDOM;
-      const auto& seedStrategy{
-        GetOptionalValue<std::string>(jRlsSeed, "strategy")};
-      if (seedStrategy == "fixed") { seedStrategy_ = SeedStrategy::FIXED; }
-      else if (seedStrategy == "list") { seedStrategy_ = SeedStrategy::LIST; }
-      else if (seedStrategy == "random") { seedStrategy_ = SeedStrategy::RANDOM; }
-      else if (!seedStrategy.empty())
-      {
-        throw std::invalid_argument(
-          std::string("Invalid rustLaunchSite.seed.strategy value: ")
-          + seedStrategy
-        );
-      }
-      // supplemental settings may be required depending on seed strategy
-      switch (seedStrategy_)
-      {
-        case SeedStrategy::FIXED:
-        {
-          jRlsSeed.at("fixed").get_to(seedFixed_);
-        }
-        break;
-        case SeedStrategy::LIST:
-        {
-          jRlsSeed.at("list").get_to(seedList_);
-          if (seedList_.empty())
-          {
-            throw std::invalid_argument(
-              "Invalid rustLaunchSite.seed.list array");
-          }
-        }
-        break;
-        case SeedStrategy::RANDOM:
-        {
-          // no supplemental settings
-        }
-        break;
-      }
-    }
-
-    // update
-    if (jRls.contains("update"))
-    {
-      const auto& jRlsUpdate{jRls.at("update")};
-      //  server
-      if (jRlsUpdate.contains("server"))
-      {
-        const auto& jRlsUpdateServer{jRlsUpdate.at("server")};
-        GetOptionalValueTo(
-          updateServerOnInterval_, jRlsUpdateServer, "onInterval");
-        GetOptionalValueTo(
-          updateServerOnRelaunch_, jRlsUpdateServer, "onRelaunch");
-        GetOptionalValueTo(
-          updateServerOnStartup_, jRlsUpdateServer, "onStartup");
-        GetOptionalValueTo(
-          updateServerRetryDelaySeconds_, jRlsUpdateServer,
-          "updateServerRetryDelaySeconds"
-        );
-        if (updateServerRetryDelaySeconds_ < 0)
-        {
-          updateServerRetryDelaySeconds_ = 0;
-        }
-      }
-      //  modFramework
-      if (jRlsUpdate.contains("modFramework"))
-      {
-        const auto& jRlsUpdateModFramework{jRlsUpdate.at("modFramework")};
-        // process type first, because we want to force other values to false if
-        //  it does not resolve to a valid value
-        const auto& modFrameworkType{GetOptionalValue<std::string>(
-          jRlsUpdateModFramework, "type")};
-        if ("carbon" == modFrameworkType)
-        {
-          updateModFrameworkType_ = ModFrameworkType::CARBON;
-        }
-        else if ("oxide" == modFrameworkType)
-        {
-          updateModFrameworkType_ = ModFrameworkType::OXIDE;
-        }
-        else if (!modFrameworkType.empty())
-        {
-          std::cout << "WARNING: Ignoring unsupported modFramework.type value: '" << modFrameworkType << "'" << std::endl;
-        }
-        if (updateModFrameworkType_ != ModFrameworkType::NONE)
-        {
-          GetOptionalValueTo(updateModFrameworkOnInterval_,
-            jRlsUpdateModFramework, "onInterval");
-          GetOptionalValueTo(updateModFrameworkOnRelaunch_,
-            jRlsUpdateModFramework, "onRelaunch");
-          GetOptionalValueTo(updateModFrameworkOnServerUpdate_,
-            jRlsUpdateModFramework, "onServerUpdate");
-          GetOptionalValueTo(updateModFrameworkOnStartup_,
-            jRlsUpdateModFramework, "onStartup");
-          GetOptionalValueTo(
-            updateModFrameworkRetryDelaySeconds_, jRlsUpdateModFramework,
-            "updateModFrameworkRetryDelaySeconds"
-          );
-          if (updateModFrameworkRetryDelaySeconds_ < 0)
-          {
-            updateModFrameworkRetryDelaySeconds_ = 0;
-          }
-        }
-      }
-      GetOptionalValueTo(updateIntervalMinutes_, jRlsUpdate, "intervalMinutes");
-      // enforce validity & consistency here, to simplify dependent logic
-      if (updateIntervalMinutes_ < 0)
-      {
-        updateIntervalMinutes_ = 0;
-      }
-      else if (updateIntervalMinutes_
-        && !updateServerOnInterval_ && !updateModFrameworkOnInterval_)
-      {
-        std::cout << "WARNING: Ignoring update.intervalMinutes value because update.server and update.modFramework onInterval are both false: '" << updateIntervalMinutes_ << "'" << std::endl;
-        updateIntervalMinutes_ = 0;
-      }
-      if (!updateIntervalMinutes_)
-      {
-        if (updateServerOnInterval_)
-        {
-          std::cout << "WARNING: Ignoring update.server.onInterval=true because update.intervalMinutes=0" << std::endl;
-          updateServerOnInterval_ = false;
-        }
-        if (updateModFrameworkOnInterval_)
-        {
-          std::cout << "WARNING: Ignoring update.modFramework.onInterval=true because update.intervalMinutes=0" << std::endl;
-          updateModFrameworkOnInterval_ = false;
-        }
-      }
-    }
-
-    // wipe
-    if (jRls.contains("wipe"))
-    {
-      const auto& jRlsWipe{jRls.at("wipe")};
-      GetOptionalValueTo(wipeOnProtocolChange_, jRlsWipe, "onProtocolChange");
-      GetOptionalValueTo(wipeBlueprints_, jRlsWipe, "blueprints");
-    }
-
-    // *** rustDedicated settings ***
-    if (j.contains("rustDedicated"))
-    {
-      const auto& jRd{j.at("rustDedicated")};
-      if (jRd.contains("minusParams"))
-      {
-        GetParametersTo(minusParams_, jRd.at("minusParams"), "-");
-      }
-      if (jRd.contains("plusParams"))
-      {
-        GetParametersTo(plusParams_, jRd.at("plusParams"), "+");
-      }
-    }
-  }
-  catch (const nlohmann::json::exception& e)
-  {
-    throw std::invalid_argument(
-      std::string("JSON general exception while processing config data: ")
-      + e.what()
-    );
-  }
-  catch (const std::exception& e)
-  {
-    throw std::invalid_argument(
-      std::string("C++ general exception while processing config data: ")
-      + e.what()
-    );
-  }
-  catch (...)
-  {
-    throw std::invalid_argument(
-      "Unknown exception while processing config data");
-  }
-}
-}
+#include "Config.h"
+
+#include "Cron.h"
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <sstream>
+#include <string_view>
+
+namespace
+{
+// return value for the given key under the given JSON object if it exists, or a
+//  default value otherwise
+// NOTE: assumes that T has a copy constructor, plus a default constructor if no
+//  default value is provided
+template<typename T>
+T GetOptionalValue(
+  const nlohmann::json& j, std::string_view key, const T& defaultValue = {})
+{
+  if (j.contains(key)) { return j.at(key).template get<T>(); }
+  return defaultValue;
+}
+
+// assign to the given object the value for the given key under the given JSON
+//  object if the key exists, or assign the default value otherwise
+// NOTE: assumes that T has an assignment operator, plus a default constructor
+//  if no default value is provided
+template<typename T>
+void GetOptionalValueTo(
+  T& dest
+, const nlohmann::json& j
+, std::string_view key
+, const T& defaultValue = {})
+{
+  if (j.contains(key))
+  {
+    j.at(key).get_to(dest);
+  }
+  else
+  {
+    dest = defaultValue;
+  }
+}
+
+// validate a cron expression, unless it's empty
+// throws std::invalid_argument if invalid, naming `path` in the message
+void ValidateCron(const std::string& expression, const std::string& path)
+{
+  if (expression.empty()) { return; }
+  try
+  {
+    const rustLaunchSite::Cron cron(expression);
+  }
+  catch (const std::invalid_argument& e)
+  {
+    throw std::invalid_argument("Invalid " + path + " value: " + e.what());
+  }
+}
+
+// populate given priority profile with settings under given JSON object
+// throws std::invalid_argument on invalid values, naming `path` in the message
+void GetPriorityProfileTo(
+  rustLaunchSite::Config::PriorityProfile& profile
+, const nlohmann::json& j
+, const std::string& path
+)
+{
+  using rustLaunchSite::Config;
+  GetOptionalValueTo(profile.cpuAffinity_, j, "cpuAffinity");
+  for (const int cpu : profile.cpuAffinity_)
+  {
+    if (cpu < 0)
+    {
+      throw std::invalid_argument(
+        std::string("Invalid ") + path + ".cpuAffinity CPU index: "
+        + std::to_string(cpu));
+    }
+  }
+  if (j.contains("nice"))
+  {
+    profile.nice_ = j.at("nice").get<int>();
+    if (*profile.nice_ < -20 || *profile.nice_ > 19)
+    {
+      throw std::invalid_argument(
+        std::string("Invalid ") + path + ".nice value (must be -20 to 19): "
+        + std::to_string(*profile.nice_));
+    }
+  }
+  const auto& policy{GetOptionalValue<std::string>(j, "schedulingPolicy")};
+  if (policy.empty()) { profile.schedulingPolicy_ = Config::SchedulingPolicy::DEFAULT; }
+  else if (policy == "other") { profile.schedulingPolicy_ = Config::SchedulingPolicy::OTHER; }
+  else if (policy == "batch") { profile.schedulingPolicy_ = Config::SchedulingPolicy::BATCH; }
+  else if (policy == "idle") { profile.schedulingPolicy_ = Config::SchedulingPolicy::IDLE; }
+  else if (policy == "fifo") { profile.schedulingPolicy_ = Config::SchedulingPolicy::FIFO; }
+  else if (policy == "rr") { profile.schedulingPolicy_ = Config::SchedulingPolicy::RR; }
+  else
+  {
+    throw std::invalid_argument(
+      std::string("Invalid ") + path + ".schedulingPolicy value: " + policy);
+  }
+  GetOptionalValueTo(profile.schedulingPriority_, j, "schedulingPriority");
+  const bool isRealtime(
+    profile.schedulingPolicy_ == Config::SchedulingPolicy::FIFO ||
+    profile.schedulingPolicy_ == Config::SchedulingPolicy::RR
+  );
+  if (isRealtime &&
+    (profile.schedulingPriority_ < 1 || profile.schedulingPriority_ > 99))
+  {
+    throw std::invalid_argument(
+      std::string("Invalid ") + path
+      + ".schedulingPriority value (must be 1 to 99 for fifo/rr): "
+      + std::to_string(profile.schedulingPriority_));
+  }
+  // priority must be zero for non-realtime policies
+  if (!isRealtime) { profile.schedulingPriority_ = 0; }
+  const auto& ioClass{GetOptionalValue<std::string>(j, "ioClass")};
+  if (ioClass.empty()) { profile.ioClass_ = Config::IoClass::DEFAULT; }
+  else if (ioClass == "realtime") { profile.ioClass_ = Config::IoClass::REALTIME; }
+  else if (ioClass == "best-effort") { profile.ioClass_ = Config::IoClass::BEST_EFFORT; }
+  else if (ioClass == "idle") { profile.ioClass_ = Config::IoClass::IDLE; }
+  else
+  {
+    throw std::invalid_argument(
+      std::string("Invalid ") + path + ".ioClass value: " + ioClass);
+  }
+  GetOptionalValueTo(profile.ioLevel_, j, "ioLevel", 4);
+  if (profile.ioLevel_ < 0 || profile.ioLevel_ > 7)
+  {
+    throw std::invalid_argument(
+      std::string("Invalid ") + path + ".ioLevel value (must be 0 to 7): "
+      + std::to_string(profile.ioLevel_));
+  }
+}
+
+// merge environment settings under given JSON object into given profile
+// settings already present in the profile are kept unless overridden
+// throws std::invalid_argument on invalid values, naming `path` in the message
+void MergeEnvironmentProfileTo(
+  rustLaunchSite::Config::EnvironmentProfile& profile
+, const nlohmann::json& j
+, const std::string& path
+)
+{
+  if (j.contains("preload"))
+  {
+    j.at("preload").get_to(profile.preload_);
+    for (auto& library : profile.preload_) { library.make_preferred(); }
+  }
+  // convenience settings for the most commonly tuned variables
+  if (j.contains("mallocArenaMax"))
+  {
+    const int arenaMax(j.at("mallocArenaMax").get<int>());
+    if (arenaMax < 1)
+    {
+      throw std::invalid_argument(
+        std::string("Invalid ") + path
+        + ".mallocArenaMax value (must be positive): "
+        + std::to_string(arenaMax));
+    }
+    profile.vars_["MALLOC_ARENA_MAX"] = std::to_string(arenaMax);
+  }
+  if (j.contains("monoGcParams"))
+  {
+    profile.vars_["MONO_GC_PARAMS"] = j.at("monoGcParams").get<std::string>();
+  }
+  if (!j.contains("vars")) { return; }
+  for (const auto& [name, value] : j.at("vars").items())
+  {
+    if (name.empty() || name.find('=') != std::string::npos)
+    {
+      throw std::invalid_argument(
+        std::string("Invalid ") + path + ".vars variable name: " + name);
+    }
+    if (value.is_null())
+    {
+      profile.vars_[name].reset();
+    }
+    else if (value.is_string())
+    {
+      profile.vars_[name] = value.get<std::string>();
+    }
+    else
+    {
+      throw std::invalid_argument(
+        std::string("Invalid ") + path + ".vars." + name
+        + " value (must be string or null): " + value.dump());
+    }
+  }
+}
+
+// populate given parameter map with config settings under given JSON tree
+// NOTES:
+// - this is called recursively to walk the tree
+// - tree structure is flattened by concatenating successive levels' key names
+//    to `path`, using `.` as a separator
+// - it is expected that the JSON node that represents the initial `path`
+//    starting point will be passed in, and `path` will be used as its name in
+//    place of its actual key in order to support a custom parameter prefix
+void GetParametersTo(
+  rustLaunchSite::Config::ParameterMapType& pMap
+, const nlohmann::json& j
+, const std::string& path
+)
+{
+  // std::cout << "GetParametersTo(): Called with path=" << path << std::endl;
+
+  // iterate over all items under j
+  for (const auto& [key, value] : j.items())
+  {
+    // add item's name to current level starting path to get its full path
+    const std::string& itemPath{path + key};
+    // store data values in map, or recruse into objects
+    switch (value.type())
+    {
+      case nlohmann::json::value_t::boolean:
+      {
+        pMap.try_emplace(itemPath, value.template get<bool>());
+        // std::cout << "GetParametersTo(): Emplaced bool " << itemPath << " = " << pMap.at(itemPath).ToString() << std::endl;
+      }
+      break;
+      case nlohmann::json::value_t::number_float:
+      {
+        pMap.try_emplace(itemPath, value.template get<double>());
+        // std::cout << "GetParametersTo(): Emplaced double " << itemPath << " = " << pMap.at(itemPath).ToString() << std::endl;
+      }
+      break;
+      case nlohmann::json::value_t::number_integer:
+      case nlohmann::json::value_t::number_unsigned:
+      {
+        pMap.try_emplace(itemPath, value.template get<int>());
+        // std::cout << "GetParametersTo(): Emplaced int " << itemPath << " = " << pMap.at(itemPath).ToString() << std::endl;
+      }
+      break;
+      case nlohmann::json::value_t::object:
+      {
+        // std::cout << "GetParametersTo(): Recursing into " << itemPath << std::endl;
+        GetParametersTo(pMap, value, itemPath + ".");
+      }
+      break;
+      case nlohmann::json::value_t::string:
+      {
+        pMap.try_emplace(itemPath, value.template get<std::string>());
+        // std::cout << "GetParametersTo(): Emplaced string " << itemPath << " = " << pMap.at(itemPath).ToString() << std::endl;
+      }
+      break;
+      default:
+      {
+        std::cout << "WARNING: Ignoring JSON itemPath='" << itemPath << "' with unsupported type" << std::endl;
+      }
+    }
+  }
+}
+}
+namespace rustLaunchSite
+{
+Config::Config(std::filesystem::path configFile)
+{
+  configFile.make_preferred();
+  // attempt to parse configFile via nlohmann/json
+  nlohmann::json j{};
+  try
+  {
+    j = nlohmann::json::parse(std::ifstream{configFile}, nullptr, true, true);
+  }
+  catch (const nlohmann::json::parse_error& e)
+  {
+    std::stringstream s;
+    s << e.byte;
+    throw std::invalid_argument(
+      std::string("JSON parsing exception at byte ") + s.str()
+      + " of config file '" + configFile.string() + "': " + e.what()
+    );
+  }
+  catch (const nlohmann::json::exception& e)
+  {
+    throw std::invalid_argument(
+      std::string("JSON general exception while parsing config file '")
+      + configFile.string() + "': " + e.what()
+    );
+  }
+  catch (const std::exception& e)
+  {
+    throw std::invalid_argument(
+      std::string("C++ general exception while parsing config file '")
+      + configFile.string() + "': " + e.what()
+    );
+  }
+  catch (...)
+  {
+    throw std::invalid_argument(
+      std::string("Unknown exception while parsing config file '")
+      + configFile.string() + "'"
+    );
+  }
+  // at this point the parse has succeeded
+  // grab and validate settings
+
+  try
+  {
+    // *** rustLaunchSite settings ***
+    const auto& jRls{j.at("rustLaunchSite")};
+
+    // just look up required settings
+    // if they don't exist, an exception will be thrown
+
+    // install
+    const auto& jRlsInstall{jRls.at("install")};
+    jRlsInstall.at("path").get_to(installPath_);
+    installPath_.make_preferred();
+    jRlsInstall.at("identity").get_to(installIdentity_);
+
+    // paths
+    const auto& jRlsPaths{jRls.at("paths")};
+    jRlsPaths.at("cache").get_to(pathsCache_);
+    pathsCache_.make_preferred();
+    jRlsPaths.at("download").get_to(pathsDownload_);
+    pathsDownload_.make_preferred();
+    // data directory defaults to wherever the cache file lives
+    GetOptionalValueTo(
+      pathsData_, jRlsPaths, "data", pathsCache_.parent_path());
+    pathsData_.make_preferred();
+
+    // backup
+    backup_.repository_ = pathsData_ / "backups";
+    if (jRls.contains("backup"))
+    {
+      const auto& jRlsBackup{jRls.at("backup")};
+      GetOptionalValueTo(
+        backup_.intervalMinutes_, jRlsBackup, "intervalMinutes", 0);
+      GetOptionalValueTo(backup_.schedule_, jRlsBackup, "schedule");
+      ValidateCron(backup_.schedule_, "rustLaunchSite.backup.schedule");
+      GetOptionalValueTo(backup_.retain_, jRlsBackup, "retain", 24);
+      GetOptionalValueTo(
+        backup_.compressionLevel_, jRlsBackup, "compressionLevel", 3);
+      GetOptionalValueTo(backup_.threads_, jRlsBackup, "threads", 0);
+      GetOptionalValueTo(
+        backup_.repository_, jRlsBackup, "repository",
+        pathsData_ / "backups");
+      backup_.repository_.make_preferred();
+      GetOptionalValueTo(backup_.extraPaths_, jRlsBackup, "extraPaths");
+      for (const auto& extraPath : backup_.extraPaths_)
+      {
+        const std::filesystem::path path(extraPath);
+        if (path.empty() || path.is_absolute())
+        {
+          throw std::invalid_argument(
+            "Invalid rustLaunchSite.backup.extraPaths entry: `" + extraPath +
+            "` (must be relative to install.path)");
+        }
+      }
+      if (backup_.compressionLevel_ < 1 || backup_.compressionLevel_ > 19)
+      {
+        throw std::invalid_argument(
+          "Invalid rustLaunchSite.backup.compressionLevel value: " +
+          std::to_string(backup_.compressionLevel_));
+      }
+      // collapse other possible "disable" values to zero
+      if (backup_.intervalMinutes_ < 0) { backup_.intervalMinutes_ = 0; }
+      if (backup_.retain_ < 0) { backup_.retain_ = 0; }
+      if (backup_.threads_ < 0) { backup_.threads_ = 0; }
+    }
+
+    // process
+    if (jRls.contains("process"))
+    {
+      const auto& jRlsProcess{jRls.at("process")};
+      GetOptionalValueTo(processAutoRestart_, jRlsProcess, "autoRestart");
+      GetOptionalValueTo(
+        processRestartSchedule_, jRlsProcess, "restartSchedule");
+      ValidateCron(
+        processRestartSchedule_, "rustLaunchSite.process.restartSchedule");
+      // default optional integer to zero
+      GetOptionalValueTo(
+        processShutdownDelaySeconds_, jRlsProcess, "shutdownDelaySeconds");
+      // collapse other possible "disable" values to zero
+      if (processShutdownDelaySeconds_ < 0)
+      {
+        processShutdownDelaySeconds_ = 0;
+      }
+      // keep built-in marks unless overridden
+      if (jRlsProcess.contains("shutdownDelayMarks"))
+      {
+        processShutdownDelayMarks_.clear();
+        for (const auto& jMark : jRlsProcess.at("shutdownDelayMarks"))
+        {
+          CountdownMark mark;
+          GetOptionalValueTo(mark.aboveSeconds_, jMark, "aboveSeconds");
+          GetOptionalValueTo(mark.intervalSeconds_, jMark, "intervalSeconds");
+          if (mark.aboveSeconds_ < 0 || mark.intervalSeconds_ < 1)
+          {
+            throw std::invalid_argument(
+              "Invalid rustLaunchSite.process.shutdownDelayMarks entry "
+              "(aboveSeconds must be non-negative, and intervalSeconds must "
+              "be positive): " + jMark.dump());
+          }
+          processShutdownDelayMarks_.push_back(mark);
+        }
+        // rules are evaluated from most to least time remaining
+        std::sort(
+          processShutdownDelayMarks_.begin(), processShutdownDelayMarks_.end(),
+          [](const CountdownMark& lhs, const CountdownMark& rhs)
+          {
+            return lhs.aboveSeconds_ > rhs.aboveSeconds_;
+          }
+        );
+      }
+      GetOptionalValueTo(
+        processShutdownSaveTimeoutSeconds_, jRlsProcess,
+        "shutdownSaveTimeoutSeconds", 120);
+      if (processShutdownSaveTimeoutSeconds_ < 0)
+      {
+        processShutdownSaveTimeoutSeconds_ = 0;
+      }
+      GetOptionalValueTo(
+        processShutdownQuitTimeoutSeconds_, jRlsProcess,
+        "shutdownQuitTimeoutSeconds", 60);
+      if (processShutdownQuitTimeoutSeconds_ < 0)
+      {
+        processShutdownQuitTimeoutSeconds_ = 0;
+      }
+      GetOptionalValueTo(
+        processShutdownTerminateTimeoutSeconds_, jRlsProcess,
+        "shutdownTerminateTimeoutSeconds", 15);
+      if (processShutdownTerminateTimeoutSeconds_ < 0)
+      {
+        processShutdownTerminateTimeoutSeconds_ = 0;
+      }
+      GetOptionalValueTo(
+        processOutputBufferLines_, jRlsProcess, "outputBufferLines", 500);
+      // collapse other possible "disable" values to zero
+      if (processOutputBufferLines_ < 0)
+      {
+        processOutputBufferLines_ = 0;
+      }
+      if (jRlsProcess.contains("priority"))
+      {
+        GetPriorityProfileTo(
+          processPriority_, jRlsProcess.at("priority"),
+          "rustLaunchSite.process.priority");
+      }
+      if (jRlsProcess.contains("environment"))
+      {
+        const auto& jRlsProcessEnvironment{jRlsProcess.at("environment")};
+        const std::string envPath("rustLaunchSite.process.environment");
+        // start with selected preset (if any), then apply overrides
+        GetOptionalValueTo(
+          processEnvironment_.name_, jRlsProcessEnvironment, "profile");
+        if (!processEnvironment_.name_.empty())
+        {
+          if (!jRlsProcessEnvironment.contains("profiles") ||
+            !jRlsProcessEnvironment.at("profiles").contains(
+              processEnvironment_.name_))
+          {
+            throw std::invalid_argument(
+              std::string("Invalid ") + envPath + ".profile value (no such "
+              "profile defined): " + processEnvironment_.name_);
+          }
+          MergeEnvironmentProfileTo(
+            processEnvironment_,
+            jRlsProcessEnvironment.at("profiles").at(processEnvironment_.name_),
+            envPath + ".profiles." + processEnvironment_.name_);
+        }
+        MergeEnvironmentProfileTo(
+          processEnvironment_, jRlsProcessEnvironment, envPath);
+      }
+      if (jRlsProcess.contains("cgroup"))
+      {
+        const auto& jRlsProcessCgroup{jRlsProcess.at("cgroup")};
+        auto& cgroup(processCgroup_);
+        GetOptionalValueTo(cgroup.enabled_, jRlsProcessCgroup, "enabled");
+        GetOptionalValueTo(cgroup.parent_, jRlsProcessCgroup, "parent");
+        GetOptionalValueTo(cgroup.name_, jRlsProcessCgroup, "name");
+        GetOptionalValueTo(cgroup.cpuWeight_, jRlsProcessCgroup, "cpuWeight");
+        GetOptionalValueTo(
+          cgroup.cpuMaxPercent_, jRlsProcessCgroup, "cpuMaxPercent");
+        GetOptionalValueTo(
+          cgroup.memoryHighMb_, jRlsProcessCgroup, "memoryHighMb");
+        GetOptionalValueTo(
+          cgroup.memoryMaxMb_, jRlsProcessCgroup, "memoryMaxMb");
+        GetOptionalValueTo(cgroup.ioWeight_, jRlsProcessCgroup, "ioWeight");
+        // collapse other possible "unset" values to zero
+        if (cgroup.cpuMaxPercent_ < 0) { cgroup.cpuMaxPercent_ = 0; }
+        if (cgroup.memoryHighMb_ < 0) { cgroup.memoryHighMb_ = 0; }
+        if (cgroup.memoryMaxMb_ < 0) { cgroup.memoryMaxMb_ = 0; }
+        // weights have a fixed valid range
+        if (cgroup.cpuWeight_ < 0 || cgroup.cpuWeight_ > 10000)
+        {
+          throw std::invalid_argument(
+            "Invalid rustLaunchSite.process.cgroup.cpuWeight value (must be "
+            "in range 1-10000, or 0 to leave unset): " +
+            std::to_string(cgroup.cpuWeight_));
+        }
+        if (cgroup.ioWeight_ < 0 || cgroup.ioWeight_ > 10000)
+        {
+          throw std::invalid_argument(
+            "Invalid rustLaunchSite.process.cgroup.ioWeight value (must be "
+            "in range 1-10000, or 0 to leave unset): " +
+            std::to_string(cgroup.ioWeight_));
+        }
+        // cgroup names can't contain path separators
+        if (cgroup.name_.find('/') != std::string::npos)
+        {
+          throw std::invalid_argument(
+            "Invalid rustLaunchSite.process.cgroup.name value (must not "
+            "contain `/`): " + cgroup.name_);
+        }
+      }
+      if (jRlsProcess.contains("restartPolicy"))
+      {
+        const auto& jRlsProcessRestart{jRlsProcess.at("restartPolicy")};
+        auto& policy(processRestartPolicy_);
+        GetOptionalValueTo(policy.minFramerate_, jRlsProcessRestart, "minFramerate");
+        GetOptionalValueTo(
+          policy.framerateSustainSeconds_, jRlsProcessRestart,
+          "framerateSustainSeconds", 600);
+        GetOptionalValueTo(policy.maxMemoryMb_, jRlsProcessRestart, "maxMemoryMb");
+        GetOptionalValueTo(
+          policy.memoryTrendMinutes_, jRlsProcessRestart, "memoryTrendMinutes");
+        GetOptionalValueTo(
+          policy.maxEntityCount_, jRlsProcessRestart, "maxEntityCount");
+        GetOptionalValueTo(
+          policy.minUptimeMinutes_, jRlsProcessRestart, "minUptimeMinutes", 60);
+        // collapse other possible "disable" values to zero
+        if (policy.minFramerate_ < 0) { policy.minFramerate_ = 0; }
+        if (policy.framerateSustainSeconds_ < 0) { policy.framerateSustainSeconds_ = 0; }
+        if (policy.maxMemoryMb_ < 0) { policy.maxMemoryMb_ = 0; }
+        if (policy.memoryTrendMinutes_ < 0) { policy.memoryTrendMinutes_ = 0; }
+        if (policy.maxEntityCount_ < 0) { policy.maxEntityCount_ = 0; }
+        if (policy.minUptimeMinutes_ < 0) { policy.minUptimeMinutes_ = 0; }
+      }
+      if (jRlsProcess.contains("crashLoop"))
+      {
+        const auto& jRlsProcessCrash{jRlsProcess.at("crashLoop")};
+        auto& crashLoop(processCrashLoop_);
+        GetOptionalValueTo(
+          crashLoop.maxCrashes_, jRlsProcessCrash, "maxCrashes", 3);
+        GetOptionalValueTo(
+          crashLoop.windowMinutes_, jRlsProcessCrash, "windowMinutes", 10);
+        GetOptionalValueTo(
+          crashLoop.backoffSeconds_, jRlsProcessCrash, "backoffSeconds", 30);
+        GetOptionalValueTo(
+          crashLoop.maxBackoffSeconds_, jRlsProcessCrash, "maxBackoffSeconds",
+          1800);
+        GetOptionalValueTo(
+          crashLoop.validateInstall_, jRlsProcessCrash, "validateInstall");
+        GetOptionalValueTo(
+          crashLoop.rollbackFramework_, jRlsProcessCrash, "rollbackFramework");
+        GetOptionalValueTo(
+          crashLoop.rollbackInstall_, jRlsProcessCrash, "rollbackInstall");
+        GetOptionalValueTo(
+          crashLoop.artifactsRetained_, jRlsProcessCrash, "artifactsRetained",
+          10);
+        // collapse other possible "disable" values to zero
+        if (crashLoop.maxCrashes_ < 0 || crashLoop.windowMinutes_ <= 0)
+        {
+          crashLoop.maxCrashes_ = 0;
+        }
+        if (crashLoop.backoffSeconds_ < 0) { crashLoop.backoffSeconds_ = 0; }
+        if (crashLoop.maxBackoffSeconds_ < 0) { crashLoop.maxBackoffSeconds_ = 0; }
+        if (crashLoop.artifactsRetained_ < 0) { crashLoop.artifactsRetained_ = 0; }
+      }
+      if (jRlsProcess.contains("watchdog"))
+      {
+        const auto& jRlsProcessWatchdog{jRlsProcess.at("watchdog")};
+        auto& watchdog(processWatchdog_);
+        GetOptionalValueTo(
+          watchdog.hangSeconds_, jRlsProcessWatchdog, "hangSeconds", 600);
+        GetOptionalValueTo(
+          watchdog.minFramerate_, jRlsProcessWatchdog, "minFramerate", 1.0);
+        GetOptionalValueTo(
+          watchdog.threadDumpSeconds_, jRlsProcessWatchdog,
+          "threadDumpSeconds", 5);
+        // collapse other possible "disable" values to zero
+        if (watchdog.hangSeconds_ < 0) { watchdog.hangSeconds_ = 0; }
+        if (watchdog.minFramerate_ < 0) { watchdog.minFramerate_ = 0; }
+        if (watchdog.threadDumpSeconds_ < 0) { watchdog.threadDumpSeconds_ = 0; }
+      }
+      if (jRlsProcess.contains("resourceSampling"))
+      {
+        const auto& jRlsProcessSampling{jRlsProcess.at("resourceSampling")};
+        GetOptionalValueTo(
+          processResourceSamplingIntervalSeconds_, jRlsProcessSampling,
+          "intervalSeconds", 10);
+        GetOptionalValueTo(
+          processResourceSamplingSamples_, jRlsProcessSampling, "samples", 360);
+        // collapse other possible "disable" values to zero
+        if (processResourceSamplingIntervalSeconds_ < 0 ||
+          processResourceSamplingSamples_ <= 0)
+        {
+          processResourceSamplingIntervalSeconds_ = 0;
+        }
+      }
+      if (jRlsProcess.contains("telemetry"))
+      {
+        const auto& jRlsProcessTelemetry{jRlsProcess.at("telemetry")};
+        GetOptionalValueTo(
+          processTelemetryIntervalSeconds_, jRlsProcessTelemetry,
+          "intervalSeconds", 60);
+        GetOptionalValueTo(
+          processTelemetryRetentionDays_, jRlsProcessTelemetry,
+          "retentionDays", 28);
+        // collapse other possible "disable" values to zero
+        if (processTelemetryIntervalSeconds_ < 0 ||
+          processTelemetryRetentionDays_ <= 0)
+        {
+          processTelemetryIntervalSeconds_ = 0;
+        }
+      }
+      if (jRlsProcess.contains("startup"))
+      {
+        const auto& jRlsProcessStartup{jRlsProcess.at("startup")};
+        // keep built-in markers for anything not overridden
+        if (jRlsProcessStartup.contains("readyMarkers"))
+        {
+          jRlsProcessStartup.at("readyMarkers").get_to(
+            processStartupReadyMarkers_);
+        }
+        if (jRlsProcessStartup.contains("phaseMarkers"))
+        {
+          jRlsProcessStartup.at("phaseMarkers").get_to(
+            processStartupPhaseMarkers_);
+        }
+      }
+      if (jRlsProcess.contains("logMonitor"))
+      {
+        const auto& jRlsProcessLog{jRlsProcess.at("logMonitor")};
+        GetOptionalValueTo(
+          processLogMonitorPollIntervalMilliseconds_, jRlsProcessLog,
+          "pollIntervalMilliseconds", 1000);
+        // collapse other possible "disable" values to zero
+        if (processLogMonitorPollIntervalMilliseconds_ < 0)
+        {
+          processLogMonitorPollIntervalMilliseconds_ = 0;
+        }
+        // keep built-in patterns if not overridden
+        if (jRlsProcessLog.contains("patterns"))
+        {
+          jRlsProcessLog.at("patterns").get_to(processLogMonitorPatterns_);
+        }
+      }
+    }
+
+    // rcon
+    const auto& jRlsRcon{jRls.at("rcon")};
+    jRlsRcon.at("password").get_to(rconPassword_);
+    jRlsRcon.at("ip").get_to(rconIP_);
+    jRlsRcon.at("port").get_to(rconPort_);
+    if (jRlsRcon.contains("passthrough"))
+    {
+      const auto& jRlsRconPassthrough{jRlsRcon.at("passthrough")};
+      GetOptionalValueTo(rconPassthroughIP_, jRlsRconPassthrough, "ip");
+      GetOptionalValueTo(rconPassthroughPort_, jRlsRconPassthrough, "port");
+    }
+    GetOptionalValueTo(rconLog_, jRlsRcon, "log");
+
+    // seed
+    if (jRls.contains("seed"))
+    {
+      const auto& jRlsSeed{jRls.at("seed")};
+      // string that needs to be converted to an enum
+      seedStrategy_ = SeedStrategy::RANDOM;
+      const auto& seedStrategy{
+        GetOptionalValue<std::string>(jRlsSeed, "strategy")};
+      if (seedStrategy == "fixed") { seedStrategy_ = SeedStrategy::FIXED; }
+      else if (seedStrategy == "list") { seedStrategy_ = SeedStrategy::LIST; }
+      else if (seedStrategy == "random") { seedStrategy_ = SeedStrategy::RANDOM; }
+      else if (!seedStrategy.empty())
+      {
+        throw std::invalid_argument(
+          std::string("Invalid rustLaunchSite.seed.strategy value: ")
+          + seedStrategy
+        );
+      }
+      // supplemental settings may be required depending on seed strategy
+      switch (seedStrategy_)
+      {
+        case SeedStrategy::FIXED:
+        {
+          jRlsSeed.at("fixed").get_to(seedFixed_);
+        }
+        break;
+        case SeedStrategy::LIST:
+        {
+          jRlsSeed.at("list").get_to(seedList_);
+          if (seedList_.empty())
+          {
+            throw std::invalid_argument(
+              "Invalid rustLaunchSite.seed.list array");
+          }
+        }
+        break;
+        case SeedStrategy::RANDOM:
+        {
+          if (jRlsSeed.contains("random"))
+          {
+            const auto& jRlsSeedRandom{jRlsSeed.at("random")};
+            GetOptionalValueTo(
+              seedRandom_.salt_, jRlsSeedRandom, "salt", std::uint64_t{0});
+          }
+        }
+        break;
+      }
+      if (jRlsSeed.contains("pregenerate"))
+      {
+        const auto& jRlsSeedPregen{jRlsSeed.at("pregenerate")};
+        auto& pregen(seedPregenerate_);
+        GetOptionalValueTo(pregen.enabled_, jRlsSeedPregen, "enabled");
+        GetOptionalValueTo(
+          pregen.identity_, jRlsSeedPregen, "identity",
+          std::string("rustLaunchSitePregen"));
+        GetOptionalValueTo(
+          pregen.basePort_, jRlsSeedPregen, "basePort", 28115);
+        GetOptionalValueTo(
+          pregen.timeoutMinutes_, jRlsSeedPregen, "timeoutMinutes", 60);
+        if (pregen.basePort_ <= 0 || pregen.basePort_ > 65533)
+        {
+          throw std::invalid_argument(
+            "Invalid rustLaunchSite.seed.pregenerate.basePort value: " +
+            std::to_string(pregen.basePort_));
+        }
+        // collapse other possible "disable" values to zero
+        if (pregen.timeoutMinutes_ <= 0) { pregen.enabled_ = false; }
+      }
+    }
+
+    // update
+    if (jRls.contains("update"))
+    {
+      const auto& jRlsUpdate{jRls.at("update")};
+      //  server
+      if (jRlsUpdate.contains("server"))
+      {
+        const auto& jRlsUpdateServer{jRlsUpdate.at("server")};
+        GetOptionalValueTo(
+          updateServerOnInterval_, jRlsUpdateServer, "onInterval");
+        GetOptionalValueTo(
+          updateServerOnRelaunch_, jRlsUpdateServer, "onRelaunch");
+        GetOptionalValueTo(
+          updateServerOnStartup_, jRlsUpdateServer, "onStartup");
+        GetOptionalValueTo(
+          updateServerRetryDelaySeconds_, jRlsUpdateServer,
+          "updateServerRetryDelaySeconds"
+        );
+        if (updateServerRetryDelaySeconds_ < 0)
+        {
+          updateServerRetryDelaySeconds_ = 0;
+        }
+      }
+      //  modFramework
+      if (jRlsUpdate.contains("modFramework"))
+      {
+        const auto& jRlsUpdateModFramework{jRlsUpdate.at("modFramework")};
+        // process type first, because we want to force other values to false if
+        //  it does not resolve to a valid value
+        const auto& modFrameworkType{GetOptionalValue<std::string>(
+          jRlsUpdateModFramework, "type")};
+        if ("carbon" == modFrameworkType)
+        {
+          updateModFrameworkType_ = ModFrameworkType::CARBON;
+        }
+        else if ("oxide" == modFrameworkType)
+        {
+          updateModFrameworkType_ = ModFrameworkType::OXIDE;
+        }
+        else if (!modFrameworkType.empty())
+        {
+          std::cout << "WARNING: Ignoring unsupported modFramework.type value: '" << modFrameworkType << "'" << std::endl;
+        }
+        if (updateModFrameworkType_ != ModFrameworkType::NONE)
+        {
+          GetOptionalValueTo(updateModFrameworkOnInterval_,
+            jRlsUpdateModFramework, "onInterval");
+          GetOptionalValueTo(updateModFrameworkOnRelaunch_,
+            jRlsUpdateModFramework, "onRelaunch");
+          GetOptionalValueTo(updateModFrameworkOnServerUpdate_,
+            jRlsUpdateModFramework, "onServerUpdate");
+          GetOptionalValueTo(updateModFrameworkOnStartup_,
+            jRlsUpdateModFramework, "onStartup");
+          GetOptionalValueTo(
+            updateModFrameworkRetryDelaySeconds_, jRlsUpdateModFramework,
+            "updateModFrameworkRetryDelaySeconds"
+          );
+          if (updateModFrameworkRetryDelaySeconds_ < 0)
+          {
+            updateModFrameworkRetryDelaySeconds_ = 0;
+          }
+        }
+      }
+      if (jRlsUpdate.contains("priority"))
+      {
+        GetPriorityProfileTo(
+          updatePriority_, jRlsUpdate.at("priority"),
+          "rustLaunchSite.update.priority");
+      }
+      GetOptionalValueTo(updateIntervalMinutes_, jRlsUpdate, "intervalMinutes");
+      GetOptionalValueTo(updateSnapshot_, jRlsUpdate, "snapshot");
+      // enforce validity & consistency here, to simplify dependent logic
+      if (updateIntervalMinutes_ < 0)
+      {
+        updateIntervalMinutes_ = 0;
+      }
+      else if (updateIntervalMinutes_
+        && !updateServerOnInterval_ && !updateModFrameworkOnInterval_)
+      {
+        std::cout << "WARNING: Ignoring update.intervalMinutes value because update.server and update.modFramework onInterval are both false: '" << updateIntervalMinutes_ << "'" << std::endl;
+        updateIntervalMinutes_ = 0;
+      }
+      if (!updateIntervalMinutes_)
+      {
+        if (updateServerOnInterval_)
+        {
+          std::cout << "WARNING: Ignoring update.server.onInterval=true because update.intervalMinutes=0" << std::endl;
+          updateServerOnInterval_ = false;
+        }
+        if (updateModFrameworkOnInterval_)
+        {
+          std::cout << "WARNING: Ignoring update.modFramework.onInterval=true because update.intervalMinutes=0" << std::endl;
+          updateModFrameworkOnInterval_ = false;
+        }
+      }
+    }
+
+    // wipe
+    if (jRls.contains("wipe"))
+    {
+      const auto& jRlsWipe{jRls.at("wipe")};
+      GetOptionalValueTo(wipeOnProtocolChange_, jRlsWipe, "onProtocolChange");
+      GetOptionalValueTo(wipeBlueprints_, jRlsWipe, "blueprints");
+      GetOptionalValueTo(wipeSchedule_, jRlsWipe, "schedule");
+      ValidateCron(wipeSchedule_, "rustLaunchSite.wipe.schedule");
+    }
+
+    // *** rustDedicated settings ***
+    if (j.contains("rustDedicated"))
+    {
+      const auto& jRd{j.at("rustDedicated")};
+      if (jRd.contains("minusParams"))
+      {
+        GetParametersTo(minusParams_, jRd.at("minusParams"), "-");
+      }
+      if (jRd.contains("plusParams"))
+      {
+        GetParametersTo(plusParams_, jRd.at("plusParams"), "+");
+      }
+    }
+  }
+  catch (const nlohmann::json::exception& e)
+  {
+    throw std::invalid_argument(
+      std::string("JSON general exception while processing config data: ")
+      + e.what()
+    );
+  }
+  catch (const std::exception& e)
+  {
+    throw std::invalid_argument(
+      std::string("C++ general exception while processing config data: ")
+      + e.what()
+    );
+  }
+  catch (...)
+  {
+    throw std::invalid_argument(
+      "Unknown exception while processing config data");
+  }
+}
+}
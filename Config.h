@@ -1,190 +1,412 @@
-#ifndef CONFIG_H
-#define CONFIG_H
-
-#include <filesystem>
-#include <map>
-#include <optional>
-#include <sstream>
-#include <string>
-#include <vector>
-
-namespace rustLaunchSite
-{
-/// @brief rustLaunchSite application configuration facility
-/// @details Abstracts use of config file parser to load config file data into
-///  an instance of this class, which can then be queried for settings. Only
-///  the constructor should throw exceptions.
-class Config
-{
-public:
-
-  enum class ModFrameworkType { NONE, CARBON, OXIDE };
-
-  enum class SeedStrategy { FIXED, LIST, RANDOM };
-
-  struct Parameter
-  {
-    std::optional<bool>        boolValue_;
-    std::optional<double>      doubleValue_;
-    std::optional<int>         intValue_;
-    std::optional<std::string> stringValue_;
-
-    explicit Parameter()                     : boolValue_(false) {}
-    explicit Parameter(const bool b)         : boolValue_(b)     {}
-    explicit Parameter(const double d)       : doubleValue_(d)   {}
-    explicit Parameter(const int i)          : intValue_(i)      {}
-    explicit Parameter(const std::string& s) : stringValue_(s)   {}
-
-    Parameter(const Parameter& rhs) = default;
-
-    Parameter(Parameter&& rhs) noexcept
-      : boolValue_  (std::move(rhs.boolValue_))
-      , doubleValue_(std::move(rhs.doubleValue_))
-      , intValue_   (std::move(rhs.intValue_))
-      , stringValue_(std::move(rhs.stringValue_))
-    {
-    }
-
-    ~Parameter() = default;
-
-    Parameter& operator= (const Parameter& rhs)
-    {
-      if (&rhs == this) return *this;
-      boolValue_   = rhs.boolValue_;
-      doubleValue_ = rhs.doubleValue_;
-      intValue_    = rhs.intValue_;
-      stringValue_ = rhs.stringValue_;
-      return *this;
-    }
-
-    std::string ToString() const
-    {
-      std::stringstream s;
-      if (boolValue_)   { s << *boolValue_;   return s.str(); }
-      if (doubleValue_) { s << *doubleValue_; return s.str(); }
-      if (intValue_)    { s << *intValue_;    return s.str(); }
-      // if (stringValue_) { return std::string("\"") + *stringValue_ + '\"'; }
-      if (stringValue_) { return *stringValue_; }
-      return "<UNKNOWN>";
-    }
-  };
-
-  using ParameterMapType = std::map<std::string, Parameter, std::less<>>;
-
-  /// @brief Primary constructor
-  /// @details Creates an instance that is populated with data from the
-  ///  specified config file.
-  /// @param configFile Configuration file to load
-  /// @throw @c std::invalid_argument on parse or validation failure
-  explicit Config(std::filesystem::path configFile);
-
-  // accessor methods for loaded settings
-
-  std::filesystem::path GetInstallPath()                         const
-    { return installPath_; }
-  std::string           GetInstallIdentity()                     const
-    { return installIdentity_; }
-  std::filesystem::path GetPathsCache()                          const
-    { return pathsCache_; }
-  std::filesystem::path GetPathsDownload()                       const
-    { return pathsDownload_; }
-  bool                  GetProcessAutoRestart()                  const
-    { return processAutoRestart_; }
-  int                   GetProcessShutdownDelaySeconds()         const
-    { return processShutdownDelaySeconds_; }
-  std::string           GetRconPassword()                        const
-    { return rconPassword_; }
-  std::string           GetRconIP()                              const
-    { return rconIP_; }
-  int                   GetRconPort()                            const
-    { return rconPort_; }
-  bool                  GetRconPassthroughIP()                   const
-    { return rconPassthroughIP_; }
-  bool                  GetRconPassthroughPort()                 const
-    { return rconPassthroughPort_; }
-  bool                  GetRconLog()                             const
-    { return rconLog_; }
-  SeedStrategy          GetSeedStrategy()                        const
-    { return seedStrategy_; }
-  int                   GetSeedFixed()                           const
-    { return seedFixed_; }
-  std::vector<int>      GetSeedList()                            const
-    { return seedList_; }
-  bool                  GetUpdateServerOnInterval()              const
-    { return updateServerOnInterval_; }
-  bool                  GetUpdateServerOnRelaunch()              const
-    { return updateServerOnRelaunch_; }
-  bool                  GetUpdateServerOnStartup()               const
-    { return updateServerOnStartup_; }
-  int                   GetUpdateServerRetryDelaySeconds()       const
-    { return updateServerRetryDelaySeconds_; }
-  bool                  GetUpdateModFrameworkOnInterval()        const
-    { return updateModFrameworkOnInterval_; }
-  bool                  GetUpdateModFrameworkOnRelaunch()        const
-    { return updateModFrameworkOnRelaunch_; }
-  bool                  GetUpdateModFrameworkOnServerUpdate()    const
-    { return updateModFrameworkOnServerUpdate_; }
-  bool                  GetUpdateModFrameworkOnStartup()         const
-    { return updateModFrameworkOnStartup_; }
-  int                   GetUpdateModFrameworkRetryDelaySeconds() const
-    { return updateModFrameworkRetryDelaySeconds_; }
-  ModFrameworkType      GetUpdateModFrameworkType()              const
-    { return updateModFrameworkType_; }
-  int                   GetUpdateIntervalMinutes()               const
-    { return updateIntervalMinutes_; }
-  bool                  GetWipeOnProtocolChange()                const
-    { return wipeOnProtocolChange_; }
-  bool                  GetWipeBlueprints()                      const
-    { return wipeBlueprints_; }
-  ParameterMapType      GetMinusParams()                         const
-    { return minusParams_; }
-  ParameterMapType      GetPlusParams()                          const
-    { return plusParams_; }
-
-private:
-
-  // rustLaunchSite settings
-
-  std::filesystem::path installPath_ = {};
-  std::string           installIdentity_ = {};
-  std::filesystem::path pathsCache_ = {};
-  std::filesystem::path pathsDownload_ = {};
-  bool                  processAutoRestart_ = {};
-  int                   processShutdownDelaySeconds_ = {};
-  std::string           rconPassword_ = {};
-  std::string           rconIP_ = {};
-  int                   rconPort_ = {};
-  bool                  rconPassthroughIP_ = {};
-  bool                  rconPassthroughPort_ = {};
-  bool                  rconLog_ = {};
-  SeedStrategy          seedStrategy_ = SeedStrategy::RANDOM;
-  int                   seedFixed_ = {};
-  std::vector<int>      seedList_ = {};
-  bool                  updateServerOnInterval_ = {};
-  bool                  updateServerOnRelaunch_ = {};
-  bool                  updateServerOnStartup_ = {};
-  int                   updateServerRetryDelaySeconds_ = {};
-  bool                  updateModFrameworkOnInterval_ = {};
-  bool                  updateModFrameworkOnRelaunch_ = {};
-  bool                  updateModFrameworkOnServerUpdate_ = {};
-  bool                  updateModFrameworkOnStartup_ = {};
-  int                   updateModFrameworkRetryDelaySeconds_ = {};
-  ModFrameworkType      updateModFrameworkType_ = ModFrameworkType::NONE;
-  int                   updateIntervalMinutes_ = {};
-  bool                  wipeOnProtocolChange_ = {};
-  bool                  wipeBlueprints_ = {};
-
-  // dedicatedServer settings
-
-  ParameterMapType minusParams_ = {};
-  ParameterMapType plusParams_ = {};
-
-  // disabled constructors/operators
-
-  Config() = delete;
-  Config(const Config&) = delete;
-  Config& operator= (const Config&) = delete;
-};
-}
-
-#endif // CONFIG_H
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief rustLaunchSite application configuration facility
+/// @details Abstracts use of config file parser to load config file data into
+///  an instance of this class, which can then be queried for settings. Only
+///  the constructor should throw exceptions.
+class Config
+{
+public:
+
+  enum class ModFrameworkType { NONE, CARBON, OXIDE };
+
+  enum class SeedStrategy { FIXED, LIST, RANDOM };
+
+  enum class SchedulingPolicy { DEFAULT, OTHER, BATCH, IDLE, FIFO, RR };
+
+  enum class IoClass { DEFAULT, REALTIME, BEST_EFFORT, IDLE };
+
+  /// @brief CPU/IO priority settings to be applied to a launched process
+  /// @details Default-constructed values mean "inherit from rustLaunchSite".
+  struct PriorityProfile
+  {
+    std::vector<int>   cpuAffinity_{};
+    std::optional<int> nice_{};
+    SchedulingPolicy   schedulingPolicy_{SchedulingPolicy::DEFAULT};
+    int                schedulingPriority_{0};
+    IoClass            ioClass_{IoClass::DEFAULT};
+    int                ioLevel_{4};
+  };
+
+  /// @brief Environment settings to be applied to a launched process
+  /// @details Variables are applied on top of the environment inherited from
+  ///  rustLaunchSite; variables mapped to an empty optional (JSON @c null) are
+  ///  removed from it, whereas an empty string sets them to an empty value.
+  ///  Preload libraries are prepended to any inherited @c LD_PRELOAD value.
+  struct EnvironmentProfile
+  {
+    std::string                                        name_{};
+    std::map<std::string, std::optional<std::string>> vars_{};
+    std::vector<std::filesystem::path>                 preload_{};
+  };
+
+  /// @brief Linux cgroup v2 resource isolation settings for a process
+  /// @details Zero limit values mean the corresponding setting is left at
+  ///  the kernel default. An empty @c parent_ means the cgroup above the one
+  ///  that rustLaunchSite itself was started in (which must be delegated to
+  ///  it).
+  struct CgroupSettings
+  {
+    bool                  enabled_{false};
+    std::filesystem::path parent_{};
+    std::string           name_{};
+    int                   cpuWeight_{0};
+    int                   cpuMaxPercent_{0};
+    int                   memoryHighMb_{0};
+    int                   memoryMaxMb_{0};
+    int                   ioWeight_{0};
+  };
+
+  /// @brief Countdown announcement interval rule
+  /// @details While more than @c aboveSeconds_ remain, announcements are
+  ///  made at every multiple of @c intervalSeconds_ remaining.
+  struct CountdownMark
+  {
+    int aboveSeconds_{0};
+    int intervalSeconds_{1};
+  };
+
+  /// @brief Thresholds that trigger a proactive server restart
+  /// @details Zero values mean the corresponding check is disabled.
+  struct RestartPolicy
+  {
+    double      minFramerate_{0.0};
+    int         framerateSustainSeconds_{600};
+    int         maxMemoryMb_{0};
+    int         memoryTrendMinutes_{0};
+    int         maxEntityCount_{0};
+    int         minUptimeMinutes_{60};
+  };
+
+  /// @brief Crash loop detection and relaunch backoff settings
+  /// @details A zero @c maxCrashes_ disables crash loop detection, and a zero
+  ///  @c artifactsRetained_ disables crash artifact preservation.
+  struct CrashLoopSettings
+  {
+    int         maxCrashes_{3};
+    int         windowMinutes_{10};
+    int         backoffSeconds_{30};
+    int         maxBackoffSeconds_{1800};
+    bool        validateInstall_{false};
+    bool        rollbackFramework_{false};
+    bool        rollbackInstall_{false};
+    int         artifactsRetained_{10};
+  };
+
+  /// @brief Background map pre-generation settings
+  struct MapPregenSettings
+  {
+    bool        enabled_{false};
+    std::string identity_{"rustLaunchSitePregen"};
+    int         basePort_{28115};
+    int         timeoutMinutes_{60};
+  };
+
+  /// @brief Random seed strategy settings
+  /// @details A zero @c salt_ means one should be generated and cached.
+  struct SeedRandomSettings
+  {
+    std::uint64_t salt_{0};
+  };
+
+  /// @brief Identity directory backup settings
+  /// @details A zero @c intervalMinutes_ disables periodic backups, an empty
+  ///  @c schedule_ (cron expression) disables scheduled backups, a zero
+  ///  @c retain_ keeps all snapshots, and a zero @c threads_ picks a thread
+  ///  count automatically.
+  struct BackupSettings
+  {
+    int         intervalMinutes_{0};
+    std::string schedule_{};
+    int         retain_{24};
+    int         compressionLevel_{3};
+    int         threads_{0};
+    std::filesystem::path repository_{};
+    std::vector<std::string> extraPaths_{};
+  };
+
+  /// @brief Hung server detection settings
+  /// @details A zero @c hangSeconds_ disables hang detection, and a zero
+  ///  @c threadDumpSeconds_ disables thread dumps.
+  struct WatchdogSettings
+  {
+    int         hangSeconds_{600};
+    double      minFramerate_{1.0};
+    int         threadDumpSeconds_{5};
+  };
+
+  struct Parameter
+  {
+    std::optional<bool>        boolValue_;
+    std::optional<double>      doubleValue_;
+    std::optional<int>         intValue_;
+    std::optional<std::string> stringValue_;
+
+    explicit Parameter()                     : boolValue_(false) {}
+    explicit Parameter(const bool b)         : boolValue_(b)     {}
+    explicit Parameter(const double d)       : doubleValue_(d)   {}
+    explicit Parameter(const int i)          : intValue_(i)      {}
+    explicit Parameter(const std::string& s) : stringValue_(s)   {}
+
+    Parameter(const Parameter& rhs) = default;
+
+    Parameter(Parameter&& rhs) noexcept
+      : boolValue_  (std::move(rhs.boolValue_))
+      , doubleValue_(std::move(rhs.doubleValue_))
+      , intValue_   (std::move(rhs.intValue_))
+      , stringValue_(std::move(rhs.stringValue_))
+    {
+    }
+
+    ~Parameter() = default;
+
+    Parameter& operator= (const Parameter& rhs)
+    {
+      if (&rhs == this) return *this;
+      boolValue_   = rhs.boolValue_;
+      doubleValue_ = rhs.doubleValue_;
+      intValue_    = rhs.intValue_;
+      stringValue_ = rhs.stringValue_;
+      return *this;
+    }
+
+    std::string ToString() const
+    {
+      std::stringstream s;
+      if (boolValue_)   { s << *boolValue_;   return s.str(); }
+      if (doubleValue_) { s << *doubleValue_; return s.str(); }
+      if (intValue_)    { s << *intValue_;    return s.str(); }
+      // if (stringValue_) { return std::string("\"") + *stringValue_ + '\"'; }
+      if (stringValue_) { return *stringValue_; }
+      return "<UNKNOWN>";
+    }
+  };
+
+  using ParameterMapType = std::map<std::string, Parameter, std::less<>>;
+
+  using MarkerMapType = std::map<std::string, std::vector<std::string>>;
+
+  /// @brief Primary constructor
+  /// @details Creates an instance that is populated with data from the
+  ///  specified config file.
+  /// @param configFile Configuration file to load
+  /// @throw @c std::invalid_argument on parse or validation failure
+  explicit Config(std::filesystem::path configFile);
+
+  // accessor methods for loaded settings
+
+  std::filesystem::path GetInstallPath()                         const
+    { return installPath_; }
+  std::string           GetInstallIdentity()                     const
+    { return installIdentity_; }
+  std::filesystem::path GetPathsCache()                          const
+    { return pathsCache_; }
+  std::filesystem::path GetPathsDownload()                       const
+    { return pathsDownload_; }
+  std::filesystem::path GetPathsData()                           const
+    { return pathsData_; }
+  BackupSettings        GetBackup()                              const
+    { return backup_; }
+  bool                  GetProcessAutoRestart()                  const
+    { return processAutoRestart_; }
+  std::string           GetProcessRestartSchedule()              const
+    { return processRestartSchedule_; }
+  int                   GetProcessShutdownDelaySeconds()         const
+    { return processShutdownDelaySeconds_; }
+  std::vector<CountdownMark> GetProcessShutdownDelayMarks()      const
+    { return processShutdownDelayMarks_; }
+  int                   GetProcessShutdownSaveTimeoutSeconds()   const
+    { return processShutdownSaveTimeoutSeconds_; }
+  int                   GetProcessShutdownQuitTimeoutSeconds()   const
+    { return processShutdownQuitTimeoutSeconds_; }
+  int                   GetProcessShutdownTerminateTimeoutSeconds() const
+    { return processShutdownTerminateTimeoutSeconds_; }
+  int                   GetProcessOutputBufferLines()            const
+    { return processOutputBufferLines_; }
+  std::vector<std::string> GetProcessStartupReadyMarkers()       const
+    { return processStartupReadyMarkers_; }
+  MarkerMapType         GetProcessStartupPhaseMarkers()          const
+    { return processStartupPhaseMarkers_; }
+  int                   GetProcessLogMonitorPollIntervalMilliseconds() const
+    { return processLogMonitorPollIntervalMilliseconds_; }
+  MarkerMapType         GetProcessLogMonitorPatterns()           const
+    { return processLogMonitorPatterns_; }
+  PriorityProfile       GetProcessPriority()                     const
+    { return processPriority_; }
+  EnvironmentProfile    GetProcessEnvironment()                  const
+    { return processEnvironment_; }
+  CgroupSettings        GetProcessCgroup()                       const
+    { return processCgroup_; }
+  RestartPolicy         GetProcessRestartPolicy()                const
+    { return processRestartPolicy_; }
+  CrashLoopSettings     GetProcessCrashLoop()                    const
+    { return processCrashLoop_; }
+  WatchdogSettings      GetProcessWatchdog()                     const
+    { return processWatchdog_; }
+  int                   GetProcessResourceSamplingIntervalSeconds() const
+    { return processResourceSamplingIntervalSeconds_; }
+  int                   GetProcessResourceSamplingSamples()      const
+    { return processResourceSamplingSamples_; }
+  int                   GetProcessTelemetryIntervalSeconds()     const
+    { return processTelemetryIntervalSeconds_; }
+  int                   GetProcessTelemetryRetentionDays()       const
+    { return processTelemetryRetentionDays_; }
+  std::string           GetRconPassword()                        const
+    { return rconPassword_; }
+  std::string           GetRconIP()                              const
+    { return rconIP_; }
+  int                   GetRconPort()                            const
+    { return rconPort_; }
+  bool                  GetRconPassthroughIP()                   const
+    { return rconPassthroughIP_; }
+  bool                  GetRconPassthroughPort()                 const
+    { return rconPassthroughPort_; }
+  bool                  GetRconLog()                             const
+    { return rconLog_; }
+  SeedStrategy          GetSeedStrategy()                        const
+    { return seedStrategy_; }
+  int                   GetSeedFixed()                           const
+    { return seedFixed_; }
+  std::vector<int>      GetSeedList()                            const
+    { return seedList_; }
+  MapPregenSettings     GetSeedPregenerate()                     const
+    { return seedPregenerate_; }
+  SeedRandomSettings    GetSeedRandom()                          const
+    { return seedRandom_; }
+  bool                  GetUpdateServerOnInterval()              const
+    { return updateServerOnInterval_; }
+  bool                  GetUpdateServerOnRelaunch()              const
+    { return updateServerOnRelaunch_; }
+  bool                  GetUpdateServerOnStartup()               const
+    { return updateServerOnStartup_; }
+  int                   GetUpdateServerRetryDelaySeconds()       const
+    { return updateServerRetryDelaySeconds_; }
+  bool                  GetUpdateModFrameworkOnInterval()        const
+    { return updateModFrameworkOnInterval_; }
+  bool                  GetUpdateModFrameworkOnRelaunch()        const
+    { return updateModFrameworkOnRelaunch_; }
+  bool                  GetUpdateModFrameworkOnServerUpdate()    const
+    { return updateModFrameworkOnServerUpdate_; }
+  bool                  GetUpdateModFrameworkOnStartup()         const
+    { return updateModFrameworkOnStartup_; }
+  int                   GetUpdateModFrameworkRetryDelaySeconds() const
+    { return updateModFrameworkRetryDelaySeconds_; }
+  ModFrameworkType      GetUpdateModFrameworkType()              const
+    { return updateModFrameworkType_; }
+  int                   GetUpdateIntervalMinutes()               const
+    { return updateIntervalMinutes_; }
+  bool                  GetUpdateSnapshot()                      const
+    { return updateSnapshot_; }
+  PriorityProfile       GetUpdatePriority()                      const
+    { return updatePriority_; }
+  bool                  GetWipeOnProtocolChange()                const
+    { return wipeOnProtocolChange_; }
+  bool                  GetWipeBlueprints()                      const
+    { return wipeBlueprints_; }
+  std::string           GetWipeSchedule()                        const
+    { return wipeSchedule_; }
+  ParameterMapType      GetMinusParams()                         const
+    { return minusParams_; }
+  ParameterMapType      GetPlusParams()                          const
+    { return plusParams_; }
+
+private:
+
+  // rustLaunchSite settings
+
+  std::filesystem::path installPath_ = {};
+  std::string           installIdentity_ = {};
+  std::filesystem::path pathsCache_ = {};
+  std::filesystem::path pathsDownload_ = {};
+  std::filesystem::path pathsData_ = {};
+  BackupSettings        backup_ = {};
+  bool                  processAutoRestart_ = {};
+  std::string           processRestartSchedule_ = {};
+  int                   processShutdownDelaySeconds_ = {};
+  std::vector<CountdownMark> processShutdownDelayMarks_ =
+    { { 300, 300 }, { 60, 60 }, { 10, 10 }, { 0, 1 } };
+  int                   processShutdownSaveTimeoutSeconds_ = 120;
+  int                   processShutdownQuitTimeoutSeconds_ = 60;
+  int                   processShutdownTerminateTimeoutSeconds_ = 15;
+  int                   processOutputBufferLines_ = 500;
+  std::vector<std::string> processStartupReadyMarkers_ =
+    { "Server startup complete" };
+  MarkerMapType         processStartupPhaseMarkers_ =
+  {
+    { "assets",  { "Loading Prefab Bundle", "Asset Warmup" } },
+    { "world",   { "Generating procedural map", "Loading save file" } },
+    { "plugins", { "Loading Oxide Core", "Loading Carbon", "Loaded plugin" } }
+  };
+  int                   processLogMonitorPollIntervalMilliseconds_ = 1000;
+  MarkerMapType         processLogMonitorPatterns_ =
+  {
+    { "crash",         { "Crash!!!", "Segmentation fault",
+                         "Received signal SIGSEGV" } },
+    { "exception",     { "Exception: " } },
+    { "nullReference", { "NullReferenceException" } },
+    { "pluginError",   { "Failed to call hook", "Failed to initialize plugin",
+                         "Error while compiling" } }
+  };
+  PriorityProfile       processPriority_ = {};
+  EnvironmentProfile    processEnvironment_ = {};
+  CgroupSettings        processCgroup_ = {};
+  RestartPolicy         processRestartPolicy_ = {};
+  CrashLoopSettings     processCrashLoop_ = {};
+  WatchdogSettings      processWatchdog_ = {};
+  int                   processResourceSamplingIntervalSeconds_ = 10;
+  int                   processResourceSamplingSamples_ = 360;
+  int                   processTelemetryIntervalSeconds_ = 60;
+  int                   processTelemetryRetentionDays_ = 28;
+  std::string           rconPassword_ = {};
+  std::string           rconIP_ = {};
+  int                   rconPort_ = {};
+  bool                  rconPassthroughIP_ = {};
+  bool                  rconPassthroughPort_ = {};
+  bool                  rconLog_ = {};
+  SeedStrategy          seedStrategy_ = SeedStrategy::RANDOM;
+  int                   seedFixed_ = {};
+  std::vector<int>      seedList_ = {};
+  MapPregenSettings     seedPregenerate_ = {};
+  SeedRandomSettings    seedRandom_ = {};
+  bool                  updateServerOnInterval_ = {};
+  bool                  updateServerOnRelaunch_ = {};
+  bool                  updateServerOnStartup_ = {};
+  int                   updateServerRetryDelaySeconds_ = {};
+  bool                  updateModFrameworkOnInterval_ = {};
+  bool                  updateModFrameworkOnRelaunch_ = {};
+  bool                  updateModFrameworkOnServerUpdate_ = {};
+  bool                  updateModFrameworkOnStartup_ = {};
+  int                   updateModFrameworkRetryDelaySeconds_ = {};
+  ModFrameworkType      updateModFrameworkType_ = ModFrameworkType::NONE;
+  int                   updateIntervalMinutes_ = {};
+  bool                  updateSnapshot_ = {};
+  PriorityProfile       updatePriority_ = {};
+  bool                  wipeOnProtocolChange_ = {};
+  bool                  wipeBlueprints_ = {};
+  std::string           wipeSchedule_ = {};
+
+  // dedicatedServer settings
+
+  ParameterMapType minusParams_ = {};
+  ParameterMapType plusParams_ = {};
+
+  // disabled constructors/operators
+
+  Config() = delete;
+  Config(const Config&) = delete;
+  Config& operator= (const Config&) = delete;
+};
+}
+
+#endif // CONFIG_H
@@ -0,0 +1,196 @@
+#include "Countdown.h"
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+namespace
+{
+using Clock = rustLaunchSite::Scheduler::Clock;
+
+// determine time of next announcement, given time remaining until the end of
+//  the countdown
+Clock::time_point GetNextMarkTime(
+  const Clock::time_point endTime,
+  const Clock::duration remaining,
+  const std::vector<rustLaunchSite::Config::CountdownMark>& marks)
+{
+  // use first rule that applies, falling back to last (smallest) one
+  std::chrono::seconds interval(marks.empty() ? 1 : marks.back().intervalSeconds_);
+  for (const auto& mark : marks)
+  {
+    if (remaining > std::chrono::seconds(mark.aboveSeconds_))
+    {
+      interval = std::chrono::seconds(mark.intervalSeconds_);
+      break;
+    }
+  }
+  // next mark is the latest multiple of the interval before the end time that
+  //  is still in the future; subtract a bit from remaining time so that being
+  //  exactly on a mark doesn't result in a repeat announcement
+  const auto marksRemaining(
+    (remaining - std::chrono::milliseconds(1)) / interval);
+  return endTime - interval * std::max<Clock::rep>(marksRemaining, 0);
+}
+}
+
+namespace rustLaunchSite
+{
+struct Countdown::State
+{
+  // scheduler on which to run countdown jobs
+  // jobs only ever run on the scheduler's own thread, so this is always valid
+  //  when used from a job
+  Scheduler* scheduler_{nullptr};
+  // announcement interval rules
+  std::vector<Config::CountdownMark> marks_;
+  // player count query function
+  PlayerCountFunction playerCount_;
+  // announcement function
+  AnnounceFunction announce_;
+  // mutex protecting everything below
+  std::mutex mutex_;
+  // whether a countdown is active
+  bool active_{false};
+  // identifier of current countdown
+  std::uint64_t generation_{0};
+  // identifier of next scheduled step
+  Scheduler::JobId jobId_{0};
+  // countdown start/end times
+  Clock::time_point startTime_{};
+  Clock::time_point endTime_{};
+  // time of next announcement
+  Clock::time_point nextMarkTime_{};
+  // reason included in announcements
+  std::string reason_{};
+  // function to invoke on completion
+  CompletionHandler onComplete_{};
+};
+
+Countdown::Countdown(
+  std::shared_ptr<Scheduler> schedulerSptr,
+  std::vector<Config::CountdownMark> marks,
+  PlayerCountFunction playerCount,
+  AnnounceFunction announce
+)
+  : schedulerSptr_(std::move(schedulerSptr))
+  , stateSptr_(std::make_shared<State>())
+{
+  stateSptr_->scheduler_ = schedulerSptr_.get();
+  stateSptr_->marks_ = std::move(marks);
+  stateSptr_->playerCount_ = std::move(playerCount);
+  stateSptr_->announce_ = std::move(announce);
+}
+
+Countdown::~Countdown()
+{
+  Cancel();
+}
+
+bool Countdown::Start(
+  const std::chrono::seconds duration,
+  const std::string& reason,
+  CompletionHandler onComplete
+)
+{
+  State& state(*stateSptr_);
+  std::scoped_lock lock(state.mutex_);
+  if (state.active_) { return false; }
+  std::cout << "Starting countdown of up to " << duration.count() << " second(s) for reason: " << reason << std::endl;
+  state.active_ = true;
+  const auto generation(++state.generation_);
+  state.startTime_ = Clock::now();
+  state.endTime_ = state.startTime_ + duration;
+  // announce right away
+  state.nextMarkTime_ = state.startTime_;
+  state.reason_ = reason;
+  state.onComplete_ = std::move(onComplete);
+  state.jobId_ = schedulerSptr_->Schedule(
+    state.startTime_,
+    [stateSptr = stateSptr_, generation]() { Step(stateSptr, generation); }
+  );
+  return true;
+}
+
+void Countdown::Cancel()
+{
+  State& state(*stateSptr_);
+  std::scoped_lock lock(state.mutex_);
+  if (!state.active_) { return; }
+  std::cout << "Cancelling countdown for reason: " << state.reason_ << std::endl;
+  state.active_ = false;
+  // invalidate any step that is already running
+  ++state.generation_;
+  schedulerSptr_->Cancel(state.jobId_);
+  state.onComplete_ = {};
+}
+
+bool Countdown::IsActive() const
+{
+  std::scoped_lock lock(stateSptr_->mutex_);
+  return stateSptr_->active_;
+}
+
+void Countdown::Step(
+  const std::shared_ptr<State>& stateSptr, const std::uint64_t generation)
+{
+  State& state(*stateSptr);
+  Clock::time_point endTime;
+  Clock::time_point nextMarkTime;
+  std::string reason;
+  {
+    std::scoped_lock lock(state.mutex_);
+    if (!state.active_ || state.generation_ != generation) { return; }
+    endTime = state.endTime_;
+    nextMarkTime = state.nextMarkTime_;
+    reason = state.reason_;
+  }
+  // don't hold the lock for this, because it may block for a while
+  const std::size_t players(state.playerCount_ ? state.playerCount_() : 0);
+  const auto now(Clock::now());
+  // finish if time is up, or if nobody is around to warn anymore
+  if (!players || now >= endTime)
+  {
+    CompletionHandler onComplete;
+    Clock::time_point startTime;
+    {
+      std::scoped_lock lock(state.mutex_);
+      if (!state.active_ || state.generation_ != generation) { return; }
+      state.active_ = false;
+      onComplete = std::move(state.onComplete_);
+      startTime = state.startTime_;
+    }
+    const bool early(now < endTime);
+    std::cout << "Countdown finished after " << std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count() << " second(s)" << (early ? " due to no players online" : "") << std::endl;
+    if (onComplete) { onComplete(early); }
+    return;
+  }
+  if (now >= nextMarkTime)
+  {
+    const auto remaining(endTime - now);
+    // fudge the count by one second so that it looks nicer
+    const auto remainingSeconds(
+      std::chrono::duration_cast<std::chrono::seconds>(remaining).count() + 1);
+    std::cout << players << " player(s) online; delaying shutdown by up to " << remainingSeconds << " second(s)" << std::endl;
+    std::string message("*** Shutdown in ");
+    message.append(std::to_string(remainingSeconds)).append(" second(s)");
+    if (!reason.empty())
+    {
+      message.append(" for reason: ").append(reason);
+    }
+    if (state.announce_) { state.announce_(message); }
+    nextMarkTime = GetNextMarkTime(endTime, remaining, state.marks_);
+  }
+  // wake up at next mark, but also periodically in between to check whether
+  //  everyone has left
+  const auto nextStepTime(
+    std::min({nextMarkTime, now + PLAYER_POLL_INTERVAL, endTime}));
+  std::scoped_lock lock(state.mutex_);
+  if (!state.active_ || state.generation_ != generation) { return; }
+  state.nextMarkTime_ = nextMarkTime;
+  state.jobId_ = state.scheduler_->Schedule(
+    nextStepTime,
+    [stateSptr, generation]() { Step(stateSptr, generation); }
+  );
+}
+}
@@ -0,0 +1,108 @@
+#ifndef COUNTDOWN_H
+#define COUNTDOWN_H
+
+#include "Config.h"
+#include "Scheduler.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Player-facing countdown facility (e.g. for delaying shutdowns)
+/// @details Runs a countdown as a series of scheduler jobs, so that the
+///  caller's thread remains free while it is in progress. Announcements are
+///  made at configurable marks, and the countdown ends early if no players
+///  are connected. Only one countdown may be active at a time. Should not
+///  throw any exceptions.
+class Countdown
+{
+public:
+
+  /// @brief Function that returns the number of players currently connected,
+  ///  or zero if unknown
+  using PlayerCountFunction = std::function<std::size_t()>;
+
+  /// @brief Function that broadcasts a message to connected players
+  using AnnounceFunction = std::function<void(const std::string&)>;
+
+  /// @brief Function invoked on the scheduler thread when a countdown
+  ///  finishes (but not if it is cancelled)
+  /// @details Parameter is @c true if the countdown ended early because no
+  ///  players were connected, or @c false if it ran to completion.
+  using CompletionHandler = std::function<void(bool)>;
+
+  /// @brief How often the player count is checked between announcements
+  static constexpr std::chrono::seconds PLAYER_POLL_INTERVAL{5};
+
+  /// @brief Primary constructor
+  /// @param schedulerSptr Scheduler on which to run countdown jobs
+  /// @param marks Announcement interval rules, in descending order of
+  ///  @c aboveSeconds_
+  /// @param playerCount Function used to check for connected players
+  /// @param announce Function used to broadcast countdown announcements
+  Countdown(
+    std::shared_ptr<Scheduler> schedulerSptr,
+    std::vector<Config::CountdownMark> marks,
+    PlayerCountFunction playerCount,
+    AnnounceFunction announce
+  );
+
+  /// @brief Destructor
+  /// @details Cancels active countdown, if any.
+  ~Countdown();
+
+  /// @brief Start a countdown
+  /// @details Returns immediately; the first player check and announcement
+  ///  occur right away on the scheduler thread.
+  /// @param duration Maximum countdown duration
+  /// @param reason Reason included in announcements (may be empty)
+  /// @param onComplete Function to invoke when countdown finishes
+  /// @return @c true if started, or @c false if a countdown is already active
+  bool Start(
+    std::chrono::seconds duration,
+    const std::string& reason,
+    CompletionHandler onComplete
+  );
+
+  /// @brief Cancel active countdown, if any
+  /// @details The completion handler will not be invoked. Does not wait for
+  ///  an in-progress check/announcement to finish.
+  void Cancel();
+
+  /// @brief Query whether a countdown is active
+  /// @return @c true if a countdown is in progress, @c false otherwise
+  bool IsActive() const;
+
+private:
+
+  // countdown state
+  // this is shared with scheduled jobs, so that they remain safe to run even
+  //  if this object is destroyed while one is in progress
+  struct State;
+
+  // disabled constructors/operators
+
+  Countdown() = delete;
+  Countdown(const Countdown&) = delete;
+  Countdown& operator= (const Countdown&) = delete;
+
+  // run one step of a countdown: check players, announce if at a mark, and
+  //  either finish or schedule next step
+  // `generation` identifies the countdown, so that steps of a cancelled
+  //  countdown can recognize that they are stale
+  static void Step(
+    const std::shared_ptr<State>& stateSptr, std::uint64_t generation);
+
+  // scheduler on which to run countdown jobs
+  std::shared_ptr<Scheduler> schedulerSptr_;
+  // shared countdown state
+  std::shared_ptr<State> stateSptr_;
+};
+}
+
+#endif // COUNTDOWN_H
@@ -0,0 +1,63 @@
+#include "CrashLoop.h"
+
+#include <algorithm>
+
+namespace rustLaunchSite
+{
+CrashLoop::CrashLoop(const Config::CrashLoopSettings& settings)
+  : settings_(settings)
+{
+}
+
+CrashLoop::Decision CrashLoop::RecordCrash(const Clock::time_point time)
+{
+  Decision decision;
+  if (!IsEnabled()) { return decision; }
+  const std::chrono::minutes window(settings_.windowMinutes_);
+  // a loop ends once the server survives a full window; this is measured from
+  //  the relaunch rather than the previous crash, as otherwise long backoff
+  //  delays would age crashes out of the window and reset the backoff
+  if (looping_ && time - relaunchTime_ >= window)
+  {
+    looping_ = false;
+    backoffCount_ = 0;
+    crashes_.clear();
+  }
+  if (!looping_)
+  {
+    while (!crashes_.empty() && time - crashes_.front() >= window)
+    {
+      crashes_.pop_front();
+    }
+  }
+  crashes_.push_back(time);
+  decision.crashes_ = crashes_.size();
+  if (!looping_ &&
+    crashes_.size() >= static_cast<std::size_t>(settings_.maxCrashes_))
+  {
+    // just detected: take corrective action once per loop
+    looping_ = true;
+    backoffCount_ = 0;
+    decision.validate_ = settings_.validateInstall_;
+    decision.rollback_ = settings_.rollbackFramework_;
+    decision.restore_ = settings_.rollbackInstall_;
+  }
+  decision.looping_ = looping_;
+  if (looping_)
+  {
+    // double delay for each crash since loop was detected, without
+    //  overflowing the shift or the duration
+    const std::chrono::seconds maxDelay(
+      std::max(settings_.maxBackoffSeconds_, settings_.backoffSeconds_));
+    std::chrono::seconds delay(settings_.backoffSeconds_);
+    for (std::size_t i(0); i < backoffCount_ && delay < maxDelay; ++i)
+    {
+      delay *= 2;
+    }
+    decision.delay_ = std::min(delay, maxDelay);
+    ++backoffCount_;
+  }
+  relaunchTime_ = time + decision.delay_;
+  return decision;
+}
+}
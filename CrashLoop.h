@@ -0,0 +1,81 @@
+#ifndef CRASHLOOP_H
+#define CRASHLOOP_H
+
+#include "Config.h"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+
+namespace rustLaunchSite
+{
+/// @brief Crash loop detection and relaunch backoff facility
+/// @details Tracks unexpected server exits, and detects when the server keeps
+///  crashing shortly after being (re)launched - typically due to a broken
+///  plugin, a bad update, or a corrupt installation. Once that happens, each
+///  further relaunch is delayed by an exponentially increasing amount, so that
+///  the server can't burn CPU and download bandwidth in a tight restart loop.
+///  The loop is considered over once the server stays up for a full detection
+///  window. Only makes decisions; acting on them is up to the caller. Should
+///  not throw any exceptions.
+class CrashLoop
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief What to do before relaunching a crashed server
+  struct Decision
+  {
+    /// @brief Number of crashes counted toward the current (or potential)
+    ///  crash loop, including this one
+    std::size_t crashes_{0};
+    /// @brief @c true if a crash loop is in progress
+    bool looping_{false};
+    /// @brief Delay before relaunching the server (zero if not looping)
+    Clock::duration delay_{};
+    /// @brief @c true if server installation should be validated before
+    ///  relaunching (only set when a crash loop is first detected)
+    bool validate_{false};
+    /// @brief @c true if the last modding framework update should be rolled
+    ///  back before relaunching (only set when a crash loop is first detected)
+    bool rollback_{false};
+    /// @brief @c true if the server installation should be restored from the
+    ///  snapshot taken before the last update before relaunching (only set
+    ///  when a crash loop is first detected)
+    bool restore_{false};
+  };
+
+  /// @brief Primary constructor
+  /// @param settings Crash loop detection settings
+  explicit CrashLoop(const Config::CrashLoopSettings& settings);
+
+  /// @brief Query whether crash loop detection is enabled
+  /// @return @c true if a crash threshold is configured
+  bool IsEnabled() const { return settings_.maxCrashes_ > 0; }
+
+  /// @brief Record an unexpected server exit and decide how to proceed
+  /// @param time Time at which the exit was detected
+  /// @return Decision on what to do before relaunching the server
+  Decision RecordCrash(Clock::time_point time = Clock::now());
+
+private:
+
+  // disabled constructors/operators
+
+  CrashLoop() = delete;
+
+  // crash loop detection settings
+  Config::CrashLoopSettings settings_;
+  // times of recent crashes, oldest first
+  std::deque<Clock::time_point> crashes_;
+  // whether a crash loop is in progress
+  bool looping_{false};
+  // number of backoff delays applied since crash loop was detected
+  std::size_t backoffCount_{0};
+  // time at which server was (or will be) relaunched after the last crash
+  Clock::time_point relaunchTime_{};
+};
+}
+
+#endif // CRASHLOOP_H
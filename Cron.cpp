@@ -0,0 +1,189 @@
+#include "Cron.h"
+
+#include <charconv>
+#include <cstdint>
+#include <ctime>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// maximum number of years ahead to search for a matching time
+constexpr int MAX_SEARCH_YEARS{8};
+
+// expand a shorthand expression, or return it unchanged
+std::string ExpandShorthand(const std::string& expression)
+{
+  static const std::pair<std::string_view, std::string_view> SHORTHANDS[]
+  {
+    {"@hourly", "0 * * * *"},
+    {"@daily", "0 0 * * *"},
+    {"@midnight", "0 0 * * *"},
+    {"@weekly", "0 0 * * 0"},
+    {"@monthly", "0 0 1 * *"},
+    {"@yearly", "0 0 1 1 *"},
+    {"@annually", "0 0 1 1 *"}
+  };
+  for (const auto& [shorthand, expansion] : SHORTHANDS)
+  {
+    if (expression == shorthand) { return std::string(expansion); }
+  }
+  return expression;
+}
+
+// parse a whole string as a non-negative integer
+int ParseNumber(const std::string_view text, const std::string& field)
+{
+  int value(-1);
+  const auto [end, ec](
+    std::from_chars(text.data(), text.data() + text.size(), value));
+  if (ec != std::errc() || end != text.data() + text.size() || value < 0)
+  {
+    throw std::invalid_argument(
+      "Invalid number '" + std::string(text) + "' in cron field '" + field +
+      "'");
+  }
+  return value;
+}
+
+// parse a cron field into a bit mask of matching values
+std::uint64_t ParseField(const std::string& field, const int min, const int max)
+{
+  std::uint64_t mask(0);
+  std::string_view rest(field);
+  while (!rest.empty())
+  {
+    const auto comma(rest.find(','));
+    const auto item(rest.substr(0, comma));
+    rest = comma == std::string_view::npos ?
+      std::string_view() : rest.substr(comma + 1);
+    const auto slash(item.find('/'));
+    const auto range(item.substr(0, slash));
+    const int step(slash == std::string_view::npos ?
+      1 : ParseNumber(item.substr(slash + 1), field));
+    int low(min);
+    int high(max);
+    if (range != "*")
+    {
+      const auto dash(range.find('-'));
+      low = ParseNumber(range.substr(0, dash), field);
+      if (dash != std::string_view::npos)
+      {
+        high = ParseNumber(range.substr(dash + 1), field);
+      }
+      // a single value with a step means "from here on"
+      else if (slash == std::string_view::npos)
+      {
+        high = low;
+      }
+    }
+    if (low < min || high > max || low > high || step < 1)
+    {
+      throw std::invalid_argument(
+        "Value out of range in cron field '" + field + "'");
+    }
+    for (int value(low); value <= high; value += step)
+    {
+      mask |= std::uint64_t(1) << value;
+    }
+  }
+  if (!mask)
+  {
+    throw std::invalid_argument("Empty cron field '" + field + "'");
+  }
+  return mask;
+}
+
+// normalize a local time, filling in derived fields
+void Normalize(std::tm& tm)
+{
+  tm.tm_isdst = -1;
+  std::mktime(&tm);
+}
+}
+
+namespace rustLaunchSite
+{
+Cron::Cron(const std::string& expression)
+  : expression_(expression)
+{
+  std::istringstream stream(ExpandShorthand(expression));
+  std::vector<std::string> fields;
+  for (std::string field; stream >> field;) { fields.push_back(field); }
+  if (fields.size() != 5)
+  {
+    throw std::invalid_argument(
+      "Cron expression '" + expression + "' must have 5 fields");
+  }
+  minutes_ = ParseField(fields[0], 0, 59);
+  hours_ = ParseField(fields[1], 0, 23);
+  daysOfMonth_ = ParseField(fields[2], 1, 31);
+  months_ = ParseField(fields[3], 1, 12);
+  auto daysOfWeek(ParseField(fields[4], 0, 7));
+  // 7 is an alias for Sunday
+  if (daysOfWeek & (std::uint64_t(1) << 7)) { daysOfWeek |= 1; }
+  daysOfWeek_ = daysOfWeek & 0x7F;
+  dayOfMonthRestricted_ = fields[2][0] != '*';
+  dayOfWeekRestricted_ = fields[4][0] != '*';
+}
+
+Cron::Clock::time_point Cron::Next(const Clock::time_point after) const
+{
+  const std::time_t t(Clock::to_time_t(
+    std::chrono::floor<std::chrono::seconds>(after)));
+  std::tm tm{};
+#if _MSC_VER
+  localtime_s(&tm, &t);
+#else
+  localtime_r(&t, &tm);
+#endif
+  // start from the next whole minute
+  tm.tm_sec = 0;
+  ++tm.tm_min;
+  Normalize(tm);
+  const int maxYear(tm.tm_year + MAX_SEARCH_YEARS);
+  // advance by the largest unit that doesn't match, until everything does
+  while (tm.tm_year <= maxYear)
+  {
+    if (!months_[static_cast<std::size_t>(tm.tm_mon + 1)])
+    {
+      ++tm.tm_mon;
+      tm.tm_mday = 1;
+      tm.tm_hour = 0;
+      tm.tm_min = 0;
+      Normalize(tm);
+      continue;
+    }
+    const bool dayOfMonth(daysOfMonth_[static_cast<std::size_t>(tm.tm_mday)]);
+    const bool dayOfWeek(daysOfWeek_[static_cast<std::size_t>(tm.tm_wday)]);
+    if (dayOfMonthRestricted_ && dayOfWeekRestricted_ ?
+      !(dayOfMonth || dayOfWeek) : !(dayOfMonth && dayOfWeek))
+    {
+      ++tm.tm_mday;
+      tm.tm_hour = 0;
+      tm.tm_min = 0;
+      Normalize(tm);
+      continue;
+    }
+    if (!hours_[static_cast<std::size_t>(tm.tm_hour)])
+    {
+      ++tm.tm_hour;
+      tm.tm_min = 0;
+      Normalize(tm);
+      continue;
+    }
+    if (!minutes_[static_cast<std::size_t>(tm.tm_min)])
+    {
+      ++tm.tm_min;
+      Normalize(tm);
+      continue;
+    }
+    tm.tm_isdst = -1;
+    return Clock::from_time_t(std::mktime(&tm));
+  }
+  return Clock::time_point::max();
+}
+}
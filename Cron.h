@@ -0,0 +1,63 @@
+#ifndef CRON_H
+#define CRON_H
+
+#include <bitset>
+#include <chrono>
+#include <string>
+
+namespace rustLaunchSite
+{
+/// @brief Cron-style schedule
+/// @details Parses a standard five-field cron expression ("minute hour
+///  day-of-month month day-of-week"), and computes the local times it matches.
+///  Each field may be @c *, a number, a range (@c a-b), or a list of these
+///  separated by commas, and any of these but a number may be followed by a
+///  step (@c /n). Day of week runs from 0 (Sunday) to 6, with 7 also meaning
+///  Sunday. As in traditional cron, if both day of month and day of week are
+///  restricted, a day matching either one matches. The shorthands @c @hourly,
+///  @c @daily (or @c @midnight), @c @weekly, @c @monthly and @c @yearly (or
+///  @c @annually) are also accepted. Only the constructor throws exceptions.
+class Cron
+{
+public:
+
+  using Clock = std::chrono::system_clock;
+
+  /// @brief Primary constructor
+  /// @param expression Cron expression to parse
+  /// @throw @c std::invalid_argument if expression is malformed
+  explicit Cron(const std::string& expression);
+
+  /// @brief Get the cron expression this schedule was parsed from
+  const std::string& GetExpression() const { return expression_; }
+
+  /// @brief Compute the next time matched by the schedule
+  /// @details Times are evaluated in the local time zone. Local times that
+  ///  are skipped by a daylight saving time change don't match.
+  /// @param after Time after which to search
+  /// @return First whole minute after @c after that matches, or
+  ///  @c Clock::time_point::max() if there is none in the next few years
+  ///  (e.g. February 30th)
+  Clock::time_point Next(Clock::time_point after) const;
+
+private:
+
+  // disabled constructors/operators
+
+  Cron() = delete;
+
+  // expression this schedule was parsed from
+  std::string expression_;
+  // set of matching values for each field
+  std::bitset<60> minutes_;
+  std::bitset<24> hours_;
+  std::bitset<32> daysOfMonth_;
+  std::bitset<13> months_;
+  std::bitset<7> daysOfWeek_;
+  // whether day of month/week fields are restricted (i.e. not `*`)
+  bool dayOfMonthRestricted_{false};
+  bool dayOfWeekRestricted_{false};
+};
+}
+
+#endif // CRON_H
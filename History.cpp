@@ -0,0 +1,61 @@
+#include "History.h"
+
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+
+namespace rustLaunchSite
+{
+History::History(std::filesystem::path path)
+  : path_(std::move(path))
+{
+  path_.make_preferred();
+}
+
+bool History::Append(const std::string& record)
+{
+  std::scoped_lock lock(mutex_);
+  if
+  (
+    std::error_code ec{};
+    path_.has_parent_path() &&
+    !std::filesystem::create_directories(path_.parent_path(), ec) && ec
+  )
+  {
+    std::cout << "WARNING: Failed to create history directory " << path_.parent_path() << ": " << ec.message() << std::endl;
+    return false;
+  }
+  std::ofstream file(path_, std::ios::binary | std::ios::app);
+  if (!file.is_open())
+  {
+    std::cout << "WARNING: Failed to open history file " << path_ << " for append" << std::endl;
+    return false;
+  }
+  file << record << '\n';
+  file.close();
+  if (file.fail())
+  {
+    std::cout << "WARNING: Failed to append to history file " << path_ << std::endl;
+    return false;
+  }
+  return true;
+}
+
+std::string History::ToIsoString(
+  const std::chrono::system_clock::time_point& time)
+{
+  const std::time_t t(std::chrono::system_clock::to_time_t(time));
+  std::tm tm{};
+#if _MSC_VER
+  gmtime_s(&tm, &t);
+#else
+  gmtime_r(&t, &tm);
+#endif
+  std::stringstream s;
+  s << std::put_time(&tm, "%FT%TZ");
+  return s.str();
+}
+}
@@ -0,0 +1,58 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+namespace rustLaunchSite
+{
+/// @brief Append-only history file facility
+/// @details Appends one record per line to a file, for tracking measurements
+///  (e.g. startup and save durations) across server launches, updates and
+///  wipes. Records are expected to be single-line JSON objects, so that the
+///  file can be consumed by standard JSON Lines tooling. Should not throw any
+///  exceptions.
+class History
+{
+public:
+
+  /// @brief Primary constructor
+  /// @details Does not touch the file system; the file and its parent
+  ///  directory will be created on first append if needed.
+  /// @param path Path to history file
+  explicit History(std::filesystem::path path);
+
+  /// @brief Append a record to the history file
+  /// @details Safe to call concurrently from multiple threads.
+  /// @param record Record to append; must not contain line breaks
+  /// @return @c true on success, @c false on failure
+  bool Append(const std::string& record);
+
+  /// @brief Get path to history file
+  /// @return History file path
+  std::filesystem::path GetPath() const { return path_; }
+
+  /// @brief Format a wall clock time for use in history records
+  /// @param time Time to format
+  /// @return ISO 8601 UTC time string (e.g. @c 2024-05-22T11:30:14Z)
+  static std::string ToIsoString(
+    const std::chrono::system_clock::time_point& time);
+
+private:
+
+  // disabled constructors/operators
+
+  History() = delete;
+  History(const History&) = delete;
+  History& operator= (const History&) = delete;
+
+  // mutex to serialize appends
+  std::mutex mutex_;
+  // path to history file
+  std::filesystem::path path_;
+};
+}
+
+#endif // HISTORY_H
@@ -0,0 +1,97 @@
+#include "LifecycleWorker.h"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+namespace rustLaunchSite
+{
+LifecycleWorker::LifecycleWorker(std::function<void()> onDone)
+  : onDone_(std::move(onDone))
+{
+}
+
+LifecycleWorker::~LifecycleWorker()
+{
+  Cancel();
+  Finish();
+}
+
+bool LifecycleWorker::Start(const std::string& name, Operation operation)
+{
+  std::scoped_lock lock(mutex_);
+  if (!name_.empty()) { return false; }
+  name_ = name.empty() ? "(unnamed)" : name;
+  tokenSptr_ = std::make_shared<CancellationToken>();
+  outcome_ = Outcome::FAILED;
+  std::cout << "Starting " << name_ << std::endl;
+  thread_ = std::thread(
+    [this, name = name_, tokenSptr = tokenSptr_,
+      operation = std::move(operation)]()
+  {
+    const auto startTime(std::chrono::steady_clock::now());
+    bool success(false);
+    try
+    {
+      success = operation(*tokenSptr);
+    }
+    catch (const std::exception& e)
+    {
+      std::cout << "WARNING: Caught exception from " << name << ": " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      std::cout << "WARNING: Caught unknown exception from " << name << std::endl;
+    }
+    const Outcome outcome(tokenSptr->IsCancelled() ? Outcome::CANCELLED :
+      success ? Outcome::SUCCEEDED : Outcome::FAILED);
+    std::cout << "Finished " << name << " (" << (outcome == Outcome::CANCELLED ? "cancelled" : success ? "succeeded" : "failed") << ") in " << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - startTime).count() << " second(s)" << std::endl;
+    {
+      std::scoped_lock lock(mutex_);
+      outcome_ = outcome;
+    }
+    if (onDone_) { onDone_(); }
+  });
+  return true;
+}
+
+void LifecycleWorker::Cancel()
+{
+  std::shared_ptr<CancellationToken> tokenSptr;
+  {
+    std::scoped_lock lock(mutex_);
+    if (name_.empty() || !tokenSptr_ || tokenSptr_->IsCancelled()) { return; }
+    std::cout << "Cancelling " << name_ << std::endl;
+    tokenSptr = tokenSptr_;
+  }
+  // don't hold the lock while running cancellation callbacks
+  tokenSptr->Cancel();
+}
+
+bool LifecycleWorker::IsBusy() const
+{
+  std::scoped_lock lock(mutex_);
+  return !name_.empty();
+}
+
+std::string LifecycleWorker::GetName() const
+{
+  std::scoped_lock lock(mutex_);
+  return name_;
+}
+
+LifecycleWorker::Outcome LifecycleWorker::Finish()
+{
+  std::thread thread;
+  {
+    std::scoped_lock lock(mutex_);
+    if (name_.empty()) { return Outcome::FAILED; }
+    thread = std::move(thread_);
+  }
+  if (thread.joinable()) { thread.join(); }
+  std::scoped_lock lock(mutex_);
+  name_.clear();
+  tokenSptr_.reset();
+  return outcome_;
+}
+}
@@ -0,0 +1,98 @@
+#ifndef LIFECYCLE_WORKER_H
+#define LIFECYCLE_WORKER_H
+
+#include "CancellationToken.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace rustLaunchSite
+{
+/// @brief Background execution facility for server lifecycle operations
+/// @details Runs one long-running operation at a time (e.g. stopping the
+///  server, installing updates, and starting it again) on a dedicated thread,
+///  so that the thread that requested it stays free to respond to events,
+///  including requests to cancel the operation. Each operation gets its own
+///  cancellation token. A completion callback is invoked on the worker thread
+///  when an operation finishes, after which its outcome must be collected via
+///  @c Finish() before another operation can be started. Should not throw any
+///  exceptions.
+class LifecycleWorker
+{
+public:
+
+  /// @brief Outcome of an operation
+  enum class Outcome
+  {
+    SUCCEEDED, // operation returned true
+    FAILED,    // operation returned false or threw an exception
+    CANCELLED  // operation was cancelled (regardless of what it returned)
+  };
+
+  /// @brief Operation to be run by the worker
+  /// @details Should check the given token regularly, and return as soon as
+  ///  practical once it has been cancelled.
+  using Operation = std::function<bool(const CancellationToken&)>;
+
+  /// @brief Primary constructor
+  /// @param onDone Function to invoke on the worker thread whenever an
+  ///  operation finishes; must not call back into this worker
+  explicit LifecycleWorker(std::function<void()> onDone);
+
+  /// @brief Destructor
+  /// @details Cancels any operation in progress, and blocks until it has
+  ///  returned.
+  ~LifecycleWorker();
+
+  /// @brief Start an operation in the background
+  /// @param name Human-readable name, used for logging
+  /// @param operation Operation to run
+  /// @return @c true if started, or @c false if another operation is in
+  ///  progress or hasn't been collected via @c Finish()
+  bool Start(const std::string& name, Operation operation);
+
+  /// @brief Cancel the operation in progress, if any
+  /// @details Does not wait for the operation to return.
+  void Cancel();
+
+  /// @brief Query whether an operation is in progress or uncollected
+  /// @return @c true if @c Start() would fail
+  bool IsBusy() const;
+
+  /// @brief Get the name of the current operation
+  /// @return Name passed to @c Start(), or empty if idle
+  std::string GetName() const;
+
+  /// @brief Collect the outcome of the current operation
+  /// @details Blocks until the operation has returned, if it hasn't already,
+  ///  and makes the worker idle again.
+  /// @return Outcome of operation, or @c Outcome::FAILED if idle
+  Outcome Finish();
+
+private:
+
+  // disabled constructors/operators
+
+  LifecycleWorker() = delete;
+  LifecycleWorker(const LifecycleWorker&) = delete;
+  LifecycleWorker& operator= (const LifecycleWorker&) = delete;
+
+  // completion callback
+  std::function<void()> onDone_;
+  // mutex protecting everything below
+  mutable std::mutex mutex_;
+  // name of current operation, or empty if idle
+  std::string name_;
+  // cancellation token of current operation
+  std::shared_ptr<CancellationToken> tokenSptr_;
+  // outcome of current operation, once it has returned
+  Outcome outcome_{Outcome::FAILED};
+  // worker thread of current operation
+  std::thread thread_;
+};
+}
+
+#endif // LIFECYCLE_WORKER_H
@@ -0,0 +1,272 @@
+#include "LogTailer.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <system_error>
+#if __linux__
+  #include <cerrno>
+  #include <cstring> // strerror()
+  #include <poll.h>
+  #include <sys/eventfd.h>
+  #include <sys/inotify.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+// size of chunks in which new file content is read
+constexpr std::size_t READ_CHUNK_SIZE{64 * 1024};
+// maximum number of bytes of a line that are retained
+// longer lines are still fully matched if they arrive in one read, but only
+//  this much is kept across reads or recorded as an event's last line
+constexpr std::size_t MAX_LINE_LENGTH{1024};
+
+// append to a partial line, up to the maximum retained line length
+void AppendCapped(std::string& line, const std::string_view text)
+{
+  if (line.size() >= MAX_LINE_LENGTH) { return; }
+  line.append(text.substr(0, MAX_LINE_LENGTH - line.size()));
+}
+}
+
+namespace rustLaunchSite
+{
+LogTailer::LogTailer(
+  const PatternMatcher::PatternMapType& patterns,
+  const std::chrono::milliseconds pollInterval
+)
+  : matcher_(patterns)
+  , pollInterval_(std::max(pollInterval, std::chrono::milliseconds(10)))
+{
+}
+
+LogTailer::~LogTailer()
+{
+  Stop();
+}
+
+void LogTailer::Start(const std::filesystem::path& path)
+{
+  Stop();
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = false;
+    events_.clear();
+  }
+  path_ = path;
+  offset_ = 0;
+  fileId_ = 0;
+  pending_.clear();
+#if __linux__
+  // watch the containing directory rather than the file itself, so that
+  //  creation/replacement of the file is seen too
+  auto directory(path_.parent_path());
+  if (directory.empty()) { directory = "."; }
+  inotifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotifyFd_ >= 0 && ::inotify_add_watch(
+    inotifyFd_, directory.c_str(),
+    IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+      IN_MOVED_TO) < 0)
+  {
+    ::close(inotifyFd_);
+    inotifyFd_ = -1;
+  }
+  if (inotifyFd_ < 0)
+  {
+    std::cout << "WARNING: Failed to watch server log directory `" << directory.string() << "` for changes (" << std::strerror(errno) << "); falling back to polling" << std::endl;
+  }
+  else
+  {
+    wakeFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  }
+#endif
+  thread_ = std::thread(&LogTailer::ThreadFunction, this);
+}
+
+void LogTailer::Stop()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+#if __linux__
+  if (wakeFd_ >= 0)
+  {
+    const std::uint64_t one(1);
+    [[maybe_unused]] const auto result(::write(wakeFd_, &one, sizeof(one)));
+  }
+#endif
+  if (thread_.joinable()) { thread_.join(); }
+#if __linux__
+  if (wakeFd_ >= 0) { ::close(wakeFd_); }
+  if (inotifyFd_ >= 0) { ::close(inotifyFd_); }
+#endif
+  wakeFd_ = -1;
+  inotifyFd_ = -1;
+  file_.close();
+}
+
+LogTailer::EventMapType LogTailer::GetEvents() const
+{
+  std::scoped_lock lock(mutex_);
+  return events_;
+}
+
+void LogTailer::ThreadFunction()
+{
+  ReadNew(true);
+  while (Wait()) { ReadNew(false); }
+  // pick up anything written since the last wakeup, as this is typically
+  //  called after the server exits, and its last words are of most interest
+  ReadNew(false);
+}
+
+void LogTailer::ReadNew(const bool skipExisting)
+{
+  // a failed size query means the file doesn't exist (yet), or was moved
+  //  away/deleted; either way, finish off anything left in the old one
+  std::error_code ec;
+  const auto size(std::filesystem::file_size(path_, ec));
+  std::uintmax_t fileId(0);
+#if __linux__
+  if (struct stat st{}; !ec && ::stat(path_.c_str(), &st) == 0)
+  {
+    fileId = st.st_ino;
+  }
+#endif
+  if (file_.is_open() && (ec || fileId != fileId_))
+  {
+    Drain();
+    file_.close();
+    // the old file's last line is as complete as it's ever going to get
+    if (!pending_.empty()) { ProcessLine(pending_); }
+    pending_.clear();
+  }
+  if (ec) { return; }
+  if (!file_.is_open())
+  {
+    file_.open(path_, std::ios::binary);
+    if (!file_.is_open()) { return; }
+    fileId_ = fileId;
+    offset_ = skipExisting ? size : 0;
+    pending_.clear();
+  }
+  else if (size < offset_)
+  {
+    // truncated; start over from the beginning
+    offset_ = 0;
+    pending_.clear();
+  }
+  // avoid touching the file at all if nothing was appended
+  if (size == offset_) { return; }
+  Drain();
+}
+
+void LogTailer::Drain()
+{
+  // clear EOF state from previous read, or else seeking fails
+  file_.clear();
+  file_.seekg(static_cast<std::streamoff>(offset_));
+  std::array<char, READ_CHUNK_SIZE> buffer;
+  while (file_.read(buffer.data(), buffer.size()) || file_.gcount() > 0)
+  {
+    const auto count(static_cast<std::size_t>(file_.gcount()));
+    offset_ += count;
+    ProcessChunk(std::string_view(buffer.data(), count));
+  }
+}
+
+void LogTailer::ProcessChunk(std::string_view chunk)
+{
+  while (!chunk.empty())
+  {
+    const auto eol(chunk.find('\n'));
+    const auto piece(chunk.substr(0, eol));
+    if (eol == std::string_view::npos)
+    {
+      // incomplete line; hold onto its start until the rest arrives
+      AppendCapped(pending_, piece);
+      return;
+    }
+    chunk.remove_prefix(eol + 1);
+    // match directly from the read buffer in the common case
+    if (pending_.empty())
+    {
+      ProcessLine(piece);
+      continue;
+    }
+    AppendCapped(pending_, piece);
+    ProcessLine(pending_);
+    pending_.clear();
+  }
+}
+
+void LogTailer::ProcessLine(std::string_view line)
+{
+  if (!line.empty() && line.back() == '\r') { line.remove_suffix(1); }
+  ++lineCount_;
+  matcher_.Match(line, matches_);
+  if (matches_.empty()) { return; }
+  const auto now(std::chrono::system_clock::now());
+  std::scoped_lock lock(mutex_);
+  for (const auto category : matches_)
+  {
+    const auto& name(matcher_.GetCategoryName(category));
+    auto& event(events_[name]);
+    // log only the first occurrence of each category, as some (e.g. plugin
+    //  errors) can repeat many times per second
+    if (!event.count_)
+    {
+      std::cout << "WARNING: Server log reported `" << name << "` event: " << line.substr(0, MAX_LINE_LENGTH) << std::endl;
+    }
+    ++event.count_;
+    event.lastTime_ = now;
+    event.lastLine_ = line.substr(0, MAX_LINE_LENGTH);
+  }
+}
+
+bool LogTailer::Wait()
+{
+#if __linux__
+  if (inotifyFd_ >= 0 && wakeFd_ >= 0)
+  {
+    const auto name(path_.filename().string());
+    const auto deadline(std::chrono::steady_clock::now() + pollInterval_);
+    while (true)
+    {
+      const auto remaining(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now()));
+      if (remaining.count() <= 0) { return true; }
+      std::array<pollfd, 2> fds
+        {{{wakeFd_, POLLIN, 0}, {inotifyFd_, POLLIN, 0}}};
+      const int result(::poll(
+        fds.data(), fds.size(), static_cast<int>(remaining.count())));
+      if (result < 0 && errno != EINTR) { return true; }
+      if (fds[0].revents) { return false; }
+      if (!fds[1].revents) { continue; }
+      // drain queued events, and check whether any are for our file
+      bool relevant(false);
+      alignas(inotify_event) std::array<char, 4096> buffer;
+      for (ssize_t length; (length = ::read(
+        inotifyFd_, buffer.data(), buffer.size())) > 0;)
+      {
+        for (ssize_t i(0); i < length;)
+        {
+          const auto* event(
+            reinterpret_cast<const inotify_event*>(buffer.data() + i));
+          relevant = relevant || (event->len && name == event->name);
+          i += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+      }
+      if (relevant) { return true; }
+    }
+  }
+#endif
+  std::unique_lock lock(mutex_);
+  return !cv_.wait_for(lock, pollInterval_, [this]() { return stop_; });
+}
+}
@@ -0,0 +1,156 @@
+#ifndef LOGTAILER_H
+#define LOGTAILER_H
+
+#include "PatternMatcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Incremental server log file tailer and event counter
+/// @details Follows a log file on a dedicated thread, reading only what has
+///  been appended since the last read, and checks each new line against a
+///  compiled set of patterns (see @c PatternMatcher). Lines matching a
+///  pattern category are counted as events of that category. Truncation and
+///  rotation (file replaced by a new one) are detected, and reading resumes
+///  from the start of the new content. On Linux, inotify is used to wake up
+///  as soon as the file changes, with periodic polling as a fallback; other
+///  platforms just poll. Should not throw any exceptions after construction.
+class LogTailer
+{
+public:
+
+  /// @brief Occurrences of a pattern category
+  struct Event
+  {
+    /// @brief Number of lines that matched the category
+    std::size_t count_{0};
+    /// @brief Wall clock time at which the most recent match was read
+    std::chrono::system_clock::time_point lastTime_{};
+    /// @brief Most recent matching line
+    std::string lastLine_{};
+  };
+
+  /// @brief Map of category names to events
+  using EventMapType = std::map<std::string, Event>;
+
+  /// @brief Primary constructor
+  /// @param patterns Map of event category names to case-sensitive
+  ///  substrings that identify lines belonging to them
+  /// @param pollInterval Maximum time between checks for new content
+  LogTailer(
+    const PatternMatcher::PatternMapType& patterns,
+    std::chrono::milliseconds pollInterval
+  );
+
+  /// @brief Destructor
+  /// @details Stops tailing if in progress.
+  ~LogTailer();
+
+  /// @brief Start tailing the given file
+  /// @details Stops any tailing already in progress, and discards all event
+  ///  counts. Content already in the file is skipped, unless the file is
+  ///  subsequently truncated or replaced. The file need not exist yet.
+  /// @param path Log file to tail
+  void Start(const std::filesystem::path& path);
+
+  /// @brief Stop tailing
+  /// @details Event counts are kept, so that they can still be queried after
+  ///  the server has exited. Blocks until the tailing thread exits.
+  void Stop();
+
+  /// @brief Get event counts since tailing was started
+  /// @return Map of category names to events; categories without any
+  ///  matches are omitted
+  EventMapType GetEvents() const;
+
+  /// @brief Get total number of complete lines read
+  /// @details This keeps counting across restarts of tailing, so that callers
+  ///  can detect log activity simply by checking whether it has changed.
+  /// @return Number of lines read since construction
+  std::uint64_t GetLineCount() const { return lineCount_; }
+
+private:
+
+  // disabled constructors/operators
+
+  LogTailer() = delete;
+  LogTailer(const LogTailer&) = delete;
+  LogTailer& operator= (const LogTailer&) = delete;
+
+  // tailing thread entry point
+  void ThreadFunction();
+
+  // check file for truncation/rotation, and then read whatever is new
+  // `skipExisting` indicates that a newly-opened file should be read starting
+  //  from its current end
+  void ReadNew(bool skipExisting);
+
+  // read from current offset to end of currently-open file
+  void Drain();
+
+  // split a chunk of file content into lines, and process complete ones
+  void ProcessChunk(std::string_view chunk);
+
+  // check a complete line for events
+  void ProcessLine(std::string_view line);
+
+  // wait for file change, poll interval, or stop request
+  // returns false if thread should exit
+  bool Wait();
+
+  // event pattern matcher
+  PatternMatcher matcher_;
+  // maximum time between checks for new content
+  std::chrono::milliseconds pollInterval_;
+  // mutex protecting everything below up to the thread-only section
+  mutable std::mutex mutex_;
+  // condition variable used to wake tailing thread early for shutdown
+  // only used on platforms without inotify
+  std::condition_variable cv_;
+  // flag indicating that tailing thread should exit
+  bool stop_{false};
+  // event counts, by category name
+  EventMapType events_;
+  // total number of complete lines read
+  std::atomic<std::uint64_t> lineCount_{0};
+
+  // state only accessed by tailing thread while it's running
+
+  // path of file being tailed
+  std::filesystem::path path_;
+  // currently-open file, if any
+  std::ifstream file_;
+  // offset in file up to which content has been read
+  std::uintmax_t offset_{0};
+  // file identity (inode) of currently-open file, for rotation detection
+  // always zero on platforms where this isn't supported
+  std::uintmax_t fileId_{0};
+  // start of line whose end hasn't been read yet
+  std::string pending_;
+  // reusable buffer for matched category indices
+  std::vector<std::size_t> matches_;
+  // inotify file descriptor, or -1 if not available
+  int inotifyFd_{-1};
+  // eventfd used to wake tailing thread early for shutdown, or -1 if not
+  //  available
+  int wakeFd_{-1};
+
+  // tailing thread
+  std::thread thread_;
+};
+}
+
+#endif // LOGTAILER_H
@@ -0,0 +1,351 @@
+#include "MapPregen.h"
+
+#include "ProcessTuning.h"
+
+#if _MSC_VER
+  // make Boost happy when building with MSVC
+  #include <SDKDDKVer.h>
+#endif
+
+#include <boost/process.hpp>
+#include <boost/process/extend.hpp>
+#if _WIN32
+  #include <boost/process/windows.hpp>
+  #include <boost/winapi/process.hpp>
+#else
+  #include <unistd.h> // setpgid()
+#endif
+#include <condition_variable>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+
+namespace rustLaunchSite
+{
+namespace
+{
+#if _WIN32
+// boost::process extension to set Windows process creation flags
+struct WindowsCreationFlags : boost::process::extend::handler
+{
+  boost::winapi::DWORD_ flags_{0};
+
+  explicit WindowsCreationFlags(const boost::winapi::DWORD_ flags)
+    : flags_(flags)
+  {
+  }
+
+  template <typename Char, typename Sequence>
+  void on_setup(boost::process::extend::windows_executor<Char, Sequence> & ex)
+  {
+    ex.creation_flags |= flags_;
+  }
+};
+#else
+// boost::process extension to launch a process in a new process group, so
+//  that Ctrl+C in a terminal doesn't send SIGINT straight to it
+struct NewProcessGroup : boost::process::extend::handler
+{
+  template<typename Sequence>
+  void on_exec_setup(
+    [[maybe_unused]] boost::process::extend::posix_executor<Sequence>& ex
+  ) const
+  {
+    ::setpgid(0, 0);
+  }
+};
+#endif
+}
+
+struct MapPregen::State
+{
+  // throwaway server's console output
+  boost::process::ipstream output_;
+  // mutex protecting everything below
+  std::mutex mutex_;
+  // condition variable used to wake pre-generation thread
+  std::condition_variable cv_;
+  // whether cancellation was requested
+  bool cancel_{false};
+  // whether a ready marker was seen
+  bool ready_{false};
+  // whether output reached end of file (i.e. server exited)
+  bool exited_{false};
+  // whether pre-generation thread has finished
+  bool finished_{false};
+};
+
+MapPregen::MapPregen(const std::shared_ptr<const Config>& cfgSptr)
+  : enabled_(cfgSptr->GetSeedPregenerate().enabled_)
+  , timeout_(cfgSptr->GetSeedPregenerate().timeoutMinutes_)
+  , priority_(cfgSptr->GetUpdatePriority())
+  , readyMarkers_(cfgSptr->GetProcessStartupReadyMarkers())
+#if _WIN32
+  , rustDedicatedPath_(cfgSptr->GetInstallPath() / "RustDedicated.exe")
+#else
+  , rustDedicatedPath_(cfgSptr->GetInstallPath() / "RustDedicated")
+#endif
+  , installPath_(cfgSptr->GetInstallPath())
+  , liveIdentityPath_(
+      cfgSptr->GetInstallPath() / "server" / cfgSptr->GetInstallIdentity())
+  , pregenIdentityPath_(
+      cfgSptr->GetInstallPath() / "server" /
+      cfgSptr->GetSeedPregenerate().identity_)
+{
+  if (!enabled_) { return; }
+  const auto& settings(cfgSptr->GetSeedPregenerate());
+  if (settings.identity_.empty() ||
+    settings.identity_ == cfgSptr->GetInstallIdentity())
+  {
+    std::cout << "WARNING: Map pre-generation identity must be non-empty and differ from the live server identity; map pre-generation disabled" << std::endl;
+    enabled_ = false;
+    return;
+  }
+  // custom maps aren't generated, and other level types need to be passed on
+  const auto& plusParams(cfgSptr->GetPlusParams());
+  if (plusParams.count("+server.levelurl"))
+  {
+    std::cout << "WARNING: Map pre-generation is not applicable to custom maps; map pre-generation disabled" << std::endl;
+    enabled_ = false;
+    return;
+  }
+  std::string level("Procedural Map");
+  if (const auto it(plusParams.find("+server.level")); it != plusParams.end())
+  {
+    level = it->second.ToString();
+  }
+  // the throwaway server doesn't need RCON or the Rust+ companion server, so
+  //  leave RCON without a password (which disables it) and turn off the app
+  // it also shares the install directory with the live server, so point the
+  //  Oxide and Carbon modding frameworks at (empty) directories under its own
+  //  identity, which keeps them from loading the live plugins and data
+  // finally, give it a recognizable hostname and bind it to loopback only, so
+  //  it can't be reached or listed publicly
+  const auto pregenDataPath("server/" + settings.identity_);
+  arguments_ =
+  {
+    "-batchmode", "-nographics",
+    "-oxide.directory", pregenDataPath + "/oxide",
+    "-carbon.rootdir", pregenDataPath + "/carbon",
+    "+server.identity", settings.identity_,
+    "+server.hostname", "rustLaunchSite map pre-generation (private)",
+    "+server.ip", "127.0.0.1",
+    "+server.level", level,
+    "+server.port", std::to_string(settings.basePort_),
+    "+server.queryport", std::to_string(settings.basePort_ + 1),
+    "+rcon.port", std::to_string(settings.basePort_ + 2),
+    "+app.port", "-1"
+  };
+}
+
+MapPregen::~MapPregen()
+{
+  Cancel();
+}
+
+bool MapPregen::Start(const int seed, const int worldSize)
+{
+  if (!enabled_) { return false; }
+  std::scoped_lock lock(mutex_);
+  if (stateSptr_)
+  {
+    {
+      std::scoped_lock stateLock(stateSptr_->mutex_);
+      if (!stateSptr_->finished_) { return false; }
+    }
+    // reap previous pre-generation
+    thread_.join();
+    stateSptr_.reset();
+  }
+  const std::pair<int, int> request(seed, worldSize);
+  if (attempted_ == request) { return false; }
+  attempted_ = request;
+  if (worldSize <= 0)
+  {
+    std::cout << "WARNING: Map pre-generation requires `+server.worldsize` to be configured; skipping" << std::endl;
+    return false;
+  }
+  if (HasMap(liveIdentityPath_, seed, worldSize)) { return false; }
+  std::cout << "Starting background map pre-generation for seed=" << seed << ", worldSize=" << worldSize << std::endl;
+  stateSptr_ = std::make_shared<State>();
+  thread_ = std::thread(
+    &MapPregen::ThreadFunction, this, stateSptr_, seed, worldSize);
+  return true;
+}
+
+void MapPregen::Cancel()
+{
+  std::shared_ptr<State> stateSptr;
+  std::thread thread;
+  {
+    std::scoped_lock lock(mutex_);
+    stateSptr = std::move(stateSptr_);
+    thread = std::move(thread_);
+  }
+  if (!stateSptr) { return; }
+  bool cancelled(false);
+  {
+    std::scoped_lock stateLock(stateSptr->mutex_);
+    if (!stateSptr->finished_)
+    {
+      std::cout << "Cancelling background map pre-generation" << std::endl;
+      stateSptr->cancel_ = true;
+      stateSptr->cv_.notify_all();
+      cancelled = true;
+    }
+  }
+  thread.join();
+  // allow the cancelled seed and size to be retried
+  if (cancelled)
+  {
+    std::scoped_lock lock(mutex_);
+    attempted_ = {0, 0};
+  }
+}
+
+bool MapPregen::IsRunning() const
+{
+  std::scoped_lock lock(mutex_);
+  if (!stateSptr_) { return false; }
+  std::scoped_lock stateLock(stateSptr_->mutex_);
+  return !stateSptr_->finished_;
+}
+
+bool MapPregen::HasMap(
+  const std::filesystem::path& identityPath, const int seed,
+  const int worldSize)
+{
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it(identityPath, ec), end;
+    !ec && it != end; it.increment(ec))
+  {
+    if (IsMapFor(it->path(), seed, worldSize)) { return true; }
+  }
+  return false;
+}
+
+bool MapPregen::IsMapFor(
+  const std::filesystem::path& path, const int seed, const int worldSize)
+{
+  // map files are named `<level>.<size>.<seed>.<version>.map`, and the
+  //  version isn't known in advance
+  const auto infix("." + std::to_string(worldSize) + "." +
+    std::to_string(seed) + ".");
+  return path.extension() == ".map" &&
+    path.filename().string().find(infix) != std::string::npos;
+}
+
+void MapPregen::ThreadFunction(
+  std::shared_ptr<State> stateSptr, const int seed, const int worldSize)
+{
+  // start from a clean slate, in case a previous run was interrupted
+  std::error_code ec;
+  std::filesystem::remove_all(pregenIdentityPath_, ec);
+  auto arguments(arguments_);
+  arguments.insert(
+    arguments.end(),
+    {
+      "+server.seed", std::to_string(seed),
+      "+server.worldsize", std::to_string(worldSize)
+    });
+  const ProcessTuning tuning(priority_);
+  boost::process::child child(
+    boost::process::exe(rustDedicatedPath_.string()),
+    boost::process::args(arguments),
+    boost::process::start_dir(installPath_.string()),
+    boost::process::std_in < boost::process::null,
+    boost::process::std_out > stateSptr->output_,
+    boost::process::std_err > boost::process::null,
+    boost::process::error(ec),
+#if _WIN32
+    WindowsCreationFlags(
+      // disconnect child process from Ctrl+C signals issued to parent
+      boost::winapi::CREATE_NEW_PROCESS_GROUP_
+    ),
+#else
+    NewProcessGroup(),
+#endif
+    tuning
+  );
+  bool ready(false);
+  if (ec)
+  {
+    std::cout << "WARNING: Failed to launch map pre-generation server: " << ec.message() << std::endl;
+  }
+  else
+  {
+    tuning.Verify(child.id(), "RustDedicated (map pre-generation)");
+    // watch output for a ready marker on a detached thread, as reads can't be
+    //  interrupted
+    std::thread(
+      [stateSptr, markers = readyMarkers_]()
+      {
+        for (std::string line; std::getline(stateSptr->output_, line);)
+        {
+          for (const auto& marker : markers)
+          {
+            if (line.find(marker) == std::string::npos) { continue; }
+            std::scoped_lock lock(stateSptr->mutex_);
+            stateSptr->ready_ = true;
+            stateSptr->cv_.notify_all();
+          }
+        }
+        std::scoped_lock lock(stateSptr->mutex_);
+        stateSptr->exited_ = true;
+        stateSptr->cv_.notify_all();
+      }
+    ).detach();
+    {
+      std::unique_lock lock(stateSptr->mutex_);
+      stateSptr->cv_.wait_for(
+        lock, timeout_,
+        [&stateSptr]()
+        {
+          return stateSptr->cancel_ || stateSptr->ready_ ||
+            stateSptr->exited_;
+        });
+      ready = stateSptr->ready_ && !stateSptr->cancel_;
+      if (!ready && !stateSptr->cancel_)
+      {
+        std::cout << "WARNING: Map pre-generation server " << (stateSptr->exited_ ? "exited" : "timed out") << " before finishing boot" << std::endl;
+      }
+    }
+    // the map has been saved by the time the server is ready, and nothing
+    //  else it did is of any value, so don't bother shutting down gracefully
+    std::error_code killEc;
+    child.terminate(killEc);
+    child.wait(killEc);
+  }
+  if (ready)
+  {
+    // move any map files into the live identity
+    std::vector<std::filesystem::path> maps;
+    for (std::filesystem::directory_iterator it(pregenIdentityPath_, ec), end;
+      !ec && it != end; it.increment(ec))
+    {
+      if (it->path().extension() == ".map") { maps.push_back(it->path()); }
+    }
+    bool moved(false);
+    for (const auto& map : maps)
+    {
+      const auto target(liveIdentityPath_ / map.filename());
+      std::error_code moveEc;
+      std::filesystem::rename(map, target, moveEc);
+      if (moveEc)
+      {
+        std::cout << "WARNING: Failed to move pre-generated map " << map << " to " << target << ": " << moveEc.message() << std::endl;
+        continue;
+      }
+      std::cout << "Pre-generated map saved to " << target << std::endl;
+      moved = true;
+    }
+    if (!moved)
+    {
+      std::cout << "WARNING: Map pre-generation server finished booting, but no map file was found in " << pregenIdentityPath_ << std::endl;
+    }
+  }
+  std::filesystem::remove_all(pregenIdentityPath_, ec);
+  std::scoped_lock lock(stateSptr->mutex_);
+  stateSptr->finished_ = true;
+}
+}
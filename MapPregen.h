@@ -0,0 +1,121 @@
+#ifndef MAPPREGEN_H
+#define MAPPREGEN_H
+
+#include "Config.h"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Background procedural map pre-generation facility
+/// @details Generating a procedural map takes minutes, which is normally
+///  spent on the first boot after a wipe. This facility instead generates the
+///  map for an upcoming seed ahead of time, by launching a throwaway
+///  RustDedicated instance on alternate ports with a temporary identity and
+///  low CPU/IO priority, waiting for it to finish booting, killing it, and
+///  then moving the resulting map file into the live identity directory -
+///  where the live server will find and load it instead of generating it.
+///  Only one pre-generation runs at a time, on a dedicated thread. Should not
+///  throw any exceptions.
+class MapPregen
+{
+public:
+
+  /// @brief Primary constructor
+  /// @param cfgSptr Shared pointer to application configuration instance
+  explicit MapPregen(const std::shared_ptr<const Config>& cfgSptr);
+
+  /// @brief Destructor
+  /// @details Cancels any pre-generation in progress.
+  ~MapPregen();
+
+  /// @brief Query whether pre-generation is enabled and usable
+  /// @return @c true if @c Start() may do anything
+  bool IsEnabled() const { return enabled_; }
+
+  /// @brief Start pre-generating the map for the given seed and size in the
+  ///  background
+  /// @details Does nothing if disabled, if a pre-generation is already in
+  ///  progress, if this seed and size were already attempted since the last
+  ///  @c Cancel(), or if the live identity directory already contains a map
+  ///  for them. This makes it cheap to call repeatedly.
+  /// @param seed Map seed
+  /// @param worldSize Map size
+  /// @return @c true if a pre-generation was started
+  bool Start(int seed, int worldSize);
+
+  /// @brief Cancel any pre-generation in progress
+  /// @details Kills the throwaway server instance, and blocks until the
+  ///  pre-generation thread exits. A cancelled seed and size may be retried.
+  ///  Should be called before the server installation is updated.
+  void Cancel();
+
+  /// @brief Query whether a pre-generation is in progress
+  /// @return @c true if the throwaway server instance is running
+  bool IsRunning() const;
+
+  /// @brief Check whether a file is a map file for the given seed and size
+  /// @param path File path (only the file name is checked)
+  /// @param seed Map seed
+  /// @param worldSize Map size
+  /// @return @c true if file is a matching map file
+  static bool IsMapFor(
+    const std::filesystem::path& path, int seed, int worldSize);
+
+private:
+
+  // state shared with the throwaway server's output reader thread, which is
+  //  detached so that it can't hold up cancellation
+  struct State;
+
+  // disabled constructors/operators
+
+  MapPregen() = delete;
+  MapPregen(const MapPregen&) = delete;
+  MapPregen& operator= (const MapPregen&) = delete;
+
+  // check whether a directory contains a map file for the given seed and size
+  static bool HasMap(
+    const std::filesystem::path& identityPath, int seed, int worldSize);
+
+  // pre-generation thread entry point
+  void ThreadFunction(
+    std::shared_ptr<State> stateSptr, int seed, int worldSize);
+
+  // whether pre-generation is enabled and usable
+  bool enabled_;
+  // maximum time to wait for throwaway server to finish booting
+  std::chrono::minutes timeout_;
+  // priority profile for throwaway server
+  Config::PriorityProfile priority_;
+  // console output markers indicating that the server finished booting
+  std::vector<std::string> readyMarkers_;
+  // launch arguments for throwaway server, minus seed and size
+  std::vector<std::string> arguments_;
+  // path to Rust dedicated server binary
+  std::filesystem::path rustDedicatedPath_;
+  // server installation directory, used as working directory
+  std::filesystem::path installPath_;
+  // live server identity directory, into which maps are moved
+  std::filesystem::path liveIdentityPath_;
+  // throwaway server identity directory, which is deleted afterwards
+  std::filesystem::path pregenIdentityPath_;
+  // mutex protecting everything below
+  mutable std::mutex mutex_;
+  // state of pre-generation in progress, or null if none
+  std::shared_ptr<State> stateSptr_;
+  // seed and size most recently attempted
+  std::pair<int, int> attempted_{0, 0};
+  // pre-generation thread
+  std::thread thread_;
+};
+}
+
+#endif // MAPPREGEN_H
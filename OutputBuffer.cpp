@@ -0,0 +1,149 @@
+#include "OutputBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+
+namespace
+{
+// number of 64-bit words needed to store a line's text
+constexpr std::size_t TEXT_WORDS{
+  (rustLaunchSite::OutputBuffer::MAX_LINE_LENGTH + sizeof(std::uint64_t) - 1)
+    / sizeof(std::uint64_t)
+};
+
+// pack line metadata into a single word: length in the low 16 bits, stderr
+//  flag in bit 16
+inline std::uint64_t PackMeta(const std::size_t length, const bool stdErr)
+{
+  return static_cast<std::uint64_t>(length) | (stdErr ? 0x10000ULL : 0ULL);
+}
+}
+
+namespace rustLaunchSite
+{
+struct OutputBuffer::Slot
+{
+  // seqlock-style state: 2n-1 while line n is being written, 2n once written
+  std::atomic<std::uint64_t> state_{0};
+  // capture time in nanoseconds since system clock epoch
+  std::atomic<std::int64_t> time_{0};
+  // packed length + stderr flag
+  std::atomic<std::uint64_t> meta_{0};
+  // line text, packed 8 bytes per word
+  std::atomic<std::uint64_t> text_[TEXT_WORDS]{};
+};
+
+OutputBuffer::OutputBuffer(const std::size_t capacity)
+  : capacity_(std::max<std::size_t>(capacity, 16))
+  , slots_(std::make_unique<Slot[]>(capacity_))
+{
+}
+
+OutputBuffer::~OutputBuffer() = default;
+
+void OutputBuffer::Push(std::string_view text, const bool stdErr)
+{
+  // claim a sequence number; this is the only point of contention between
+  //  concurrent writers, and it never blocks
+  const std::uint64_t sequence(head_.fetch_add(1, std::memory_order_relaxed) + 1);
+  Slot& slot(slots_[(sequence - 1) % capacity_]);
+  const std::size_t length(std::min(text.size(), MAX_LINE_LENGTH));
+  // mark slot as being written, so that readers know to skip it
+  slot.state_.store(2 * sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.time_.store(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()
+    ).count(),
+    std::memory_order_relaxed
+  );
+  slot.meta_.store(PackMeta(length, stdErr), std::memory_order_relaxed);
+  for (std::size_t i(0); i * sizeof(std::uint64_t) < length; ++i)
+  {
+    std::uint64_t word(0);
+    std::memcpy(
+      &word, text.data() + i * sizeof(std::uint64_t),
+      std::min(sizeof(std::uint64_t), length - i * sizeof(std::uint64_t))
+    );
+    slot.text_[i].store(word, std::memory_order_relaxed);
+  }
+  // publish
+  slot.state_.store(2 * sequence, std::memory_order_release);
+}
+
+std::vector<OutputBuffer::Line> OutputBuffer::Tail(const std::size_t maxLines) const
+{
+  const std::uint64_t last(GetLastSequence());
+  const std::uint64_t count(
+    maxLines ? std::min<std::uint64_t>(maxLines, capacity_) : capacity_
+  );
+  return Since(last > count ? last - count : 0);
+}
+
+std::vector<OutputBuffer::Line> OutputBuffer::Since(std::uint64_t sequence) const
+{
+  std::vector<Line> retVal;
+  const std::uint64_t last(GetLastSequence());
+  // anything older than one buffer length has already been overwritten
+  if (last > capacity_) { sequence = std::max(sequence, last - capacity_); }
+  if (sequence >= last) { return retVal; }
+  retVal.reserve(static_cast<std::size_t>(last - sequence));
+  for (std::uint64_t s(sequence + 1); s <= last; ++s)
+  {
+    Line line;
+    if (Read(s, line)) { retVal.push_back(std::move(line)); }
+  }
+  return retVal;
+}
+
+std::uint64_t OutputBuffer::GetLastSequence() const
+{
+  return head_.load(std::memory_order_acquire);
+}
+
+void OutputBuffer::Dump(std::ostream& os, const std::size_t maxLines) const
+{
+  for (const auto& line : Tail(maxLines))
+  {
+    const std::time_t t(std::chrono::system_clock::to_time_t(line.time_));
+    std::tm tm{};
+#if _MSC_VER
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    os << std::put_time(&tm, "%F %T") << (line.stdErr_ ? " [ERR] " : " [OUT] ")
+       << line.text_ << '\n';
+  }
+  os.flush();
+}
+
+bool OutputBuffer::Read(const std::uint64_t sequence, Line& line) const
+{
+  const Slot& slot(slots_[(sequence - 1) % capacity_]);
+  const std::uint64_t state(slot.state_.load(std::memory_order_acquire));
+  if (state != 2 * sequence) { return false; }
+  const std::int64_t time(slot.time_.load(std::memory_order_relaxed));
+  const std::uint64_t meta(slot.meta_.load(std::memory_order_relaxed));
+  const std::size_t length(
+    std::min<std::size_t>(meta & 0xFFFFULL, MAX_LINE_LENGTH));
+  char text[TEXT_WORDS * sizeof(std::uint64_t)];
+  for (std::size_t i(0); i * sizeof(std::uint64_t) < length; ++i)
+  {
+    const std::uint64_t word(slot.text_[i].load(std::memory_order_relaxed));
+    std::memcpy(text + i * sizeof(std::uint64_t), &word, sizeof(word));
+  }
+  // if a writer got to the slot while we were copying, discard the copy
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.state_.load(std::memory_order_relaxed) != state) { return false; }
+  line.sequence_ = sequence;
+  line.time_ = std::chrono::system_clock::time_point(
+    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+      std::chrono::nanoseconds(time)));
+  line.stdErr_ = (meta & 0x10000ULL) != 0;
+  line.text_.assign(text, length);
+  return true;
+}
+}
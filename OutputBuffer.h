@@ -0,0 +1,103 @@
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Fixed-size ring buffer of timestamped server console output lines
+/// @details Lines are written by pipe reader threads and read by anyone
+///  wanting to tail the server's output. Writers never wait on readers or on
+///  each other, so capturing output can never apply backpressure to the
+///  server process; if the buffer wraps while a reader is copying a line, the
+///  reader simply skips that line. Lines longer than @c MAX_LINE_LENGTH bytes
+///  are truncated. Should not throw any exceptions after construction.
+class OutputBuffer
+{
+public:
+
+  /// @brief Maximum number of bytes stored per line
+  static constexpr std::size_t MAX_LINE_LENGTH{504};
+
+  /// @brief Copy of a single captured line of output
+  struct Line
+  {
+    /// @brief Monotonically increasing line number (first line is 1)
+    std::uint64_t sequence_{0};
+    /// @brief Wall clock time at which the line was captured
+    std::chrono::system_clock::time_point time_{};
+    /// @brief @c true if line was read from stderr, @c false if stdout
+    bool stdErr_{false};
+    /// @brief Line contents, without line ending
+    std::string text_{};
+  };
+
+  /// @brief Primary constructor
+  /// @param capacity Maximum number of lines to retain (minimum 16)
+  explicit OutputBuffer(std::size_t capacity);
+
+  /// @brief Destructor
+  ~OutputBuffer();
+
+  /// @brief Append a line to the buffer, overwriting the oldest if full
+  /// @details Safe to call concurrently from multiple threads. Lock-free.
+  /// @param text Line contents (line ending should already be stripped)
+  /// @param stdErr @c true if line came from stderr, @c false if stdout
+  void Push(std::string_view text, bool stdErr);
+
+  /// @brief Get up to the given number of most recent lines
+  /// @param maxLines Maximum number of lines to return, or zero for all
+  /// @return Lines in capture order (oldest first)
+  std::vector<Line> Tail(std::size_t maxLines = 0) const;
+
+  /// @brief Get all retained lines newer than the given sequence number
+  /// @details Intended for incremental tailing: pass the @c sequence_ of the
+  ///  last line previously received (or zero to get everything).
+  /// @param sequence Sequence number of last line already seen
+  /// @return Lines in capture order (oldest first)
+  std::vector<Line> Since(std::uint64_t sequence) const;
+
+  /// @brief Get sequence number of the most recently pushed line
+  /// @return Sequence number, or zero if nothing has been pushed yet
+  std::uint64_t GetLastSequence() const;
+
+  /// @brief Write the most recent lines to a stream in a human-readable
+  ///  format, one per line
+  /// @param os Output stream
+  /// @param maxLines Maximum number of lines to write, or zero for all
+  void Dump(std::ostream& os, std::size_t maxLines = 0) const;
+
+private:
+
+  // storage for one line
+  // every field is atomic so that a reader racing a writer gets garbage it
+  //  can detect (via the sequence field), instead of undefined behavior
+  struct Slot;
+
+  // attempt to copy the line with the given sequence number out of its slot
+  // returns false if the slot has since been reused or is being written
+  bool Read(std::uint64_t sequence, Line& line) const;
+
+  // disabled constructors/operators
+
+  OutputBuffer() = delete;
+  OutputBuffer(const OutputBuffer&) = delete;
+  OutputBuffer& operator= (const OutputBuffer&) = delete;
+
+  // number of slots
+  std::size_t capacity_;
+  // next sequence number to be claimed by a writer, minus one
+  std::atomic<std::uint64_t> head_{0};
+  // slot storage
+  std::unique_ptr<Slot[]> slots_;
+};
+}
+
+#endif // OUTPUTBUFFER_H
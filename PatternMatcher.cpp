@@ -0,0 +1,134 @@
+#include "PatternMatcher.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace
+{
+// transition table entry used during construction for "no edge yet"
+constexpr std::uint32_t NO_STATE{0xFFFFFFFF};
+}
+
+namespace rustLaunchSite
+{
+PatternMatcher::PatternMatcher(const PatternMapType& patterns)
+{
+  // assign symbol classes to bytes that appear in patterns
+  for (const auto& [category, list] : patterns)
+  {
+    for (const auto& pattern : list)
+    {
+      for (const auto c : pattern)
+      {
+        auto& symbol(classes_[static_cast<unsigned char>(c)]);
+        if (!symbol) { symbol = static_cast<std::uint16_t>(classCount_++); }
+      }
+    }
+  }
+  // build trie, recording which categories end at each state
+  std::vector<std::vector<std::uint32_t>> stateOutputs(1);
+  transitions_.assign(classCount_, NO_STATE);
+  for (const auto& [category, list] : patterns)
+  {
+    const auto categoryIndex(static_cast<std::uint32_t>(categories_.size()));
+    bool used(false);
+    for (const auto& pattern : list)
+    {
+      if (pattern.empty()) { continue; }
+      used = true;
+      std::uint32_t state(0);
+      for (const auto c : pattern)
+      {
+        auto& next(transitions_[
+          state * classCount_ + classes_[static_cast<unsigned char>(c)]]);
+        if (next == NO_STATE)
+        {
+          next = static_cast<std::uint32_t>(stateOutputs.size());
+          stateOutputs.emplace_back();
+          transitions_.resize(transitions_.size() + classCount_, NO_STATE);
+        }
+        // `next` may have been invalidated by the resize above
+        state = transitions_[
+          state * classCount_ + classes_[static_cast<unsigned char>(c)]];
+      }
+      auto& outputs(stateOutputs[state]);
+      if (std::find(outputs.begin(), outputs.end(), categoryIndex) ==
+        outputs.end())
+      {
+        outputs.push_back(categoryIndex);
+      }
+    }
+    if (used) { categories_.push_back(category); }
+  }
+  // breadth-first pass to compute failure links, fold them into the
+  //  transition table, and merge outputs of each state's failure state
+  std::vector<std::uint32_t> failure(stateOutputs.size(), 0);
+  std::queue<std::uint32_t> queue;
+  for (std::size_t symbol(0); symbol < classCount_; ++symbol)
+  {
+    auto& next(transitions_[symbol]);
+    if (next == NO_STATE) { next = 0; }
+    else { queue.push(next); }
+  }
+  while (!queue.empty())
+  {
+    const auto state(queue.front());
+    queue.pop();
+    // failure state is shallower, and so has already been completed
+    for (const auto category : stateOutputs[failure[state]])
+    {
+      auto& outputs(stateOutputs[state]);
+      if (std::find(outputs.begin(), outputs.end(), category) ==
+        outputs.end())
+      {
+        outputs.push_back(category);
+      }
+    }
+    for (std::size_t symbol(0); symbol < classCount_; ++symbol)
+    {
+      auto& next(transitions_[state * classCount_ + symbol]);
+      const auto fallback(transitions_[failure[state] * classCount_ + symbol]);
+      if (next == NO_STATE)
+      {
+        next = fallback;
+        continue;
+      }
+      failure[next] = fallback;
+      queue.push(next);
+    }
+  }
+  // flatten outputs
+  outputRanges_.reserve(stateOutputs.size());
+  for (const auto& outputs : stateOutputs)
+  {
+    const auto begin(static_cast<std::uint32_t>(outputs_.size()));
+    outputs_.insert(outputs_.end(), outputs.begin(), outputs.end());
+    outputRanges_.emplace_back(
+      begin, static_cast<std::uint32_t>(outputs_.size()));
+  }
+}
+
+void PatternMatcher::Match(
+  const std::string_view text, std::vector<std::size_t>& matches) const
+{
+  matches.clear();
+  if (categories_.empty()) { return; }
+  std::uint32_t state(0);
+  for (const auto c : text)
+  {
+    state = transitions_[
+      state * classCount_ + classes_[static_cast<unsigned char>(c)]];
+    const auto [begin, end](outputRanges_[state]);
+    for (auto i(begin); i < end; ++i)
+    {
+      if (std::find(matches.begin(), matches.end(), outputs_[i]) ==
+        matches.end())
+      {
+        matches.push_back(outputs_[i]);
+      }
+    }
+    // can't find anything new once every category has matched
+    if (matches.size() == categories_.size()) { return; }
+  }
+}
+}
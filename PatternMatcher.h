@@ -0,0 +1,74 @@
+#ifndef PATTERNMATCHER_H
+#define PATTERNMATCHER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Compiled multi-pattern substring matcher
+/// @details Compiles a set of literal substrings, each belonging to a named
+///  category, into an Aho-Corasick automaton, so that text can be checked for
+///  all patterns in a single pass over its bytes regardless of how many
+///  patterns there are. Matching is case-sensitive. Immutable after
+///  construction, and therefore safe to share across threads. Should not
+///  throw any exceptions after construction.
+class PatternMatcher
+{
+public:
+
+  /// @brief Map of category names to literal substrings belonging to them
+  using PatternMapType = std::map<std::string, std::vector<std::string>>;
+
+  /// @brief Primary constructor
+  /// @details Empty patterns and categories are ignored.
+  /// @param patterns Patterns to compile
+  explicit PatternMatcher(const PatternMapType& patterns);
+
+  /// @brief Get number of categories
+  /// @return Number of categories with at least one non-empty pattern
+  std::size_t GetCategoryCount() const { return categories_.size(); }
+
+  /// @brief Get name of a category
+  /// @param category Category index, less than @c GetCategoryCount()
+  /// @return Category name
+  const std::string& GetCategoryName(std::size_t category) const
+    { return categories_[category]; }
+
+  /// @brief Find which categories have at least one pattern in the text
+  /// @param text Text to search
+  /// @param matches Receives indices of matching categories, each at most
+  ///  once, in order of first match; any existing contents are cleared
+  void Match(std::string_view text, std::vector<std::size_t>& matches) const;
+
+private:
+
+  // disabled constructors/operators
+
+  PatternMatcher() = delete;
+
+  // category names, indexed by category index
+  std::vector<std::string> categories_;
+  // map of byte values to symbol classes; bytes that don't appear in any
+  //  pattern map to class zero, which keeps the transition table small
+  std::array<std::uint16_t, 256> classes_{};
+  // number of symbol classes, including class zero
+  std::size_t classCount_{1};
+  // complete state transition table, indexed by
+  //  `state * classCount_ + class`
+  // failure links are folded in, so matching never has to backtrack
+  std::vector<std::uint32_t> transitions_;
+  // per-state range of indices into `outputs_`, as [begin, end) pairs
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> outputRanges_;
+  // categories matched upon entering each state, including via failure links
+  std::vector<std::uint32_t> outputs_;
+};
+}
+
+#endif // PATTERNMATCHER_H
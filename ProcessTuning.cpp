@@ -0,0 +1,234 @@
+#include "ProcessTuning.h"
+
+#include <iostream>
+
+#if _WIN32
+  #include <boost/winapi/priority_class.hpp>
+  #include <boost/winapi/process.hpp>
+  #include <cstdint>
+  #include <windows.h>
+#elif __linux__
+  #include <cerrno>
+  #include <sched.h>
+  #include <sys/resource.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+#if __linux__
+// Linux IO priority constants (from linux/ioprio.h, which glibc doesn't wrap)
+constexpr int IOPRIO_CLASS_SHIFT{13};
+constexpr int IOPRIO_WHO_PROCESS{1};
+
+int ToNative(const rustLaunchSite::Config::SchedulingPolicy policy)
+{
+  switch (policy)
+  {
+    case rustLaunchSite::Config::SchedulingPolicy::DEFAULT: return SCHED_OTHER;
+    case rustLaunchSite::Config::SchedulingPolicy::OTHER:   return SCHED_OTHER;
+    case rustLaunchSite::Config::SchedulingPolicy::BATCH:   return SCHED_BATCH;
+    case rustLaunchSite::Config::SchedulingPolicy::IDLE:    return SCHED_IDLE;
+    case rustLaunchSite::Config::SchedulingPolicy::FIFO:    return SCHED_FIFO;
+    case rustLaunchSite::Config::SchedulingPolicy::RR:      return SCHED_RR;
+  }
+  return SCHED_OTHER;
+}
+
+int ToNative(const rustLaunchSite::Config::IoClass ioClass, const int ioLevel)
+{
+  int nativeClass(0);
+  switch (ioClass)
+  {
+    case rustLaunchSite::Config::IoClass::DEFAULT:     nativeClass = 0; break;
+    case rustLaunchSite::Config::IoClass::REALTIME:    nativeClass = 1; break;
+    case rustLaunchSite::Config::IoClass::BEST_EFFORT: nativeClass = 2; break;
+    case rustLaunchSite::Config::IoClass::IDLE:        nativeClass = 3; break;
+  }
+  // idle class has no levels
+  return (nativeClass << IOPRIO_CLASS_SHIFT) | (nativeClass == 3 ? 0 : ioLevel);
+}
+
+// populate a CPU set from a list of CPU indices
+// this is used in a forked child, so it must not allocate
+void ToNative(const std::vector<int>& cpus, cpu_set_t& cpuSet) noexcept
+{
+  CPU_ZERO(&cpuSet);
+  for (const int cpu : cpus)
+  {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) { CPU_SET(cpu, &cpuSet); }
+  }
+}
+#endif
+}
+
+namespace rustLaunchSite
+{
+ProcessTuning::ProcessTuning(const Config::PriorityProfile& profile)
+  : profile_(profile)
+{
+}
+
+#if _WIN32
+unsigned long ProcessTuning::GetCreationFlags() const
+{
+  unsigned long flags(0);
+  // Windows only has priority classes, so map nice value (if any) or
+  //  scheduling policy to the closest one
+  if (profile_.nice_)
+  {
+    const int nice(*profile_.nice_);
+    flags =
+      nice <= -15 ? boost::winapi::HIGH_PRIORITY_CLASS_ :
+      nice <    0 ? boost::winapi::ABOVE_NORMAL_PRIORITY_CLASS_ :
+      nice ==   0 ? boost::winapi::NORMAL_PRIORITY_CLASS_ :
+      nice <   15 ? boost::winapi::BELOW_NORMAL_PRIORITY_CLASS_ :
+                    boost::winapi::IDLE_PRIORITY_CLASS_;
+  }
+  else
+  {
+    switch (profile_.schedulingPolicy_)
+    {
+      case Config::SchedulingPolicy::DEFAULT:
+      case Config::SchedulingPolicy::OTHER:
+        break;
+      case Config::SchedulingPolicy::BATCH:
+        flags = boost::winapi::BELOW_NORMAL_PRIORITY_CLASS_;
+        break;
+      case Config::SchedulingPolicy::IDLE:
+        flags = boost::winapi::IDLE_PRIORITY_CLASS_;
+        break;
+      // don't use realtime class, as it can starve the OS itself
+      case Config::SchedulingPolicy::FIFO:
+      case Config::SchedulingPolicy::RR:
+        flags = boost::winapi::HIGH_PRIORITY_CLASS_;
+        break;
+    }
+  }
+  // launch suspended so that affinity can be set before anything runs
+  if (!profile_.cpuAffinity_.empty())
+  {
+    flags |= boost::winapi::CREATE_SUSPENDED_;
+  }
+  return flags;
+}
+
+void ProcessTuning::ApplyAffinity(void* processHandle, void* threadHandle) const
+{
+  if (profile_.cpuAffinity_.empty()) { return; }
+  std::uint64_t mask(0);
+  for (const int cpu : profile_.cpuAffinity_)
+  {
+    if (cpu >= 0 && cpu < 64) { mask |= (std::uint64_t{1} << cpu); }
+  }
+  if (!::SetProcessAffinityMask(
+    static_cast<HANDLE>(processHandle), static_cast<DWORD_PTR>(mask)))
+  {
+    std::cout << "WARNING: Failed to set process CPU affinity mask: " << ::GetLastError() << std::endl;
+  }
+  // always resume, since we launched the process suspended
+  if (::ResumeThread(static_cast<HANDLE>(threadHandle)) == static_cast<DWORD>(-1))
+  {
+    std::cout << "ERROR: Failed to resume suspended process: " << ::GetLastError() << std::endl;
+  }
+}
+
+void ProcessTuning::Verify(
+  [[maybe_unused]] const int pid, const std::string_view processName) const
+{
+  // priority class and affinity failures are logged at launch, so just warn
+  //  about unsupported settings here
+  if (profile_.ioClass_ != Config::IoClass::DEFAULT)
+  {
+    std::cout << "WARNING: IO priority settings are not supported on Windows; not applied to " << processName << std::endl;
+  }
+}
+#else
+void ProcessTuning::ApplyToSelf() const noexcept
+{
+#if __linux__
+  // errors are ignored here, as there's no safe way to report them from a
+  //  forked child; Verify() reports them from the parent instead
+  if (profile_.schedulingPolicy_ != Config::SchedulingPolicy::DEFAULT)
+  {
+    sched_param param{};
+    param.sched_priority = profile_.schedulingPriority_;
+    ::sched_setscheduler(0, ToNative(profile_.schedulingPolicy_), &param);
+  }
+  if (profile_.nice_)
+  {
+    ::setpriority(PRIO_PROCESS, 0, *profile_.nice_);
+  }
+  if (!profile_.cpuAffinity_.empty())
+  {
+    cpu_set_t cpuSet;
+    ToNative(profile_.cpuAffinity_, cpuSet);
+    ::sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+  }
+  if (profile_.ioClass_ != Config::IoClass::DEFAULT)
+  {
+    ::syscall(
+      SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+      ToNative(profile_.ioClass_, profile_.ioLevel_)
+    );
+  }
+#endif
+}
+
+void ProcessTuning::Verify(
+  [[maybe_unused]] const int pid, const std::string_view processName) const
+{
+#if __linux__
+  if (
+    profile_.schedulingPolicy_ != Config::SchedulingPolicy::DEFAULT &&
+    ::sched_getscheduler(pid) != ToNative(profile_.schedulingPolicy_)
+  )
+  {
+    std::cout << "WARNING: Failed to set scheduling policy of " << processName << " (pid=" << pid << "); missing privileges?" << std::endl;
+  }
+  if (profile_.nice_)
+  {
+    // getpriority() can legitimately return -1, so check errno instead
+    errno = 0;
+    const int nice(::getpriority(PRIO_PROCESS, static_cast<id_t>(pid)));
+    if (errno == 0 && nice != *profile_.nice_)
+    {
+      std::cout << "WARNING: Failed to set nice value of " << processName << " (pid=" << pid << ") to " << *profile_.nice_ << "; actual value is " << nice << " - missing privileges?" << std::endl;
+    }
+  }
+  if (!profile_.cpuAffinity_.empty())
+  {
+    cpu_set_t expected;
+    ToNative(profile_.cpuAffinity_, expected);
+    cpu_set_t actual;
+    CPU_ZERO(&actual);
+    if (
+      ::sched_getaffinity(pid, sizeof(actual), &actual) == 0 &&
+      !CPU_EQUAL(&expected, &actual)
+    )
+    {
+      std::cout << "WARNING: Failed to set CPU affinity of " << processName << " (pid=" << pid << "); check that the configured CPUs exist and are allowed" << std::endl;
+    }
+  }
+  if (
+    profile_.ioClass_ != Config::IoClass::DEFAULT &&
+    ::syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, pid) !=
+      ToNative(profile_.ioClass_, profile_.ioLevel_)
+  )
+  {
+    std::cout << "WARNING: Failed to set IO priority of " << processName << " (pid=" << pid << "); missing privileges?" << std::endl;
+  }
+#else
+  if (
+    profile_.nice_ || !profile_.cpuAffinity_.empty() ||
+    profile_.schedulingPolicy_ != Config::SchedulingPolicy::DEFAULT ||
+    profile_.ioClass_ != Config::IoClass::DEFAULT
+  )
+  {
+    std::cout << "WARNING: Process priority settings are not supported on this platform; not applied to " << processName << std::endl;
+  }
+#endif
+}
+#endif
+}
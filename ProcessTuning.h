@@ -0,0 +1,86 @@
+#ifndef PROCESSTUNING_H
+#define PROCESSTUNING_H
+
+#include "Config.h"
+
+#if _MSC_VER
+  // make Boost happy when building with MSVC
+  #include <SDKDDKVer.h>
+#endif
+
+#include <boost/process/extend.hpp>
+#include <string_view>
+
+namespace rustLaunchSite
+{
+/// @brief @c boost::process launch extension that applies a CPU/IO priority
+///  profile to a child process
+/// @details Pass an instance as an argument when launching a process via
+///  @c boost::process. On Linux, settings are applied in the child between
+///  @c fork() and @c exec(), so that every thread the process ever creates
+///  inherits them; failures cannot be reported from there, so @c Verify()
+///  should be called after launch to log any settings that didn't take. On
+///  Windows, scheduling settings are mapped to a priority class, CPU
+///  affinity is applied while the process is still suspended, and IO
+///  priority settings are not supported. This is an internal header that
+///  should only be included from translation units that launch processes.
+class ProcessTuning : public boost::process::extend::handler
+{
+public:
+
+  /// @brief Primary constructor
+  /// @param profile Priority profile to apply
+  explicit ProcessTuning(const Config::PriorityProfile& profile);
+
+#if _WIN32
+  template<typename Char, typename Sequence>
+  void on_setup(
+    boost::process::extend::windows_executor<Char, Sequence>& ex) const
+  {
+    ex.creation_flags |= GetCreationFlags();
+  }
+
+  template<typename Char, typename Sequence>
+  void on_success(
+    boost::process::extend::windows_executor<Char, Sequence>& ex) const
+  {
+    ApplyAffinity(ex.proc_info.hProcess, ex.proc_info.hThread);
+  }
+#else
+  template<typename Sequence>
+  void on_exec_setup(
+    [[maybe_unused]] boost::process::extend::posix_executor<Sequence>& ex
+  ) const
+  {
+    ApplyToSelf();
+  }
+#endif
+
+  /// @brief Check whether the profile took effect on a launched process,
+  ///  logging a warning for each setting that did not
+  /// @param pid Process ID of launched process
+  /// @param processName Human-readable process name for log messages
+  void Verify(int pid, std::string_view processName) const;
+
+private:
+
+#if _WIN32
+  // get process creation flags for configured priority class, plus
+  //  CREATE_SUSPENDED if affinity needs to be set before the process runs
+  unsigned long GetCreationFlags() const;
+
+  // set affinity on a suspended process, then resume its main thread
+  void ApplyAffinity(void* processHandle, void* threadHandle) const;
+#else
+  // apply profile to the calling process
+  // this runs in a forked child, so it must stick to async-signal-safe calls
+  //  and must not allocate memory
+  void ApplyToSelf() const noexcept;
+#endif
+
+  // profile to be applied
+  Config::PriorityProfile profile_;
+};
+}
+
+#endif // PROCESSTUNING_H
@@ -0,0 +1,97 @@
+#include "Reflink.h"
+
+#include <algorithm>
+#include <system_error>
+
+#if __linux__
+  #include <fcntl.h>
+  #include <linux/fs.h>
+  #include <sys/ioctl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace rustLaunchSite
+{
+bool Reflink::CloneFile(
+  [[maybe_unused]] const std::filesystem::path& source,
+  [[maybe_unused]] const std::filesystem::path& destination)
+{
+#if __linux__ && defined(FICLONE)
+  const int in(::open(source.c_str(), O_RDONLY | O_CLOEXEC));
+  if (in < 0) { return false; }
+  struct stat st{};
+  if (::fstat(in, &st))
+  {
+    ::close(in);
+    return false;
+  }
+  const int out(::open(
+    destination.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+    st.st_mode & 07777));
+  if (out < 0)
+  {
+    ::close(in);
+    return false;
+  }
+  bool success(!::ioctl(out, FICLONE, in));
+  if (success)
+  {
+    const struct timespec times[2]{st.st_atim, st.st_mtim};
+    ::futimens(out, times);
+  }
+  success = !::close(out) && success;
+  ::close(in);
+  if (!success) { ::unlink(destination.c_str()); }
+  return success;
+#else
+  return false;
+#endif
+}
+
+bool Reflink::CloneTree(
+  const std::filesystem::path& source,
+  const std::filesystem::path& destination,
+  const std::vector<std::filesystem::path>& exclude)
+{
+  std::error_code ec;
+  if (std::filesystem::exists(destination, ec) ||
+    !std::filesystem::create_directory(destination, source, ec))
+  {
+    return false;
+  }
+  bool success(true);
+  for (std::filesystem::recursive_directory_iterator it(source, ec), end;
+    success && !ec && it != end; it.increment(ec))
+  {
+    const auto relative(it->path().lexically_relative(source));
+    if (std::find(exclude.begin(), exclude.end(), relative) != exclude.end())
+    {
+      it.disable_recursion_pending();
+      continue;
+    }
+    const auto target(destination / relative);
+    const auto status(it->symlink_status(ec));
+    if (ec) { break; }
+    if (std::filesystem::is_symlink(status))
+    {
+      std::filesystem::copy_symlink(it->path(), target, ec);
+      success = !ec;
+    }
+    else if (std::filesystem::is_directory(status))
+    {
+      success = std::filesystem::create_directory(target, it->path(), ec);
+    }
+    else if (std::filesystem::is_regular_file(status))
+    {
+      success = CloneFile(it->path(), target);
+    }
+  }
+  if (!success || ec)
+  {
+    std::filesystem::remove_all(destination, ec);
+    return false;
+  }
+  return true;
+}
+}
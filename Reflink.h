@@ -0,0 +1,55 @@
+#ifndef REFLINK_H
+#define REFLINK_H
+
+#include <filesystem>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Copy-on-write file cloning facility
+/// @details Clones files via reflinks (Linux @c FICLONE, supported by btrfs
+///  and XFS among others), where the clone shares its data blocks with the
+///  original until either is modified. Cloning therefore only costs metadata
+///  updates, regardless of file size, which makes point-in-time copies of
+///  multi-GB directories practically instant. No data is ever copied: if the
+///  filesystem doesn't support reflinks, or source and destination are on
+///  different filesystems, cloning fails, and it is up to the caller to fall
+///  back to something else. Always fails on other platforms. Should not throw
+///  any exceptions.
+class Reflink
+{
+public:
+
+  /// @brief Clone a file
+  /// @details Permissions and modification time are preserved.
+  /// @param source File to clone
+  /// @param destination Path of clone, which must not exist
+  /// @return @c true on success, @c false on failure (in which case nothing
+  ///  is left at @c destination)
+  static bool CloneFile(
+    const std::filesystem::path& source,
+    const std::filesystem::path& destination);
+
+  /// @brief Clone a directory tree
+  /// @details Directories are recreated, regular files are cloned, and
+  ///  symbolic links are copied as-is; anything else is skipped.
+  /// @param source Directory to clone
+  /// @param destination Path of clone, which must not exist
+  /// @param exclude Paths relative to @c source to leave out, along with
+  ///  everything under them
+  /// @return @c true on success, @c false on failure (in which case nothing
+  ///  is left at @c destination)
+  static bool CloneTree(
+    const std::filesystem::path& source,
+    const std::filesystem::path& destination,
+    const std::vector<std::filesystem::path>& exclude = {});
+
+private:
+
+  // disabled constructors/operators
+
+  Reflink() = delete;
+};
+}
+
+#endif // REFLINK_H
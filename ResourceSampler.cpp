@@ -0,0 +1,230 @@
+#include "ResourceSampler.h"
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#if __linux__
+  #include <filesystem>
+  #include <fstream>
+  #include <sstream>
+  #include <string>
+  #include <system_error>
+  #include <unistd.h> // sysconf()
+#endif
+
+namespace
+{
+#if __linux__
+// read the value of a `Key: value` line from a /proc file
+// returns false if the file or key could not be read
+bool ReadProcValue(
+  const std::filesystem::path& path, const std::string& key, std::uint64_t& value)
+{
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.compare(0, key.size(), key) != 0) { continue; }
+    std::istringstream(line.substr(key.size())) >> value;
+    return true;
+  }
+  return false;
+}
+
+// take a sample of the given process's resource usage
+// `cpuTicks` receives the total user+system CPU time consumed so far, in clock
+//  ticks, which the caller needs in order to compute CPU usage
+// returns false if the process no longer exists or has exited
+bool ReadSample(
+  const int pid,
+  rustLaunchSite::ResourceSampler::Sample& sample,
+  std::uint64_t& cpuTicks)
+{
+  const std::filesystem::path procPath(
+    std::filesystem::path("/proc") / std::to_string(pid));
+  // stat: "pid (comm) state ppid ..." - comm may contain spaces/parentheses,
+  //  so start parsing after the last closing parenthesis
+  std::string stat;
+  if (!std::getline(std::ifstream(procPath / "stat"), stat)) { return false; }
+  const auto commEnd(stat.rfind(')'));
+  if (commEnd == std::string::npos) { return false; }
+  std::istringstream statStream(stat.substr(commEnd + 1));
+  // fields are numbered from 1 in proc(5), and parsing starts at field 3
+  std::vector<std::string> fields;
+  for (std::string field; statStream >> field;) { fields.push_back(field); }
+  // need at least up to field 20 (num_threads)
+  if (fields.size() < 18) { return false; }
+  // don't sample zombies; the process has exited, but not yet been reaped
+  if (fields[0] == "Z" || fields[0] == "X") { return false; }
+  cpuTicks = std::stoull(fields[14 - 3]) + std::stoull(fields[15 - 3]);
+  sample.threads_ = static_cast<std::uint32_t>(std::stoul(fields[20 - 3]));
+  // status: prefer VmRSS, which is in kB
+  if (std::uint64_t rssKb(0); ReadProcValue(procPath / "status", "VmRSS:", rssKb))
+  {
+    sample.rssBytes_ = rssKb * 1024;
+  }
+  // io: may be unreadable depending on ptrace access mode, so tolerate that
+  ReadProcValue(procPath / "io", "read_bytes:", sample.readBytes_);
+  ReadProcValue(procPath / "io", "write_bytes:", sample.writeBytes_);
+  // fd: one entry per open descriptor
+  std::error_code ec;
+  for (
+    std::filesystem::directory_iterator it(procPath / "fd", ec), end;
+    !ec && it != end;
+    it.increment(ec)
+  )
+  {
+    ++sample.openFds_;
+  }
+  return true;
+}
+#endif
+}
+
+namespace rustLaunchSite
+{
+ResourceSampler::ResourceSampler(
+  const std::chrono::seconds interval, const std::size_t capacity)
+  : interval_(std::max(interval, std::chrono::seconds(1)))
+  , capacity_(std::max<std::size_t>(capacity, 1))
+{
+  samples_.reserve(capacity_);
+}
+
+ResourceSampler::~ResourceSampler()
+{
+  Stop();
+}
+
+void ResourceSampler::Start([[maybe_unused]] const int pid)
+{
+  Stop();
+#if __linux__
+  std::scoped_lock lock(mutex_);
+  samples_.clear();
+  oldest_ = 0;
+  stop_ = false;
+  thread_ = std::thread(&ResourceSampler::ThreadFunction, this, pid);
+#else
+  std::cout << "WARNING: Process resource sampling is not supported on this platform" << std::endl;
+#endif
+}
+
+void ResourceSampler::Stop()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) { thread_.join(); }
+}
+
+std::vector<ResourceSampler::Sample> ResourceSampler::GetSamples(
+  const std::size_t maxSamples) const
+{
+  std::scoped_lock lock(mutex_);
+  const std::size_t count(
+    maxSamples ? std::min(maxSamples, samples_.size()) : samples_.size());
+  std::vector<Sample> retVal;
+  retVal.reserve(count);
+  for (std::size_t i(samples_.size() - count); i < samples_.size(); ++i)
+  {
+    retVal.push_back(samples_[(oldest_ + i) % samples_.size()]);
+  }
+  return retVal;
+}
+
+void ResourceSampler::Dump(std::ostream& os, const std::size_t maxSamples) const
+{
+  // don't leave the caller's stream with our number formatting
+  const auto flags(os.flags());
+  const auto precision(os.precision());
+  for (const auto& sample : GetSamples(maxSamples))
+  {
+    const std::time_t t(std::chrono::system_clock::to_time_t(sample.time_));
+    std::tm tm{};
+#if _MSC_VER
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    os << std::put_time(&tm, "%F %T")
+       << " cpu=" << std::fixed << std::setprecision(1) << sample.cpuPercent_
+       << "% rss=" << (sample.rssBytes_ >> 20)
+       << "MiB threads=" << sample.threads_
+       << " fds=" << sample.openFds_
+       << " read=" << (sample.readBytes_ >> 20)
+       << "MiB written=" << (sample.writeBytes_ >> 20) << "MiB\n";
+  }
+  os.flags(flags);
+  os.precision(precision);
+  os.flush();
+}
+
+void ResourceSampler::ThreadFunction([[maybe_unused]] const int pid)
+{
+#if __linux__
+  const double ticksPerSecond(static_cast<double>(::sysconf(_SC_CLK_TCK)));
+  std::uint64_t lastCpuTicks(0);
+  auto lastTime(std::chrono::steady_clock::now());
+  bool first(true);
+  std::unique_lock lock(mutex_);
+  while (!stop_)
+  {
+    // don't hold the lock while reading /proc
+    lock.unlock();
+    Sample sample;
+    std::uint64_t cpuTicks(0);
+    bool valid(false);
+    bool malformed(false);
+    try
+    {
+      valid = ReadSample(pid, sample, cpuTicks);
+    }
+    catch (const std::exception& e)
+    {
+      std::cout << "WARNING: Failed to parse resource usage of process " << pid << "; skipping sample: " << e.what() << std::endl;
+      malformed = true;
+    }
+    const auto now(std::chrono::steady_clock::now());
+    sample.time_ = std::chrono::system_clock::now();
+    lock.lock();
+    // a garbled read only costs this sample, as the next one may be fine
+    if (malformed)
+    {
+      cv_.wait_for(lock, interval_, [this]{ return stop_; });
+      continue;
+    }
+    // process is gone, so there's nothing more to sample
+    if (!valid) { break; }
+    // CPU usage can only be computed relative to a previous sample
+    if (!first)
+    {
+      const double elapsed(
+        std::chrono::duration<double>(now - lastTime).count());
+      if (elapsed > 0)
+      {
+        sample.cpuPercent_ =
+          100.0 * static_cast<double>(cpuTicks - lastCpuTicks)
+          / ticksPerSecond / elapsed;
+      }
+    }
+    first = false;
+    lastCpuTicks = cpuTicks;
+    lastTime = now;
+    if (samples_.size() < capacity_)
+    {
+      samples_.push_back(sample);
+    }
+    else
+    {
+      samples_[oldest_] = sample;
+      oldest_ = (oldest_ + 1) % capacity_;
+    }
+    cv_.wait_for(lock, interval_, [this]{ return stop_; });
+  }
+#endif
+}
+}
@@ -0,0 +1,107 @@
+#ifndef RESOURCESAMPLER_H
+#define RESOURCESAMPLER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Periodic resource usage sampler for a child process
+/// @details Samples CPU usage, memory, thread count, open file descriptors and
+///  disk I/O of a process on a dedicated thread, and retains a fixed number of
+///  the most recent samples in memory, so that resource growth leading up to a
+///  crash can be inspected without running a separate monitoring agent.
+///  Currently only implemented for Linux (via @c /proc); on other platforms,
+///  starting the sampler logs a warning and does nothing. Should not throw any
+///  exceptions after construction.
+class ResourceSampler
+{
+public:
+
+  /// @brief Resource usage of a process at a point in time
+  struct Sample
+  {
+    /// @brief Wall clock time at which the sample was taken
+    std::chrono::system_clock::time_point time_{};
+    /// @brief CPU usage since previous sample, as a percentage of one core
+    ///  (can exceed 100 for multithreaded processes)
+    double cpuPercent_{0.0};
+    /// @brief Resident set size in bytes
+    std::uint64_t rssBytes_{0};
+    /// @brief Number of threads
+    std::uint32_t threads_{0};
+    /// @brief Number of open file descriptors
+    std::uint32_t openFds_{0};
+    /// @brief Cumulative bytes read from storage
+    std::uint64_t readBytes_{0};
+    /// @brief Cumulative bytes written to storage
+    std::uint64_t writeBytes_{0};
+  };
+
+  /// @brief Primary constructor
+  /// @param interval Time between samples (minimum one second)
+  /// @param capacity Maximum number of samples to retain (minimum 1)
+  ResourceSampler(std::chrono::seconds interval, std::size_t capacity);
+
+  /// @brief Destructor
+  /// @details Stops sampling if in progress.
+  ~ResourceSampler();
+
+  /// @brief Start sampling the given process
+  /// @details Stops any sampling already in progress, and discards all
+  ///  retained samples. Sampling stops on its own once the process exits.
+  /// @param pid Process ID to sample
+  void Start(int pid);
+
+  /// @brief Stop sampling
+  /// @details Retained samples are kept, so that they can still be queried
+  ///  after the process has exited. Blocks until the sampling thread exits.
+  void Stop();
+
+  /// @brief Get up to the given number of most recent samples
+  /// @param maxSamples Maximum number of samples to return, or zero for all
+  /// @return Samples in order taken (oldest first)
+  std::vector<Sample> GetSamples(std::size_t maxSamples = 0) const;
+
+  /// @brief Write the most recent samples to a stream in a human-readable
+  ///  format, one per line
+  /// @param os Output stream
+  /// @param maxSamples Maximum number of samples to write, or zero for all
+  void Dump(std::ostream& os, std::size_t maxSamples = 0) const;
+
+private:
+
+  // disabled constructors/operators
+
+  ResourceSampler() = delete;
+  ResourceSampler(const ResourceSampler&) = delete;
+  ResourceSampler& operator= (const ResourceSampler&) = delete;
+
+  // sampling thread entry point
+  void ThreadFunction(int pid);
+
+  // time between samples
+  std::chrono::seconds interval_;
+  // maximum number of samples to retain
+  std::size_t capacity_;
+  // mutex protecting everything below
+  mutable std::mutex mutex_;
+  // condition variable used to wake sampling thread early for shutdown
+  std::condition_variable cv_;
+  // flag indicating that sampling thread should exit
+  bool stop_{false};
+  // sample storage, used as a ring once full
+  std::vector<Sample> samples_;
+  // index of oldest sample in ring, once full
+  std::size_t oldest_{0};
+  // sampling thread
+  std::thread thread_;
+};
+}
+
+#endif // RESOURCESAMPLER_H
@@ -0,0 +1,144 @@
+#include "RestartPolicy.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+// minimum number of observations needed to fit a memory trend line
+constexpr std::size_t MIN_TREND_OBSERVATIONS{3};
+}
+
+namespace rustLaunchSite
+{
+RestartPolicy::RestartPolicy(const Config::RestartPolicy& settings)
+  : settings_(settings)
+{
+}
+
+bool RestartPolicy::IsEnabled() const
+{
+  return (
+    (settings_.minFramerate_ > 0 && settings_.framerateSustainSeconds_ > 0)
+    || settings_.maxMemoryMb_ > 0
+    || settings_.maxEntityCount_ > 0
+  );
+}
+
+void RestartPolicy::Reset()
+{
+  observations_.clear();
+}
+
+std::string RestartPolicy::Evaluate(const Observation& observation)
+{
+  if (!IsEnabled()) { return {}; }
+  observations_.push_back(observation);
+  // discard observations that are too old to be needed by any check
+  const auto retention(std::max<Clock::duration>(
+    std::chrono::seconds(settings_.framerateSustainSeconds_),
+    std::chrono::minutes(settings_.memoryTrendMinutes_)));
+  while (!observations_.empty() &&
+    observation.time_ - observations_.front().time_ > retention)
+  {
+    observations_.pop_front();
+  }
+  // don't restart a server that has only just come up, even if it's in bad
+  //  shape, as another restart probably won't help
+  if (observation.uptimeSeconds_ <
+    static_cast<std::size_t>(settings_.minUptimeMinutes_) * 60)
+  {
+    return {};
+  }
+  if (auto reason(CheckFramerate()); !reason.empty()) { return reason; }
+  if (auto reason(CheckMemory()); !reason.empty()) { return reason; }
+  if (settings_.maxEntityCount_ > 0 && observation.entityCount_ >=
+    static_cast<std::size_t>(settings_.maxEntityCount_))
+  {
+    std::stringstream s;
+    s << "Entity count " << observation.entityCount_ << " reached limit of "
+      << settings_.maxEntityCount_;
+    return s.str();
+  }
+  return {};
+}
+
+std::string RestartPolicy::CheckFramerate() const
+{
+  if (settings_.minFramerate_ <= 0 || settings_.framerateSustainSeconds_ <= 0)
+  {
+    return {};
+  }
+  const std::chrono::seconds window(settings_.framerateSustainSeconds_);
+  const auto& latest(observations_.back());
+  // need observations covering the whole window, all of which are below the
+  //  threshold, in order to consider low framerate sustained
+  if (latest.time_ - observations_.front().time_ < window) { return {}; }
+  double peak(0.0);
+  for (auto it(observations_.rbegin()); it != observations_.rend(); ++it)
+  {
+    if (latest.time_ - it->time_ > window) { break; }
+    if (it->framerate_ >= settings_.minFramerate_) { return {}; }
+    peak = std::max(peak, it->framerate_);
+  }
+  std::stringstream s;
+  s << "Framerate below " << settings_.minFramerate_ << " for "
+    << settings_.framerateSustainSeconds_ << " second(s) (peak " << peak
+    << ')';
+  return s.str();
+}
+
+std::string RestartPolicy::CheckMemory() const
+{
+  if (settings_.maxMemoryMb_ <= 0) { return {}; }
+  const auto& latest(observations_.back());
+  if (latest.memoryMb_ >= static_cast<std::size_t>(settings_.maxMemoryMb_))
+  {
+    std::stringstream s;
+    s << "Memory usage " << latest.memoryMb_ << "MB reached limit of "
+      << settings_.maxMemoryMb_ << "MB";
+    return s.str();
+  }
+  if (settings_.memoryTrendMinutes_ <= 0) { return {}; }
+  const std::chrono::minutes window(settings_.memoryTrendMinutes_);
+  // require at least half a window of history before trusting the trend
+  if (observations_.size() < MIN_TREND_OBSERVATIONS ||
+    latest.time_ - observations_.front().time_ < window / 2)
+  {
+    return {};
+  }
+  // least-squares fit of memory usage (MB) over time (minutes)
+  double sumT(0.0);
+  double sumM(0.0);
+  double sumTT(0.0);
+  double sumTM(0.0);
+  for (const auto& o : observations_)
+  {
+    const double t(
+      std::chrono::duration<double, std::ratio<60>>(o.time_ - latest.time_)
+        .count());
+    const auto m(static_cast<double>(o.memoryMb_));
+    sumT += t;
+    sumM += m;
+    sumTT += t * t;
+    sumTM += t * m;
+  }
+  const auto n(static_cast<double>(observations_.size()));
+  const double denominator(n * sumTT - sumT * sumT);
+  if (denominator <= 0) { return {}; }
+  const double slope((n * sumTM - sumT * sumM) / denominator);
+  if (slope <= 0) { return {}; }
+  // project from the fitted line rather than the latest value, so that a
+  //  single spike doesn't trigger a restart
+  const double intercept((sumM - slope * sumT) / n);
+  const double projected(
+    intercept + slope * static_cast<double>(settings_.memoryTrendMinutes_));
+  if (projected < static_cast<double>(settings_.maxMemoryMb_)) { return {}; }
+  std::stringstream s;
+  s << "Memory usage " << latest.memoryMb_ << "MB growing at "
+    << static_cast<long long>(slope * 60)
+    << "MB/hour; projected to reach limit of " << settings_.maxMemoryMb_
+    << "MB within " << settings_.memoryTrendMinutes_ << " minute(s)";
+  return s.str();
+}
+}
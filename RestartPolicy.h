@@ -0,0 +1,78 @@
+#ifndef RESTARTPOLICY_H
+#define RESTARTPOLICY_H
+
+#include "Config.h"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <string>
+
+namespace rustLaunchSite
+{
+/// @brief Proactive server restart policy facility
+/// @details Tracks server performance metrics over time, and decides when the
+///  server has degraded enough (e.g. sustained low framerate, or memory usage
+///  at or trending toward a limit) that it should be restarted before players
+///  notice lag or the server runs out of memory. Only makes decisions; acting
+///  on them is up to the caller. Should not throw any exceptions.
+class RestartPolicy
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Server performance metrics at a point in time
+  struct Observation
+  {
+    /// @brief Time at which metrics were collected
+    Clock::time_point time_{};
+    /// @brief Server framerate
+    double framerate_{0.0};
+    /// @brief Server process memory usage in MB
+    std::size_t memoryMb_{0};
+    /// @brief Number of entities in the world
+    std::size_t entityCount_{0};
+    /// @brief Number of seconds since server finished booting
+    std::size_t uptimeSeconds_{0};
+  };
+
+  /// @brief Primary constructor
+  /// @param settings Restart thresholds
+  explicit RestartPolicy(const Config::RestartPolicy& settings);
+
+  /// @brief Query whether any restart checks are enabled
+  /// @return @c true if at least one threshold is configured
+  bool IsEnabled() const;
+
+  /// @brief Discard all tracked metrics
+  /// @details Should be called whenever the server is (re)started.
+  void Reset();
+
+  /// @brief Record an observation and check whether a restart is warranted
+  /// @param observation Current server metrics
+  /// @return Human-readable reason for restarting, or empty if no restart is
+  ///  needed
+  std::string Evaluate(const Observation& observation);
+
+private:
+
+  // disabled constructors/operators
+
+  RestartPolicy() = delete;
+
+  // check for sustained low framerate; returns reason or empty
+  std::string CheckFramerate() const;
+
+  // check memory usage against limit, including projected usage based on
+  //  recent trend; returns reason or empty
+  std::string CheckMemory() const;
+
+  // restart thresholds
+  Config::RestartPolicy settings_;
+  // recent observations, oldest first
+  std::deque<Observation> observations_;
+};
+}
+
+#endif // RESTARTPOLICY_H
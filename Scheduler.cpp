@@ -0,0 +1,215 @@
+#include "Scheduler.h"
+
+#include <exception>
+#include <iostream>
+
+namespace
+{
+using Clock = rustLaunchSite::Scheduler::Clock;
+
+// convert a wall clock time to a scheduler clock time
+Clock::time_point ToSchedulerTime(
+  const rustLaunchSite::Cron::Clock::time_point time)
+{
+  if (time == rustLaunchSite::Cron::Clock::time_point::max())
+  {
+    return Clock::time_point::max();
+  }
+  return Clock::now() + std::chrono::duration_cast<Clock::duration>(
+    time - rustLaunchSite::Cron::Clock::now());
+}
+}
+
+namespace rustLaunchSite
+{
+Scheduler::Scheduler()
+  : thread_(&Scheduler::ThreadFunction, this)
+{
+}
+
+Scheduler::~Scheduler()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) { thread_.join(); }
+}
+
+Scheduler::JobId Scheduler::Schedule(const Clock::time_point time, Job job)
+{
+  Task task;
+  task.job_ = std::make_shared<Job>(std::move(job));
+  task.time_ = time;
+  return Add(std::move(task));
+}
+
+Scheduler::JobId Scheduler::ScheduleEvery(
+  const Clock::duration interval, Job job)
+{
+  Task task;
+  task.job_ = std::make_shared<Job>(std::move(job));
+  task.interval_ = interval;
+  task.time_ = Clock::now() + interval;
+  return Add(std::move(task));
+}
+
+Scheduler::JobId Scheduler::ScheduleCron(const Cron& cron, Job job)
+{
+  Task task;
+  task.job_ = std::make_shared<Job>(std::move(job));
+  task.cron_ = cron;
+  task.cronTime_ = cron.Next(Cron::Clock::now());
+  task.time_ = ToSchedulerTime(task.cronTime_);
+  return Add(std::move(task));
+}
+
+bool Scheduler::Cancel(const JobId id)
+{
+  std::scoped_lock lock(mutex_);
+  return tasks_.erase(id) > 0;
+}
+
+bool Scheduler::Pause(const JobId id)
+{
+  std::scoped_lock lock(mutex_);
+  const auto it(tasks_.find(id));
+  if (it == tasks_.end()) { return false; }
+  it->second.paused_ = true;
+  return true;
+}
+
+bool Scheduler::Resume(const JobId id)
+{
+  {
+    std::scoped_lock lock(mutex_);
+    const auto it(tasks_.find(id));
+    if (it == tasks_.end()) { return false; }
+    Task& task(it->second);
+    if (!task.paused_) { return true; }
+    task.paused_ = false;
+    if (task.cron_ || task.interval_ != Clock::duration::zero())
+    {
+      Requeue(id, task, true);
+    }
+    else
+    {
+      queue_.push({task.time_, id, ++task.generation_});
+    }
+  }
+  cv_.notify_all();
+  return true;
+}
+
+Scheduler::JobId Scheduler::Add(Task task)
+{
+  JobId id(0);
+  {
+    std::scoped_lock lock(mutex_);
+    id = ++lastId_;
+    if (task.time_ != Clock::time_point::max())
+    {
+      queue_.push({task.time_, id, task.generation_});
+    }
+    tasks_.emplace(id, std::move(task));
+  }
+  // wake scheduler thread in case this job is due before whatever it's
+  //  currently waiting on
+  cv_.notify_all();
+  return id;
+}
+
+void Scheduler::Requeue(const JobId id, Task& task, const bool restart)
+{
+  const auto now(Clock::now());
+  if (task.cron_)
+  {
+    task.cronTime_ = task.cron_->Next(Cron::Clock::now());
+    task.time_ = ToSchedulerTime(task.cronTime_);
+  }
+  else if (restart)
+  {
+    task.time_ = now + task.interval_;
+  }
+  else
+  {
+    // skip any runs that were missed
+    task.time_ += task.interval_;
+    if (task.time_ <= now)
+    {
+      task.time_ += task.interval_ * ((now - task.time_) / task.interval_ + 1);
+    }
+  }
+  ++task.generation_;
+  if (task.time_ != Clock::time_point::max())
+  {
+    queue_.push({task.time_, id, task.generation_});
+  }
+}
+
+void Scheduler::ThreadFunction()
+{
+  std::unique_lock lock(mutex_);
+  while (!stop_)
+  {
+    if (queue_.empty())
+    {
+      cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      continue;
+    }
+    // sleep until earliest job is due, or until woken to reevaluate
+    if (const auto time(queue_.top().time_); Clock::now() < time)
+    {
+      cv_.wait_until(lock, time);
+      continue;
+    }
+    const Entry entry(queue_.top());
+    queue_.pop();
+    // skip entries of cancelled, paused and rescheduled jobs
+    const auto it(tasks_.find(entry.id_));
+    if (it == tasks_.end() || it->second.paused_ ||
+      it->second.generation_ != entry.generation_)
+    {
+      continue;
+    }
+    Task& task(it->second);
+    // cron jobs follow the wall clock, so defer one that came due early
+    //  because the system clock was turned back
+    if (task.cron_ && Cron::Clock::now() < task.cronTime_)
+    {
+      task.time_ = ToSchedulerTime(task.cronTime_);
+      queue_.push({task.time_, entry.id_, ++task.generation_});
+      continue;
+    }
+    const auto job(task.job_);
+    const bool repeat(task.cron_ || task.interval_ != Clock::duration::zero());
+    if (!repeat) { tasks_.erase(it); }
+    // don't hold the lock while running the job, so that it can (re)schedule
+    //  jobs, and so that it doesn't block anyone else from doing so
+    lock.unlock();
+    try
+    {
+      (*job)();
+    }
+    catch (const std::exception& e)
+    {
+      std::cout << "WARNING: Caught exception from scheduled job: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      std::cout << "WARNING: Caught unknown exception from scheduled job" << std::endl;
+    }
+    lock.lock();
+    // queue next run of a repeating job, unless it was cancelled, paused or
+    //  rescheduled while running
+    if (!repeat) { continue; }
+    if (const auto next(tasks_.find(entry.id_));
+      next != tasks_.end() && !next->second.paused_ &&
+      next->second.generation_ == entry.generation_)
+    {
+      Requeue(entry.id_, next->second, false);
+    }
+  }
+}
+}
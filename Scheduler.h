@@ -0,0 +1,186 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "Cron.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Timed job execution facility
+/// @details Runs jobs at requested times on a dedicated thread, so that
+///  long-running timed activities (e.g. shutdown countdowns) don't tie up the
+///  main thread. Jobs may run once, periodically, or on a cron schedule, and
+///  may be cancelled or paused at any time. Due times are kept in a min-heap,
+///  so the thread only wakes when the earliest job is due. Jobs are run one
+///  at a time in due time order, and should therefore avoid blocking for long
+///  periods. Should not throw any exceptions after construction.
+class Scheduler
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Identifier of a scheduled job, for cancellation purposes
+  using JobId = std::uint64_t;
+
+  /// @brief Function to be run by the scheduler
+  /// @details Exceptions thrown by jobs are caught and logged.
+  using Job = std::function<void()>;
+
+  /// @brief Primary constructor
+  /// @details Starts scheduler thread immediately.
+  Scheduler();
+
+  /// @brief Destructor
+  /// @details Discards any pending jobs, and blocks until the currently
+  ///  running job (if any) has returned.
+  ~Scheduler();
+
+  /// @brief Schedule a job to be run at the given time
+  /// @details Jobs scheduled for a time that has already passed are run as
+  ///  soon as possible. Safe to call from any thread, including from a job.
+  /// @param time Time at which the job should be run
+  /// @param job Function to run
+  /// @return Identifier that can be passed to @c Cancel()
+  JobId Schedule(Clock::time_point time, Job job);
+
+  /// @brief Schedule a job to be run after the given delay
+  /// @param delay Delay after which the job should be run
+  /// @param job Function to run
+  /// @return Identifier that can be passed to @c Cancel()
+  JobId ScheduleAfter(Clock::duration delay, Job job)
+    { return Schedule(Clock::now() + delay, std::move(job)); }
+
+  /// @brief Schedule a job to be run repeatedly at a fixed interval
+  /// @details The first run is one interval from now. Runs that are missed
+  ///  because the job (or one before it) ran for longer than the interval are
+  ///  skipped, rather than run back to back.
+  /// @param interval Time between runs; must be positive
+  /// @param job Function to run
+  /// @return Identifier that can be passed to @c Cancel() or @c Pause()
+  JobId ScheduleEvery(Clock::duration interval, Job job);
+
+  /// @brief Schedule a job to be run at the times matched by a cron schedule
+  /// @details Cron schedules are in terms of wall clock time, so a job that
+  ///  comes due early because the system clock was turned back is deferred.
+  /// @param cron Schedule on which to run the job
+  /// @param job Function to run
+  /// @return Identifier that can be passed to @c Cancel() or @c Pause()
+  JobId ScheduleCron(const Cron& cron, Job job);
+
+  /// @brief Cancel a job
+  /// @details Does not wait for the job to return if it is already running,
+  ///  but a periodic or cron job won't run again. Safe to call from any
+  ///  thread, including from a job.
+  /// @param id Identifier returned when job was scheduled
+  /// @return @c true if job is now cancelled, or @c false if it is a one-shot
+  ///  job that has already run or is running, or was already cancelled
+  bool Cancel(JobId id);
+
+  /// @brief Pause a job
+  /// @details A paused job doesn't run until resumed. Does not wait for the
+  ///  job to return if it is already running. Safe to call from any thread,
+  ///  including from a job.
+  /// @param id Identifier returned when job was scheduled
+  /// @return @c true if job was found
+  bool Pause(JobId id);
+
+  /// @brief Resume a paused job
+  /// @details A one-shot job keeps its original due time (and so runs as
+  ///  soon as possible if that has passed), a periodic job next runs one
+  ///  interval from now, and a cron job next runs at the next matching time.
+  ///  Does nothing if the job isn't paused. Safe to call from any thread,
+  ///  including from a job.
+  /// @param id Identifier returned when job was scheduled
+  /// @return @c true if job was found
+  bool Resume(JobId id);
+
+private:
+
+  // scheduled job
+  struct Task
+  {
+    // function to run; shared, so that it can be run without holding the
+    //  mutex, even if the job is cancelled meanwhile
+    std::shared_ptr<Job> job_;
+    // time between runs of a periodic job, or zero
+    Clock::duration interval_{};
+    // schedule of a cron job
+    std::optional<Cron> cron_;
+    // time at which job is next due
+    Clock::time_point time_;
+    // wall clock time at which a cron job is next due
+    Cron::Clock::time_point cronTime_;
+    // incremented whenever job is rescheduled, so that stale queue entries
+    //  can be told apart
+    std::uint64_t generation_{0};
+    // whether job is paused
+    bool paused_{false};
+  };
+
+  // queued due time of a job
+  struct Entry
+  {
+    Clock::time_point time_;
+    JobId id_;
+    std::uint64_t generation_;
+  };
+
+  // ordering for min-heap: earliest time first, then first scheduled first
+  struct Later
+  {
+    bool operator() (const Entry& lhs, const Entry& rhs) const
+    {
+      if (lhs.time_ != rhs.time_) { return lhs.time_ > rhs.time_; }
+      return lhs.id_ > rhs.id_;
+    }
+  };
+
+  // disabled constructors/operators
+
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator= (const Scheduler&) = delete;
+
+  // register a job, and queue it if it has a due time
+  JobId Add(Task task);
+
+  // compute the next due time of a periodic or cron job, and queue it
+  // periodic jobs keep a fixed rate, unless `restart` is set, in which case
+  //  their next run is one interval from now
+  // caller must hold mutex
+  void Requeue(JobId id, Task& task, bool restart);
+
+  // scheduler thread entry point
+  void ThreadFunction();
+
+  // mutex protecting everything below
+  std::mutex mutex_;
+  // condition variable used to wake scheduler thread for new jobs/shutdown
+  std::condition_variable cv_;
+  // flag indicating that scheduler thread should exit
+  bool stop_{false};
+  // last job identifier issued
+  JobId lastId_{0};
+  // due times in order
+  // entries of cancelled, paused and rescheduled jobs are left in here, and
+  //  skipped when they come due
+  std::priority_queue<Entry, std::vector<Entry>, Later> queue_;
+  // jobs that haven't been cancelled or (if one-shot) run
+  std::unordered_map<JobId, Task> tasks_;
+  // scheduler thread
+  std::thread thread_;
+};
+}
+
+#endif // SCHEDULER_H
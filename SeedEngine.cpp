@@ -0,0 +1,184 @@
+#include "SeedEngine.h"
+
+#include "Cache.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <random>
+#include <system_error>
+
+namespace
+{
+// cache keys under which seed state is stored
+const std::string SEED_KEY("seed");
+const std::string NEXT_SEED_KEY("nextSeed");
+const std::string STRATEGY_KEY("seedStrategy");
+const std::string LIST_INDEX_KEY("seedListIndex");
+const std::string SALT_KEY("seedSalt");
+const std::string DRAWS_KEY("seedDraws");
+
+// parse a number from a cached string
+// returns false if the string is empty or not entirely a number
+template<typename T>
+bool ParseNumber(const std::string& s, T& value)
+{
+  const auto end(s.data() + s.size());
+  const auto [ptr, ec](std::from_chars(s.data(), end, value));
+  return !s.empty() && ec == std::errc() && ptr == end;
+}
+
+std::string StrategyName(const rustLaunchSite::Config::SeedStrategy strategy)
+{
+  switch (strategy)
+  {
+    case rustLaunchSite::Config::SeedStrategy::FIXED: return "fixed";
+    case rustLaunchSite::Config::SeedStrategy::LIST: return "list";
+    case rustLaunchSite::Config::SeedStrategy::RANDOM: return "random";
+  }
+  return {};
+}
+}
+
+namespace rustLaunchSite
+{
+SeedEngine::SeedEngine(
+  const std::shared_ptr<const Config>& cfgSptr, Cache& cache)
+  : strategy_(cfgSptr->GetSeedStrategy())
+  , strategyName_(StrategyName(strategy_))
+  , fixedSeed_(cfgSptr->GetSeedFixed())
+  , seedList_(cfgSptr->GetSeedList())
+  , cache_(cache)
+{
+  // cached seeds are only usable if they were chosen by the same strategy
+  int cachedSeed(0);
+  int cachedNextSeed(0);
+  bool cached(
+    cache_.Get(STRATEGY_KEY) == strategyName_ &&
+    ParseNumber(cache_.Get(SEED_KEY), cachedSeed) &&
+    ParseNumber(cache_.Get(NEXT_SEED_KEY), cachedNextSeed));
+  switch (strategy_)
+  {
+    case Config::SeedStrategy::FIXED:
+    {
+      seed_ = fixedSeed_;
+      nextSeed_ = fixedSeed_;
+    }
+    break;
+    case Config::SeedStrategy::LIST:
+    {
+      // resume rotation from the cached position, or wherever the cached
+      //  seed has moved to if the list was edited
+      std::size_t index(0);
+      if (!cached ||
+        !ParseNumber(cache_.Get(LIST_INDEX_KEY), index) ||
+        index >= seedList_.size() || seedList_.at(index) != cachedSeed)
+      {
+        const auto it(
+          std::find(seedList_.begin(), seedList_.end(), cachedSeed));
+        if (cached && it == seedList_.end())
+        {
+          std::cout << "WARNING: Cached seed " << cachedSeed << " is no longer in seed list; restarting rotation" << std::endl;
+        }
+        index = cached && it != seedList_.end() ?
+          static_cast<std::size_t>(it - seedList_.begin()) : 0;
+      }
+      listIndex_ = index;
+      seed_ = seedList_.at(listIndex_);
+      nextSeed_ = seedList_.at((listIndex_ + 1) % seedList_.size());
+    }
+    break;
+    case Config::SeedStrategy::RANDOM:
+    {
+      // a configured salt takes precedence; otherwise, one is generated once
+      //  and then kept in the cache
+      std::uint64_t cachedSalt(0);
+      ParseNumber(cache_.Get(SALT_KEY), cachedSalt);
+      salt_ = cfgSptr->GetSeedRandom().salt_;
+      if (!salt_) { salt_ = cachedSalt; }
+      if (!salt_)
+      {
+        std::random_device rd;
+        salt_ = (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+        salt_ |= 1;
+      }
+      // a different salt yields a different sequence, so restart it
+      if (salt_ == cachedSalt) { ParseNumber(cache_.Get(DRAWS_KEY), draws_); }
+      else { cached = false; }
+      if (cached)
+      {
+        seed_ = cachedSeed;
+        nextSeed_ = cachedNextSeed;
+      }
+      else
+      {
+        seed_ = ChooseRandom();
+        nextSeed_ = ChooseRandom();
+      }
+    }
+    break;
+  }
+  Save();
+  std::cout << "Using " << strategyName_ << " map seed " << seed_ << " (next: " << nextSeed_ << ")" << std::endl;
+}
+
+int SeedEngine::Advance()
+{
+  switch (strategy_)
+  {
+    case Config::SeedStrategy::FIXED:
+    {
+      return seed_;
+    }
+    case Config::SeedStrategy::LIST:
+    {
+      listIndex_ = (listIndex_ + 1) % seedList_.size();
+      seed_ = seedList_.at(listIndex_);
+      nextSeed_ = seedList_.at((listIndex_ + 1) % seedList_.size());
+    }
+    break;
+    case Config::SeedStrategy::RANDOM:
+    {
+      seed_ = nextSeed_;
+      nextSeed_ = ChooseRandom();
+    }
+    break;
+  }
+  Save();
+  std::cout << "Advanced to map seed " << seed_ << " (next: " << nextSeed_ << ")" << std::endl;
+  return seed_;
+}
+
+int SeedEngine::Draw(const std::uint64_t salt, const std::uint64_t draw)
+{
+  // splitmix64, which gives the same sequence on every platform (unlike the
+  //  standard library distributions)
+  std::uint64_t x(salt + draw * 0x9E3779B97F4A7C15ULL);
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  x ^= x >> 31;
+  // server accepts seeds in the range [0, 2^31-1]; avoid zero
+  return static_cast<int>(x % 2147483647ULL) + 1;
+}
+
+int SeedEngine::ChooseRandom()
+{
+  return Draw(salt_, draws_++);
+}
+
+void SeedEngine::Save() const
+{
+  cache_.Set(STRATEGY_KEY, strategyName_);
+  cache_.Set(SEED_KEY, std::to_string(seed_));
+  cache_.Set(NEXT_SEED_KEY, std::to_string(nextSeed_));
+  if (strategy_ == Config::SeedStrategy::LIST)
+  {
+    cache_.Set(LIST_INDEX_KEY, std::to_string(listIndex_));
+  }
+  if (strategy_ == Config::SeedStrategy::RANDOM)
+  {
+    cache_.Set(SALT_KEY, std::to_string(salt_));
+    cache_.Set(DRAWS_KEY, std::to_string(draws_));
+  }
+}
+}
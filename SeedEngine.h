@@ -0,0 +1,92 @@
+#ifndef SEEDENGINE_H
+#define SEEDENGINE_H
+
+#include "Config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rustLaunchSite
+{
+class Cache;
+
+/// @brief Map seed selection facility
+/// @details Determines the map seed the server should use now, and the one it
+///  should use after the next wipe, according to the configured strategy.
+///  Both are persisted in the cache along with the strategy's state (list
+///  rotation position, or random draw count), so that the same seeds stay in
+///  effect across restarts of rustLaunchSite, and so that a map pre-generated
+///  for the next seed is actually used. Random seeds are derived from a salt
+///  and a draw counter, so a given salt always yields the same sequence.
+///  Should not throw any exceptions.
+class SeedEngine
+{
+public:
+
+  /// @brief Primary constructor
+  /// @details Restores seeds from the cache if they are still valid for the
+  ///  current configuration; otherwise, new ones are chosen and cached.
+  /// @param cfgSptr Shared pointer to application configuration instance
+  /// @param cache Cache in which to persist seed state; must outlive this
+  ///  instance
+  SeedEngine(const std::shared_ptr<const Config>& cfgSptr, Cache& cache);
+
+  /// @brief Get the map seed that the server should use now
+  /// @return Map seed
+  int GetSeed() const { return seed_; }
+
+  /// @brief Get the map seed that the server should use after the next wipe
+  /// @return Map seed
+  int GetNextSeed() const { return nextSeed_; }
+
+  /// @brief Advance to the next seed
+  /// @details Should be called when the server is wiped. The next seed
+  ///  becomes the current one, a new next seed is chosen, and both are
+  ///  cached. Does nothing for the "fixed" strategy.
+  /// @return New current seed
+  int Advance();
+
+private:
+
+  // disabled constructors/operators
+
+  SeedEngine() = delete;
+  SeedEngine(const SeedEngine&) = delete;
+  SeedEngine& operator= (const SeedEngine&) = delete;
+
+  // produce the random seed for the given draw number
+  static int Draw(std::uint64_t salt, std::uint64_t draw);
+
+  // choose a random seed, consuming one draw
+  int ChooseRandom();
+
+  // write current state to the cache
+  void Save() const;
+
+  // configured seed strategy
+  Config::SeedStrategy strategy_;
+  // name of configured seed strategy, as cached
+  std::string strategyName_;
+  // seed for "fixed" strategy
+  int fixedSeed_;
+  // seeds for "list" strategy
+  std::vector<int> seedList_;
+  // cache in which state is persisted
+  Cache& cache_;
+  // salt from which random seeds are derived
+  std::uint64_t salt_{0};
+  // number of random seeds drawn so far
+  std::uint64_t draws_{0};
+  // position of current seed in list
+  std::size_t listIndex_{0};
+  // seed to use now
+  int seed_{0};
+  // seed to use after the next wipe
+  int nextSeed_{0};
+};
+}
+
+#endif // SEEDENGINE_H
@@ -1,544 +1,1205 @@
-#include "Server.h"
-
-#include "Config.h"
-#include "Rcon.h"
-
-#if _MSC_VER
-  // make Boost happy when building with MSVC
-  #include <SDKDDKVer.h>
-#endif
-
-// #include <boost/winapi/show_window.hpp>
-#include <boost/process.hpp>
-#include <boost/process/extend.hpp>
-#include <boost/process/windows.hpp>
-#include <chrono>
-#include <iostream>
-#include <nlohmann/json.hpp>
-#include <sstream>
-#include <string>
-#include <system_error>
-#include <thread>
-
-namespace
-{
-// wrap a string in double-quotes if it contains spaces
-inline std::string QuoteString(const std::string& s)
-{
-  return (
-    // s.find(" ") == std::string::npos ?
-      s //:
-      // std::string("\"") + s + '\"'
-  );
-}
-
-// boost::process extension to launch a process in a new console window
-// idea from https://stackoverflow.com/a/69774875/3171290 and
-//  https://stackoverflow.com/a/68751737/3171290
-struct WindowsCreationFlags : boost::process::extend::handler
-{
-  boost::winapi::DWORD_ flags_{0};
-
-  explicit WindowsCreationFlags(const boost::winapi::DWORD_ flags)
-    : flags_(flags)
-  {
-  }
-
-  // this function will be invoked at child process constructor before spawning process
-  template <typename Char, typename Sequence>
-  void on_setup(boost::process::extend::windows_executor<Char, Sequence> & ex)
-  {
-    ex.creation_flags |= flags_;
-    // std::cout << "Modified Windows process creation flags: " << ex.creation_flags << std::endl;
-    // std::cout << "Modified Windows handle inheritance: " << ex.inherit_handles << std::endl;
-  }
-};
-}
-
-namespace rustLaunchSite
-{
-struct ProcessImpl
-{
-  std::unique_ptr<boost::process::child> processUptr_;
-};
-
-Server::Server(std::shared_ptr<const Config> cfgSptr)
-  : rconUptr_(std::make_unique<Rcon>(
-      cfgSptr->GetRconIP(), cfgSptr->GetRconPort(), cfgSptr->GetRconPassword(),
-      cfgSptr->GetRconLog()
-    ))
-  , rustDedicatedPath_(cfgSptr->GetInstallPath() / "RustDedicated.exe")
-  , stopDelaySeconds_(cfgSptr->GetProcessShutdownDelaySeconds())
-  , workingDirectory_(cfgSptr->GetInstallPath())
-{
-  // do this here, or else Sonar badgers me to use in-class initializers, which
-  //  won't work with opaque types
-  processImplUptr_ = std::make_unique<ProcessImpl>();
-  // validate config-driven paths
-  if (!std::filesystem::exists(workingDirectory_))
-  {
-    throw std::invalid_argument(
-      std::string("Server install path does not exist: ") + workingDirectory_.string());
-  }
-  if (!std::filesystem::exists(rustDedicatedPath_))
-  {
-    throw std::invalid_argument(
-      std::string("Server launch binary does not exist: ") + rustDedicatedPath_.string());
-  }
-  if (
-    const std::filesystem::path serverIdentityPath(
-      workingDirectory_ / "server" / cfgSptr->GetInstallIdentity()
-    );
-    !std::filesystem::exists(serverIdentityPath)
-  )
-  {
-    throw std::invalid_argument(
-      std::string("Server identity path does not exist: ") + serverIdentityPath.string());
-  }
-  // set up server launch arguments
-  // start with parameters directly defined in config
-  //  "minus" parameters
-  for (const auto& [mParamName, mParamData] : cfgSptr->GetMinusParams())
-  {
-    const bool isBool(mParamData.boolValue_);
-    // if this a boolean set to false, skip it
-    if (isBool && !*mParamData.boolValue_) { continue; }
-    // push parameter name (prefix is already prepended)
-    rustDedicatedArguments_.push_back(QuoteString(mParamName));
-    // if it's a boolean, skip the parameter value
-    if (isBool) { continue; }
-    // push value
-    rustDedicatedArguments_.push_back(QuoteString(mParamData.ToString()));
-  }
-  //  "plus" parameters
-  for (const auto& [pParamName, pParamData] : cfgSptr->GetPlusParams())
-  {
-    const bool isBool(pParamData.boolValue_);
-    // if this a boolean set to false, skip it
-    if (isBool && !*pParamData.boolValue_) { continue; }
-    // check for parameter names whose values may be overridden by
-    //  rustLaunchSite configuration
-    if (
-      pParamName == "+rcon.password" ||
-      (pParamName == "+rcon.ip" && cfgSptr->GetRconPassthroughIP()) ||
-      (pParamName == "+rcon.port" && cfgSptr->GetRconPassthroughPort()) ||
-      pParamName == "+rcon.web" ||
-      pParamName == "+server.identity" ||
-      pParamName == "+server.seed"
-    )
-    {
-      std::cout << "WARNING: Ignoring configured launch parameter `" << pParamName << "` because it's value will be determined automatically by rustLaunchSite" << std::endl;
-      continue;
-    }
-    // push parameter name (prefix is already prepended)
-    rustDedicatedArguments_.push_back(QuoteString(pParamName));
-    // if it's a boolean, skip the parameter value
-    if (isBool) { continue; }
-    // push value
-    rustDedicatedArguments_.push_back(QuoteString(pParamData.ToString()));
-  }
-  // now set automatically-determined parameters
-  rustDedicatedArguments_.emplace_back("+rcon.password");
-  rustDedicatedArguments_.push_back(QuoteString(cfgSptr->GetRconPassword()));
-  if (cfgSptr->GetRconPassthroughIP())
-  {
-    rustDedicatedArguments_.emplace_back("+rcon.ip");
-    rustDedicatedArguments_.push_back(QuoteString(cfgSptr->GetRconIP()));
-  }
-  if (cfgSptr->GetRconPassthroughPort())
-  {
-    rustDedicatedArguments_.emplace_back("+rcon.port");
-    std::stringstream s;
-    s << cfgSptr->GetRconPort();
-    rustDedicatedArguments_.push_back(QuoteString(s.str()));
-  }
-  rustDedicatedArguments_.emplace_back("+rcon.web");
-  rustDedicatedArguments_.emplace_back("1");
-  rustDedicatedArguments_.emplace_back("+server.identity");
-  rustDedicatedArguments_.push_back(QuoteString(cfgSptr->GetInstallIdentity()));
-  // seed is a bit complicated
-  // TODO: ...and this isn't even the final logic needed!
-  rustDedicatedArguments_.emplace_back("+server.seed");
-  int seed(1);
-  switch (cfgSptr->GetSeedStrategy())
-  {
-    case Config::SeedStrategy::FIXED:
-    {
-      seed = cfgSptr->GetSeedFixed();
-    }
-    break;
-    case Config::SeedStrategy::LIST:
-    {
-      seed = cfgSptr->GetSeedList().at(0);
-    }
-    break;
-    case Config::SeedStrategy::RANDOM:
-    {
-      seed = 1;
-    }
-    break;
-  }
-  std::stringstream seedStream;
-  seedStream << seed;
-  rustDedicatedArguments_.push_back(seedStream.str());
-}
-
-Server::~Server()
-{
-  if (IsRunning())
-  {
-    try
-    {
-      Stop("Unexpected server manager failure");
-    }
-    catch (const std::exception& e)
-    {
-      std::cout << "WARNING: Caught exception while stopping server: " << e.what() << std::endl;
-    }
-  }
-}
-
-Server::Info Server::GetInfo()
-{
-  Info retVal{};
-  if (!IsRunning()) { return retVal; }
-  const std::string& serverInfo(SendRconCommand("serverinfo", true));
-  if (serverInfo.empty()) { return retVal; }
-  /*
-  result should be JSON - example:
-  {
-    "Hostname": "My Cool Server",
-    "MaxPlayers": 50,
-    "Players": 0,
-    "Queued": 0,
-    "Joining": 0,
-    "EntityCount": 114685,
-    "GameTime": "05/22/2024 11:30:14",
-    "Uptime": 363,
-    "Map": "Procedural Map",
-    "Framerate": 204.0,
-    "Memory": 1638,
-    "MemoryUsageSystem": 7766,
-    "Collections": 151,
-    "NetworkIn": 0,
-    "NetworkOut": 0,
-    "Restarting": false,
-    "SaveCreatedTime": "04/17/2023 06:00:42",
-    "Version": 2380,
-    "Protocol": "2380.236.1"
-  }
-  */
-  // need to catch exceptions because this could be invoked from destructors
-  try
-  {
-    nlohmann::json j(nlohmann::json::parse(serverInfo));
-    retVal.valid_ = (
-      j.contains("Players") && j["Players"].is_number()
-      && j.contains("Protocol") && j["Protocol"].is_string()
-    );
-    if (retVal.valid_)
-    {
-      retVal.players_ = j["Players"].get<std::size_t>();
-      retVal.protocol_ = j["Protocol"].get<std::string>();
-    }
-  }
-  catch (const nlohmann::json::exception& e)
-  {
-    std::cout << "ERROR: Error parsing RCON serverinfo response as JSON: " << e.what()
-              << "\nResponse contents: " << serverInfo << std::endl;
-    retVal.valid_ = false;
-  }
-  return retVal;
-}
-
-bool Server::IsRunning() const
-{
-  // we should always have an impl pointer
-  if (!processImplUptr_)
-  {
-    std::cout << "ERROR: Invalid ProcessImpl pointer" << std::endl;
-    return false;
-  }
-  // if we don't have a process pointer, we're not running
-  // this is not an error, so return false silently
-  if (!processImplUptr_->processUptr_) { return false; }
-  // TODO: do we also need to check for nonzero pid like with
-  //  tiny-process-library, or is boost::process smarter?
-  boost::process::child& process(*(processImplUptr_->processUptr_));
-  std::error_code errorCode;
-  return (process.running(errorCode));
-}
-
-std::string Server::SendRconCommand(
-  const std::string& command, const bool waitForResponse
-)
-{
-  if (!IsRunning())
-  {
-    std::cout << "ERROR: Can't send RCON command due to server not running" << std::endl;
-    return std::string();
-  }
-  if (!rconUptr_)
-  {
-    std::cout << "ERROR: Failed to send RCON command due to RCON not available/connected" << std::endl;
-    return std::string();
-  }
-  return rconUptr_->SendCommand(command, waitForResponse ? 10000 : 0);
-}
-
-bool Server::Start()
-{
-  if (IsRunning())
-  {
-    std::cout << "WARNING: Can't start server because it's already running" << std::endl;
-    return true;
-  }
-  if (!processImplUptr_)
-  {
-    std::cout << "WARNING: ProcessImpl pointer is invalid" << std::endl;
-    return false;
-  }
-  if (processImplUptr_->processUptr_)
-  {
-    // don't warn since this happens in the case of an unexpected restart
-    // std::cout << "WARNING: Resetting defunct server process handle" << std::endl;
-    processImplUptr_->processUptr_.reset();
-  }
-  std::error_code errorCode;
-/* NOTE: this mode is disabled because at best it detaches from RLS to the point
-  that I can't seem to kill it
-  if (false)
-  {
-    const auto conPath(boost::process::search_path("conhost.exe"));
-    if (conPath.empty())
-    {
-      std::cout << "ERROR: Failed to find conhost" << std::endl;
-      return false;
-    }
-    std::vector<std::string> args
-    {
-      // "/S", "/C",
-      // "start",
-      // "/D", workingDirectory_,
-      // "/MAX",
-      // "/WAIT",
-      rustDedicatedPath_
-    };
-    args.insert(
-      args.end(),
-      rustDedicatedArguments_.begin(), rustDedicatedArguments_.end()
-    );
-    processImplUptr_->processUptr_ = std::make_unique<boost::process::child>(
-      // boost::process::shell(errorCode),
-      boost::process::exe(conPath),
-      boost::process::args(args),
-      boost::process::start_dir(workingDirectory_),
-      // I/O redirect options and effects w/create group+console
-      // - do nothing: broken scrolling, can't terminate
-      // - close any/all: broken scrolling, can't terminate
-      // - redirect any/all to null: looks OK, can't terminate?
-      // ***could be create new console or process group that broke terminate
-      // boost::process::std_in.close(),
-      // boost::process::std_out.close(),
-      // boost::process::std_err.close(),
-      // I/O redirect options and effects w/create console only
-      // - redirect: looks OK, can't terminate
-      // I/O redirect options and effects w/detached only
-      // - redirect: looks OK, can't terminate
-      // I/O redirect options and effects w/create no window only
-      // - redirect: no window, can't terminate
-      boost::process::std_in  < boost::process::null,
-      boost::process::std_out > boost::process::null,
-      boost::process::std_err > boost::process::null,
-      boost::process::error(errorCode),
-      boost::process::windows::maximized //,
-      // WindowsCreationFlags(
-        // disconnect child process from Ctrl+C signals issued to parent
-        // boost::winapi::CREATE_NEW_PROCESS_GROUP_ |
-        // boost::winapi::CREATE_NO_WINDOW_
-      // )
-    );
-  }
-  else
-  {
-*/
-  // std::cout << "***** ARGS BEGIN:" << std::endl;
-  // for (const auto& arg : rustDedicatedArguments_)
-  // {
-  //   std::cout << "*****\t" << arg << std::endl;
-  // }
-  // std::cout << "***** ARGS END:" << std::endl;
-  processImplUptr_->processUptr_ = std::make_unique<boost::process::child>(
-    boost::process::exe(rustDedicatedPath_.string()),
-    boost::process::args(rustDedicatedArguments_),
-    boost::process::start_dir(workingDirectory_.string()),
-    // I/O redirect options and effects:
-    // - do nothing: server takes over our console and garbles it up
-    // - close any/all: server spams its logs with exceptions
-    // - redirect any/all to null: server logs some things twice
-    boost::process::std_in  < boost::process::null,
-    boost::process::std_out > boost::process::null,
-    boost::process::std_err > boost::process::null,
-    boost::process::error(errorCode),
-    WindowsCreationFlags(
-      // disconnect child process from Ctrl+C signals issued to parent
-      boost::winapi::CREATE_NEW_PROCESS_GROUP_
-    )
-  );
-/*
-  }
-*/
-  if (!processImplUptr_->processUptr_)
-  {
-    std::cout << "ERROR: Failed to create server process handle" << std::endl;
-    return false;
-  }
-  if (errorCode)
-  {
-    std::cout << "ERROR: Error creating server process: " << errorCode.message() << std::endl;
-    processImplUptr_->processUptr_.reset();
-    return false;
-  }
-  // auto& process(*processImplUptr_->process_);
-  for (std::size_t i(0); i < 10 && !IsRunning(); ++i)
-  {
-    std::cout << "WARNING: Server not running - waiting..." << std::endl;
-    std::this_thread::sleep_for(std::chrono::seconds(2));
-  }
-  if (!IsRunning())
-  {
-    std::cout << "ERROR: Server failed to launch" << std::endl;
-    processImplUptr_->processUptr_.reset();
-    return false;
-  }
-  std::cout << "Server launched successfully" << std::endl;
-  // std::cout
-  //   << "id=" << processImplUptr_->processUptr_->id()
-  //   << ", handle=" << processImplUptr_->processUptr_->native_handle()
-  //   << std::endl;
-  return true;
-}
-
-void Server::Stop(const std::string& reason)
-{
-  if (!IsRunning())
-  {
-    // std::cout << "WARNING: Can't stop server because it's not running" << std::endl;
-    return;
-  }
-  std::cout << "Stop(): Stopping server for reason: " << reason << std::endl;
-  if (!processImplUptr_ || !processImplUptr_->processUptr_)
-  {
-    std::cout << "ERROR: Process handle/impl pointer is null" << std::endl;
-    return;
-  }
-  boost::process::child& process(*processImplUptr_->processUptr_);
-  // TODO: notify Discord someday?
-  if (rconUptr_ && rconUptr_->IsConnected())
-  {
-    // delay shutdown if/as appropriate
-    StopDelay(reason);
-    // send RCON quit command and wait for some amount of time for shutdown
-    std::cout << "Commanding server quit via RCON" << std::endl;
-    SendRconCommand("quit", true);
-    for (std::size_t i(0); i < 10 && IsRunning(); ++i)
-    {
-      std::cout << "Waiting for server to quit..." << std::endl;
-      std::this_thread::sleep_for(std::chrono::seconds(1));
-    }
-  }
-  else
-  {
-    std::cout << "WARNING: RCON is not available; cannot issue shutdown commands" << std::endl;
-  }
-  std::error_code errorCode;
-  if (IsRunning())
-  {
-    std::cout << "WARNING: Server still running; performing process kill" << std::endl;
-    process.terminate(errorCode);
-  }
-  if (errorCode)
-  {
-    std::cout << "WARNING: Process library returned error code: " << errorCode.message() << std::endl;
-  }
-
-  if (const auto exitCode(process.exit_code()); exitCode)
-  {
-    std::cout << "WARNING: Server process returned nonzero exit code: " << exitCode << std::endl;
-  }
-  // dump the pointer, since we can't re-launch the process at this point
-  // NOTE: this invalidates local reference `process`
-  processImplUptr_->processUptr_.reset();
-}
-
-void Server::StopDelay(std::string_view reason)
-{
-  if (!stopDelaySeconds_)
-  {
-    std::cout << "Skipping shutdown delay checks" << std::endl;
-    return;
-  }
-
-  std::cout << "Performing shutdown delay checks" << std::endl;
-  // latest possible shutdown time
-  const std::chrono::steady_clock::time_point shutdownTime(
-    std::chrono::steady_clock::now() +
-    std::chrono::seconds(stopDelaySeconds_)
-  );
-  while (IsRunning() && std::chrono::steady_clock::now() <= shutdownTime)
-  {
-    // server info via RCON, which contains connected player count
-    const Info& serverInfo(GetInfo());
-    // if no RCON response or no players, exit loop and quit immediately
-    // this is an optimization in case no players are on, or the last
-    //  player quits while we're looping
-    if (!serverInfo.valid_ || !serverInfo.players_) { break; }
-    // maximum remaining delay time in seconds
-    const auto remainingTimeSeconds(
-      std::chrono::duration_cast<std::chrono::seconds>(
-        shutdownTime - std::chrono::steady_clock::now()
-      )
-    );
-    // how often notifications are occurring based on time left
-    const std::chrono::seconds markIntervalSeconds(
-      remainingTimeSeconds.count() > 300 ? 300 :
-      remainingTimeSeconds.count() >  60 ?  60 :
-      remainingTimeSeconds.count() >  10 ?  10 :
-                                      1
-    );
-    // number of seconds until next notification
-    const auto marksRemaining(
-      remainingTimeSeconds / markIntervalSeconds
-    );
-    // number of seconds before shutdown time that next mark should occur
-    const std::chrono::seconds markDeltaSeconds(
-      markIntervalSeconds * marksRemaining
-    );
-    // time at which next mark should occur
-    const std::chrono::steady_clock::time_point nextMarkTime(
-      shutdownTime - std::chrono::seconds(markDeltaSeconds)
-    );
-    // notify user(s)
-    // fudge the count by one second so that it looks nicer
-    std::stringstream s;
-    s << remainingTimeSeconds.count() + 1;
-    std::cout
-      << serverInfo.players_ << " player(s) online; delaying shutdown by up to "
-      << s.str() << " second(s)" << std::endl;
-    std::string sayString("say *** Shutdown in ");
-    sayString.append(s.str()).append(" second(s)");
-    if (!reason.empty())
-    {
-      sayString.append(" for reason: ").append(reason);
-    }
-    // don't wait for response, as it comes in with id=-1
-    SendRconCommand(sayString, false);
-    // sleep until next mark
-    std::cout
-      << "Sleeping from " << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
-      << " until " << std::chrono::duration_cast<std::chrono::seconds>(nextMarkTime.time_since_epoch()).count()
-      << "; latest shutdown at " << std::chrono::duration_cast<std::chrono::seconds>(shutdownTime.time_since_epoch()).count() << std::endl;
-    std::this_thread::sleep_until(nextMarkTime);
-  }
-}
-}
+#include "Server.h"
+
+#include "CancellationToken.h"
+#include "Cgroup.h"
+#include "Config.h"
+#include "History.h"
+#include "OutputBuffer.h"
+#include "ProcessTuning.h"
+#include "Rcon.h"
+#include "ResourceSampler.h"
+#include "StartupMonitor.h"
+
+#if _MSC_VER
+  // make Boost happy when building with MSVC
+  #include <SDKDDKVer.h>
+#endif
+
+// #include <boost/winapi/show_window.hpp>
+#include <boost/process.hpp>
+#include <boost/process/extend.hpp>
+#if _WIN32
+  #include <boost/process/windows.hpp>
+  #include <boost/winapi/get_last_error.hpp>
+  #include <boost/winapi/process.hpp>
+#else
+  #include <csignal>  // kill()
+  #include <unistd.h> // setpgid()
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace rustLaunchSite
+{
+// tracks completion of world saves, as reported via console output or RCON
+//  broadcasts (whichever arrives first)
+// this is shared with pipe reader threads and the RCON message handler
+struct SaveTracker
+{
+  // console message the server logs on save completion looks like:
+  //  `Saved 1,234,567 ents, cache(0.12), write(0.34), disk(0.01).`
+  static constexpr std::string_view SAVED_PREFIX{"Saved "};
+  static constexpr std::string_view SAVED_SUFFIX{" ents"};
+
+  // mutex protecting everything below
+  std::mutex mutex_;
+  // condition variable signaled on save completion
+  std::condition_variable cv_;
+  // whether a save completion is being waited on
+  bool pending_{false};
+  // whether the wait was cancelled
+  bool cancelled_{false};
+  // number of entities reported by most recent save, or -1 if unknown
+  long long entities_{-1};
+
+  // start waiting for a save to complete
+  void Begin()
+  {
+    std::scoped_lock lock(mutex_);
+    pending_ = true;
+    cancelled_ = false;
+    entities_ = -1;
+  }
+
+  // stop waiting for the current save to complete
+  void Cancel()
+  {
+    {
+      std::scoped_lock lock(mutex_);
+      cancelled_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  // check a line of console output (or an RCON message) for save completion
+  void ProcessLine(const std::string_view line)
+  {
+    const auto prefixPos(line.find(SAVED_PREFIX));
+    if (prefixPos == std::string_view::npos) { return; }
+    const auto suffixPos(line.find(SAVED_SUFFIX, prefixPos));
+    if (suffixPos == std::string_view::npos) { return; }
+    // parse entity count, skipping thousands separators
+    long long entities(0);
+    bool valid(suffixPos > prefixPos + SAVED_PREFIX.size());
+    for (auto i(prefixPos + SAVED_PREFIX.size()); valid && i < suffixPos; ++i)
+    {
+      if (line[i] >= '0' && line[i] <= '9')
+      {
+        entities = entities * 10 + (line[i] - '0');
+      }
+      else if (line[i] != ',' && line[i] != '.')
+      {
+        valid = false;
+      }
+    }
+    if (!valid) { return; }
+    {
+      std::scoped_lock lock(mutex_);
+      if (!pending_) { return; }
+      pending_ = false;
+      entities_ = entities;
+    }
+    cv_.notify_all();
+  }
+
+  // block until save completes, the wait is cancelled, or timeout elapses
+  // returns whether save completed
+  bool Wait(const std::chrono::steady_clock::duration timeout)
+  {
+    std::unique_lock lock(mutex_);
+    cv_.wait_for(lock, timeout, [this]() { return !pending_ || cancelled_; });
+    const bool completed(!pending_);
+    pending_ = false;
+    return completed;
+  }
+};
+}
+
+namespace
+{
+// wrap a string in double-quotes if it contains spaces
+inline std::string QuoteString(const std::string& s)
+{
+  return (
+    // s.find(" ") == std::string::npos ?
+      s //:
+      // std::string("\"") + s + '\"'
+  );
+}
+
+#if _WIN32
+// boost::process extension to launch a process in a new console window
+// idea from https://stackoverflow.com/a/69774875/3171290 and
+//  https://stackoverflow.com/a/68751737/3171290
+struct WindowsCreationFlags : boost::process::extend::handler
+{
+  boost::winapi::DWORD_ flags_{0};
+
+  explicit WindowsCreationFlags(const boost::winapi::DWORD_ flags)
+    : flags_(flags)
+  {
+  }
+
+  // this function will be invoked at child process constructor before spawning process
+  template <typename Char, typename Sequence>
+  void on_setup(boost::process::extend::windows_executor<Char, Sequence> & ex)
+  {
+    ex.creation_flags |= flags_;
+    // std::cout << "Modified Windows process creation flags: " << ex.creation_flags << std::endl;
+    // std::cout << "Modified Windows handle inheritance: " << ex.inherit_handles << std::endl;
+  }
+};
+#else
+// boost::process extension to launch a process in a new process group
+// this is the POSIX equivalent of CREATE_NEW_PROCESS_GROUP, which keeps Ctrl+C
+//  in a terminal from sending SIGINT straight to the server
+struct NewProcessGroup : boost::process::extend::handler
+{
+  template<typename Sequence>
+  void on_exec_setup(
+    [[maybe_unused]] boost::process::extend::posix_executor<Sequence>& ex
+  ) const
+  {
+    ::setpgid(0, 0);
+  }
+};
+#endif
+
+// reads lines from one of the server's output pipes into the output buffer
+// this is owned via shared pointer by a detached thread, so that the thread can
+//  keep draining the pipe for as long as anything holds it open (e.g. a crash
+//  handler subprocess that inherited it) without anyone having to wait on it
+struct PipeReader
+{
+  boost::process::ipstream stream_;
+  std::shared_ptr<rustLaunchSite::OutputBuffer> bufferSptr_;
+  std::shared_ptr<rustLaunchSite::StartupMonitor> monitorSptr_;
+  std::shared_ptr<rustLaunchSite::SaveTracker> saveTrackerSptr_;
+  bool stdErr_;
+
+  PipeReader(
+    std::shared_ptr<rustLaunchSite::OutputBuffer> bufferSptr,
+    std::shared_ptr<rustLaunchSite::StartupMonitor> monitorSptr,
+    std::shared_ptr<rustLaunchSite::SaveTracker> saveTrackerSptr,
+    const bool stdErr
+  )
+    : bufferSptr_(std::move(bufferSptr))
+    , monitorSptr_(std::move(monitorSptr))
+    , saveTrackerSptr_(std::move(saveTrackerSptr))
+    , stdErr_(stdErr)
+  {
+  }
+
+  // spawn a thread that reads lines until the pipe is closed
+  // the buffer never blocks, so the server can never block on a full pipe
+  //  waiting for us; if capture is disabled, lines are only scanned for
+  //  startup/save markers and then discarded
+  static void Start(std::shared_ptr<PipeReader> readerSptr)
+  {
+    std::thread([readerSptr]()
+    {
+      std::string line;
+      while (std::getline(readerSptr->stream_, line))
+      {
+        if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+        if (readerSptr->bufferSptr_)
+        {
+          readerSptr->bufferSptr_->Push(line, readerSptr->stdErr_);
+        }
+        readerSptr->monitorSptr_->ProcessLine(line);
+        readerSptr->saveTrackerSptr_->ProcessLine(line);
+      }
+    }).detach();
+  }
+};
+
+// build the environment to launch a process with, by applying the given
+//  profile to the environment inherited from rustLaunchSite
+// logs what was changed, and skips preload libraries that don't exist
+boost::process::environment BuildEnvironment(
+  const rustLaunchSite::Config::EnvironmentProfile& profile)
+{
+  auto environment(boost::this_process::environment());
+  std::stringstream changes;
+  for (const auto& [name, value] : profile.vars_)
+  {
+    if (value)
+    {
+      environment[name] = *value;
+      changes << "\n\t" << name << '=' << *value;
+    }
+    else if (environment.count(name))
+    {
+      environment.erase(name);
+      changes << "\n\t(unset " << name << ')';
+    }
+  }
+  std::string preload;
+  for (const auto& library : profile.preload_)
+  {
+#if _WIN32
+    std::cout << "WARNING: Library preloading is not supported on Windows; ignoring " << library << std::endl;
+#else
+    if (!std::filesystem::exists(library))
+    {
+      std::cout << "WARNING: Preload library does not exist; ignoring: " << library << std::endl;
+      continue;
+    }
+    if (!preload.empty()) { preload += ':'; }
+    preload += library.string();
+#endif
+  }
+  if (!preload.empty())
+  {
+    // keep anything that was already being preloaded, but after ours
+    if (environment.count("LD_PRELOAD"))
+    {
+      const auto& inherited(environment["LD_PRELOAD"].to_string());
+      if (!inherited.empty()) { preload += ':' + inherited; }
+    }
+    environment["LD_PRELOAD"] = preload;
+    changes << "\n\tLD_PRELOAD=" << preload;
+  }
+  if (!changes.str().empty())
+  {
+    std::cout << "Server launch environment";
+    if (!profile.name_.empty()) { std::cout << " (profile=" << profile.name_ << ')'; }
+    std::cout << ':' << changes.str() << std::endl;
+  }
+  return environment;
+}
+}
+
+namespace rustLaunchSite
+{
+struct ProcessImpl
+{
+  std::unique_ptr<boost::process::child> processUptr_;
+  // environment to launch server with
+  boost::process::environment environment_;
+  // mutex protecting exit flag
+  std::mutex mutex_;
+  // condition variable signaled on process exit
+  std::condition_variable cv_;
+  // whether process has exited (or was never launched)
+  bool exited_{true};
+  // thread that blocks on process exit
+  // this is the only thread allowed to wait on/reap the process, so that
+  //  nothing else races it for the exit status
+  std::thread watcherThread_;
+
+  ~ProcessImpl() { Reset(); }
+
+  // start watching for exit of a newly-launched process
+  void Watch()
+  {
+    {
+      std::scoped_lock lock(mutex_);
+      exited_ = false;
+    }
+    watcherThread_ = std::thread([this]()
+    {
+      std::error_code errorCode;
+      processUptr_->wait(errorCode);
+      if (errorCode)
+      {
+        std::cout << "WARNING: Error waiting for server process exit: " << errorCode.message() << std::endl;
+      }
+      {
+        std::scoped_lock lock(mutex_);
+        exited_ = true;
+      }
+      cv_.notify_all();
+    });
+  }
+
+  // returns whether process has exited
+  bool HasExited()
+  {
+    std::scoped_lock lock(mutex_);
+    return exited_;
+  }
+
+  // block until process exits or timeout elapses
+  // returns whether process has exited
+  bool WaitForExit(const std::chrono::steady_clock::duration timeout)
+  {
+    std::unique_lock lock(mutex_);
+    return cv_.wait_for(lock, timeout, [this]() { return exited_; });
+  }
+
+  // block until process exits, however long that takes
+  void WaitForExit()
+  {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this]() { return exited_; });
+  }
+
+#if !_WIN32
+  // send given signal to process, if it hasn't exited
+  void Signal(const int signal)
+  {
+    if (HasExited()) { return; }
+    if (::kill(processUptr_->id(), signal))
+    {
+      std::cout << "WARNING: Failed to send signal " << signal << " to server process: " << std::strerror(errno) << std::endl;
+    }
+  }
+#endif
+
+  // forcibly kill process, if it hasn't exited
+  // this doesn't use boost::process::child::terminate(), because that also
+  //  waits on the process, which would race the watcher thread
+  void Kill()
+  {
+#if _WIN32
+    if (HasExited()) { return; }
+    if (!boost::winapi::TerminateProcess(processUptr_->native_handle(), 1))
+    {
+      std::cout << "WARNING: Failed to terminate server process: " << boost::winapi::GetLastError() << std::endl;
+    }
+#else
+    Signal(SIGKILL);
+#endif
+  }
+
+  // discard process handle, killing the process first if it's still running
+  void Reset()
+  {
+    if (watcherThread_.joinable())
+    {
+      Kill();
+      watcherThread_.join();
+    }
+    processUptr_.reset();
+  }
+};
+
+Server::Server(std::shared_ptr<const Config> cfgSptr)
+  : outputBufferSptr_(cfgSptr->GetProcessOutputBufferLines() > 0 ?
+      std::make_shared<OutputBuffer>(cfgSptr->GetProcessOutputBufferLines()) :
+      nullptr)
+  , startupMonitorSptr_(std::make_shared<StartupMonitor>(
+      cfgSptr->GetProcessStartupReadyMarkers(),
+      cfgSptr->GetProcessStartupPhaseMarkers(),
+      std::make_shared<History>(
+        cfgSptr->GetPathsData() / "startupHistory.jsonl")
+    ))
+  , saveTrackerSptr_(std::make_shared<SaveTracker>())
+  , processTuningUptr_(
+      std::make_unique<ProcessTuning>(cfgSptr->GetProcessPriority()))
+  , cgroupUptr_(std::make_unique<Cgroup>(
+      cfgSptr->GetProcessCgroup(),
+      "rustDedicated-" + cfgSptr->GetInstallIdentity()))
+  , saveHistorySptr_(std::make_shared<History>(
+      cfgSptr->GetPathsData() / "saveHistory.jsonl"))
+  , shutdownHistorySptr_(std::make_shared<History>(
+      cfgSptr->GetPathsData() / "shutdownHistory.jsonl"))
+  , resourceSamplerUptr_(
+      cfgSptr->GetProcessResourceSamplingIntervalSeconds() > 0 ?
+        std::make_unique<ResourceSampler>(
+          std::chrono::seconds(
+            cfgSptr->GetProcessResourceSamplingIntervalSeconds()),
+          cfgSptr->GetProcessResourceSamplingSamples()) :
+        nullptr)
+  , telemetryUptr_(
+      cfgSptr->GetProcessTelemetryIntervalSeconds() > 0 ?
+        std::make_unique<Telemetry>(
+          static_cast<std::size_t>(cfgSptr->GetProcessTelemetryRetentionDays())
+            * 86400 / cfgSptr->GetProcessTelemetryIntervalSeconds(),
+          cfgSptr->GetPathsData() / "telemetry.bin") :
+        nullptr)
+  , telemetryInterval_(cfgSptr->GetProcessTelemetryIntervalSeconds())
+  , rconUptr_(std::make_unique<Rcon>(
+      cfgSptr->GetRconIP(), cfgSptr->GetRconPort(), cfgSptr->GetRconPassword(),
+      cfgSptr->GetRconLog()
+    ))
+  , environmentProfile_(cfgSptr->GetProcessEnvironment().name_)
+#if _WIN32
+  , rustDedicatedPath_(cfgSptr->GetInstallPath() / "RustDedicated.exe")
+#else
+  , rustDedicatedPath_(cfgSptr->GetInstallPath() / "RustDedicated")
+#endif
+  , seed_(0)
+  , worldSize_(0)
+  , saveTimeoutSeconds_(cfgSptr->GetProcessShutdownSaveTimeoutSeconds())
+  , quitTimeoutSeconds_(cfgSptr->GetProcessShutdownQuitTimeoutSeconds())
+  , terminateTimeoutSeconds_(
+      cfgSptr->GetProcessShutdownTerminateTimeoutSeconds())
+  , workingDirectory_(cfgSptr->GetInstallPath())
+  , crashArtifactsPath_(cfgSptr->GetPathsData() / "crashes")
+  , crashArtifactsRetained_(
+      cfgSptr->GetProcessCrashLoop().artifactsRetained_)
+  , threadDumpSeconds_(cfgSptr->GetProcessWatchdog().threadDumpSeconds_)
+{
+  // do this here, or else Sonar badgers me to use in-class initializers, which
+  //  won't work with opaque types
+  processImplUptr_ = std::make_unique<ProcessImpl>();
+  processImplUptr_->environment_ =
+    BuildEnvironment(cfgSptr->GetProcessEnvironment());
+  // watch RCON broadcasts for save completion, in case console output
+  //  doesn't include it
+  rconUptr_->Register(
+    [saveTrackerSptr = saveTrackerSptr_](const std::string& message)
+    {
+      saveTrackerSptr->ProcessLine(message);
+    }
+  );
+  // validate config-driven paths
+  if (!std::filesystem::exists(workingDirectory_))
+  {
+    throw std::invalid_argument(
+      std::string("Server install path does not exist: ") + workingDirectory_.string());
+  }
+  if (!std::filesystem::exists(rustDedicatedPath_))
+  {
+    throw std::invalid_argument(
+      std::string("Server launch binary does not exist: ") + rustDedicatedPath_.string());
+  }
+  if (
+    const std::filesystem::path serverIdentityPath(
+      workingDirectory_ / "server" / cfgSptr->GetInstallIdentity()
+    );
+    !std::filesystem::exists(serverIdentityPath)
+  )
+  {
+    throw std::invalid_argument(
+      std::string("Server identity path does not exist: ") + serverIdentityPath.string());
+  }
+  // set up server launch arguments
+  // start with parameters directly defined in config
+  //  "minus" parameters
+  for (const auto& [mParamName, mParamData] : cfgSptr->GetMinusParams())
+  {
+    const bool isBool(mParamData.boolValue_);
+    // if this a boolean set to false, skip it
+    if (isBool && !*mParamData.boolValue_) { continue; }
+    // remember log file path for log monitoring
+    // server resolves relative paths against its working directory
+    if (mParamName == "-logfile" && mParamData.stringValue_)
+    {
+      logFilePath_ = workingDirectory_ / *mParamData.stringValue_;
+      logFilePath_.make_preferred();
+    }
+    // push parameter name (prefix is already prepended)
+    rustDedicatedArguments_.push_back(QuoteString(mParamName));
+    // if it's a boolean, skip the parameter value
+    if (isBool) { continue; }
+    // push value
+    rustDedicatedArguments_.push_back(QuoteString(mParamData.ToString()));
+  }
+  if (!logFilePath_.empty() &&
+    cfgSptr->GetProcessLogMonitorPollIntervalMilliseconds() > 0)
+  {
+    logTailerUptr_ = std::make_unique<LogTailer>(
+      cfgSptr->GetProcessLogMonitorPatterns(),
+      std::chrono::milliseconds(
+        cfgSptr->GetProcessLogMonitorPollIntervalMilliseconds()));
+  }
+  //  "plus" parameters
+  for (const auto& [pParamName, pParamData] : cfgSptr->GetPlusParams())
+  {
+    const bool isBool(pParamData.boolValue_);
+    // if this a boolean set to false, skip it
+    if (isBool && !*pParamData.boolValue_) { continue; }
+    // check for parameter names whose values may be overridden by
+    //  rustLaunchSite configuration
+    if (
+      pParamName == "+rcon.password" ||
+      (pParamName == "+rcon.ip" && cfgSptr->GetRconPassthroughIP()) ||
+      (pParamName == "+rcon.port" && cfgSptr->GetRconPassthroughPort()) ||
+      pParamName == "+rcon.web" ||
+      pParamName == "+server.identity" ||
+      pParamName == "+server.seed"
+    )
+    {
+      std::cout << "WARNING: Ignoring configured launch parameter `" << pParamName << "` because it's value will be determined automatically by rustLaunchSite" << std::endl;
+      continue;
+    }
+    // remember map size for startup profiling
+    if (pParamName == "+server.worldsize" && pParamData.intValue_)
+    {
+      worldSize_ = *pParamData.intValue_;
+    }
+    // push parameter name (prefix is already prepended)
+    rustDedicatedArguments_.push_back(QuoteString(pParamName));
+    // if it's a boolean, skip the parameter value
+    if (isBool) { continue; }
+    // push value
+    rustDedicatedArguments_.push_back(QuoteString(pParamData.ToString()));
+  }
+  // now set automatically-determined parameters
+  rustDedicatedArguments_.emplace_back("+rcon.password");
+  rustDedicatedArguments_.push_back(QuoteString(cfgSptr->GetRconPassword()));
+  if (cfgSptr->GetRconPassthroughIP())
+  {
+    rustDedicatedArguments_.emplace_back("+rcon.ip");
+    rustDedicatedArguments_.push_back(QuoteString(cfgSptr->GetRconIP()));
+  }
+  if (cfgSptr->GetRconPassthroughPort())
+  {
+    rustDedicatedArguments_.emplace_back("+rcon.port");
+    std::stringstream s;
+    s << cfgSptr->GetRconPort();
+    rustDedicatedArguments_.push_back(QuoteString(s.str()));
+  }
+  rustDedicatedArguments_.emplace_back("+rcon.web");
+  rustDedicatedArguments_.emplace_back("1");
+  rustDedicatedArguments_.emplace_back("+server.identity");
+  rustDedicatedArguments_.push_back(QuoteString(cfgSptr->GetInstallIdentity()));
+  // seed is determined by the caller via SetSeed(); leave a placeholder
+  rustDedicatedArguments_.emplace_back("+server.seed");
+  seedArgumentIndex_ = rustDedicatedArguments_.size();
+  rustDedicatedArguments_.push_back(std::to_string(seed_));
+}
+
+Server::~Server()
+{
+  if (IsRunning())
+  {
+    try
+    {
+      Stop(CancellationToken(), "Unexpected server manager failure");
+    }
+    catch (const std::exception& e)
+    {
+      std::cout << "WARNING: Caught exception while stopping server: " << e.what() << std::endl;
+    }
+  }
+}
+
+Server::Info Server::GetInfo()
+{
+  Info retVal{};
+  if (!IsRunning()) { return retVal; }
+  const std::string& serverInfo(SendRconCommand("serverinfo", true));
+  if (serverInfo.empty()) { return retVal; }
+  /*
+  result should be JSON - example:
+  {
+    "Hostname": "My Cool Server",
+    "MaxPlayers": 50,
+    "Players": 0,
+    "Queued": 0,
+    "Joining": 0,
+    "EntityCount": 114685,
+    "GameTime": "05/22/2024 11:30:14",
+    "Uptime": 363,
+    "Map": "Procedural Map",
+    "Framerate": 204.0,
+    "Memory": 1638,
+    "MemoryUsageSystem": 7766,
+    "Collections": 151,
+    "NetworkIn": 0,
+    "NetworkOut": 0,
+    "Restarting": false,
+    "SaveCreatedTime": "04/17/2023 06:00:42",
+    "Version": 2380,
+    "Protocol": "2380.236.1"
+  }
+  */
+  // need to catch exceptions because this could be invoked from destructors
+  try
+  {
+    nlohmann::json j(nlohmann::json::parse(serverInfo));
+    retVal.valid_ = (
+      j.contains("Players") && j["Players"].is_number()
+      && j.contains("Protocol") && j["Protocol"].is_string()
+    );
+    if (retVal.valid_)
+    {
+      retVal.players_ = j["Players"].get<std::size_t>();
+      retVal.protocol_ = j["Protocol"].get<std::string>();
+      // performance metrics are optional, as they're only used for
+      //  monitoring purposes
+      const auto getOptionalNumber([&j](const char* key, auto& dest)
+      {
+        if (j.contains(key) && j[key].is_number()) { j[key].get_to(dest); }
+      });
+      getOptionalNumber("Queued", retVal.queued_);
+      getOptionalNumber("Joining", retVal.joining_);
+      getOptionalNumber("Framerate", retVal.framerate_);
+      getOptionalNumber("Memory", retVal.memoryMb_);
+      getOptionalNumber("MemoryUsageSystem", retVal.memoryUsageSystemMb_);
+      getOptionalNumber("EntityCount", retVal.entityCount_);
+      getOptionalNumber("Collections", retVal.collections_);
+      getOptionalNumber("NetworkIn", retVal.networkIn_);
+      getOptionalNumber("NetworkOut", retVal.networkOut_);
+      getOptionalNumber("Uptime", retVal.uptimeSeconds_);
+      // this is called more often than telemetry is wanted (e.g. player
+      //  count checks during countdowns), so throttle recording
+      bool recordTelemetry(false);
+      if (telemetryUptr_)
+      {
+        const auto now(std::chrono::steady_clock::now());
+        std::scoped_lock lock(telemetryMutex_);
+        if (now - telemetryTime_ >= telemetryInterval_)
+        {
+          telemetryTime_ = now;
+          recordTelemetry = true;
+        }
+      }
+      if (recordTelemetry)
+      {
+        Telemetry::Record record;
+        record.time_ = std::chrono::system_clock::now();
+        record.players_ = retVal.players_;
+        record.queued_ = retVal.queued_;
+        record.joining_ = retVal.joining_;
+        record.entityCount_ = retVal.entityCount_;
+        record.framerate_ = retVal.framerate_;
+        record.memoryMb_ = retVal.memoryMb_;
+        record.memoryUsageSystemMb_ = retVal.memoryUsageSystemMb_;
+        record.collections_ = retVal.collections_;
+        record.networkIn_ = retVal.networkIn_;
+        record.networkOut_ = retVal.networkOut_;
+        record.uptimeSeconds_ = retVal.uptimeSeconds_;
+        if (const auto& stats(cgroupUptr_->GetStats()); stats.valid_)
+        {
+          record.cpuThrottledUsec_ = stats.cpuThrottledUsec_;
+          record.memoryHighEvents_ = stats.memoryHighEvents_;
+          record.oomKills_ = stats.oomKills_;
+          record.memoryStallUsec_ = stats.memoryStallUsec_;
+        }
+        telemetryUptr_->Add(record);
+      }
+      startupMonitorSptr_->ProcessServerInfo(
+        retVal.protocol_,
+        j.contains("Version") && j["Version"].is_number() ?
+          j["Version"].get<int>() : 0
+      );
+    }
+  }
+  catch (const nlohmann::json::exception& e)
+  {
+    std::cout << "ERROR: Error parsing RCON serverinfo response as JSON: " << e.what()
+              << "\nResponse contents: " << serverInfo << std::endl;
+    retVal.valid_ = false;
+  }
+  return retVal;
+}
+
+std::vector<OutputBuffer::Line> Server::GetOutput(const std::size_t maxLines) const
+{
+  if (!outputBufferSptr_) { return {}; }
+  return outputBufferSptr_->Tail(maxLines);
+}
+
+std::vector<ResourceSampler::Sample> Server::GetResourceSamples(
+  const std::size_t maxSamples) const
+{
+  if (!resourceSamplerUptr_) { return {}; }
+  return resourceSamplerUptr_->GetSamples(maxSamples);
+}
+
+std::vector<Telemetry::Record> Server::GetTelemetry(
+  const std::size_t maxRecords) const
+{
+  if (!telemetryUptr_) { return {}; }
+  return telemetryUptr_->GetRecords(maxRecords);
+}
+
+LogTailer::EventMapType Server::GetLogEvents() const
+{
+  if (!logTailerUptr_) { return {}; }
+  return logTailerUptr_->GetEvents();
+}
+
+std::uint64_t Server::GetOutputLineCount() const
+{
+  return (outputBufferSptr_ ? outputBufferSptr_->GetLastSequence() : 0) +
+    (logTailerUptr_ ? logTailerUptr_->GetLineCount() : 0);
+}
+
+bool Server::IsReady() const
+{
+  return IsRunning() && startupMonitorSptr_->IsReady();
+}
+
+void Server::SetSeed(const int seed)
+{
+  seed_ = seed;
+  rustDedicatedArguments_.at(seedArgumentIndex_) = std::to_string(seed_);
+}
+
+bool Server::IsRunning() const
+{
+  // we should always have an impl pointer
+  if (!processImplUptr_)
+  {
+    std::cout << "ERROR: Invalid ProcessImpl pointer" << std::endl;
+    return false;
+  }
+  // if we don't have a process pointer, we're not running
+  // this is not an error, so return false silently
+  if (!processImplUptr_->processUptr_) { return false; }
+  // exit is detected by the watcher thread, so just check its flag
+  return !processImplUptr_->HasExited();
+}
+
+std::string Server::SendRconCommand(
+  const std::string& command, const bool waitForResponse
+)
+{
+  if (!IsRunning())
+  {
+    std::cout << "ERROR: Can't send RCON command due to server not running" << std::endl;
+    return std::string();
+  }
+  if (!rconUptr_)
+  {
+    std::cout << "ERROR: Failed to send RCON command due to RCON not available/connected" << std::endl;
+    return std::string();
+  }
+  return rconUptr_->SendCommand(command, waitForResponse ? 10000 : 0);
+}
+
+bool Server::Save(const CancellationToken& cancel)
+{
+  if (!IsRunning() || !rconUptr_ || !rconUptr_->IsConnected())
+  {
+    std::cout << "WARNING: Can't save server because RCON is not available" << std::endl;
+    return false;
+  }
+  std::cout << "Commanding server save via RCON; waiting up to " << saveTimeoutSeconds_ << " second(s) for it to complete" << std::endl;
+  const auto saveWallTime(std::chrono::system_clock::now());
+  const auto saveTime(std::chrono::steady_clock::now());
+  saveTrackerSptr_->Begin();
+  // don't wait for a response, because completion is reported via broadcast
+  SendRconCommand("server.save", false);
+  bool completed(false);
+  {
+    const auto registration(cancel.OnCancel(
+      [tracker = saveTrackerSptr_]() { tracker->Cancel(); }));
+    completed =
+      saveTrackerSptr_->Wait(std::chrono::seconds(saveTimeoutSeconds_));
+  }
+  const double seconds(
+    std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - saveTime).count());
+  long long entities(-1);
+  {
+    std::scoped_lock lock(saveTrackerSptr_->mutex_);
+    entities = saveTrackerSptr_->entities_;
+  }
+  if (completed)
+  {
+    std::cout << "Server save completed in " << seconds << " second(s); entities=" << entities << std::endl;
+  }
+  else if (cancel.IsCancelled())
+  {
+    std::cout << "WARNING: Stopped waiting for server save because it was cancelled" << std::endl;
+  }
+  else
+  {
+    std::cout << "WARNING: Server save did not complete within " << saveTimeoutSeconds_ << " second(s)" << std::endl;
+  }
+  const nlohmann::json record
+  {
+    {"saveTime", History::ToIsoString(saveWallTime)},
+    {"completed", completed},
+    {"seconds", seconds},
+    {"entities", entities < 0 ? nlohmann::json() : nlohmann::json(entities)},
+    {"seed", seed_},
+    {"worldSize", worldSize_}
+  };
+  saveHistorySptr_->Append(record.dump());
+  return completed;
+}
+
+bool Server::Start()
+{
+  if (IsRunning())
+  {
+    std::cout << "WARNING: Can't start server because it's already running" << std::endl;
+    return true;
+  }
+  if (!processImplUptr_)
+  {
+    std::cout << "WARNING: ProcessImpl pointer is invalid" << std::endl;
+    return false;
+  }
+  // normally this has already been done by the caller, but don't lose the
+  //  crash report if not
+  HandleUnexpectedExit();
+  std::error_code errorCode;
+/* NOTE: this mode is disabled because at best it detaches from RLS to the point
+  that I can't seem to kill it
+  if (false)
+  {
+    const auto conPath(boost::process::search_path("conhost.exe"));
+    if (conPath.empty())
+    {
+      std::cout << "ERROR: Failed to find conhost" << std::endl;
+      return false;
+    }
+    std::vector<std::string> args
+    {
+      // "/S", "/C",
+      // "start",
+      // "/D", workingDirectory_,
+      // "/MAX",
+      // "/WAIT",
+      rustDedicatedPath_
+    };
+    args.insert(
+      args.end(),
+      rustDedicatedArguments_.begin(), rustDedicatedArguments_.end()
+    );
+    processImplUptr_->processUptr_ = std::make_unique<boost::process::child>(
+      // boost::process::shell(errorCode),
+      boost::process::exe(conPath),
+      boost::process::args(args),
+      boost::process::start_dir(workingDirectory_),
+      // I/O redirect options and effects w/create group+console
+      // - do nothing: broken scrolling, can't terminate
+      // - close any/all: broken scrolling, can't terminate
+      // - redirect any/all to null: looks OK, can't terminate?
+      // ***could be create new console or process group that broke terminate
+      // boost::process::std_in.close(),
+      // boost::process::std_out.close(),
+      // boost::process::std_err.close(),
+      // I/O redirect options and effects w/create console only
+      // - redirect: looks OK, can't terminate
+      // I/O redirect options and effects w/detached only
+      // - redirect: looks OK, can't terminate
+      // I/O redirect options and effects w/create no window only
+      // - redirect: no window, can't terminate
+      boost::process::std_in  < boost::process::null,
+      boost::process::std_out > boost::process::null,
+      boost::process::std_err > boost::process::null,
+      boost::process::error(errorCode),
+      boost::process::windows::maximized //,
+      // WindowsCreationFlags(
+        // disconnect child process from Ctrl+C signals issued to parent
+        // boost::winapi::CREATE_NEW_PROCESS_GROUP_ |
+        // boost::winapi::CREATE_NO_WINDOW_
+      // )
+    );
+  }
+  else
+  {
+*/
+  // std::cout << "***** ARGS BEGIN:" << std::endl;
+  // for (const auto& arg : rustDedicatedArguments_)
+  // {
+  //   std::cout << "*****\t" << arg << std::endl;
+  // }
+  // std::cout << "***** ARGS END:" << std::endl;
+  auto stdOutReaderSptr(std::make_shared<PipeReader>(
+    outputBufferSptr_, startupMonitorSptr_, saveTrackerSptr_, false));
+  auto stdErrReaderSptr(std::make_shared<PipeReader>(
+    outputBufferSptr_, startupMonitorSptr_, saveTrackerSptr_, true));
+  startupMonitorSptr_->Begin(seed_, worldSize_, environmentProfile_);
+  // start tailing before launch, so that content left over from a previous
+  //  run can be skipped
+  if (logTailerUptr_) { logTailerUptr_->Start(logFilePath_); }
+  processImplUptr_->processUptr_ = std::make_unique<boost::process::child>(
+    boost::process::exe(rustDedicatedPath_.string()),
+    boost::process::args(rustDedicatedArguments_),
+    boost::process::start_dir(workingDirectory_.string()),
+    // I/O redirect options and effects:
+    // - do nothing: server takes over our console and garbles it up
+    // - close any/all: server spams its logs with exceptions
+    // - redirect any/all to null: server logs some things twice
+    // - redirect output to pipes: same as null, but we get to keep it
+    boost::process::std_in  < boost::process::null,
+    boost::process::std_out > stdOutReaderSptr->stream_,
+    boost::process::std_err > stdErrReaderSptr->stream_,
+    boost::process::error(errorCode),
+    processImplUptr_->environment_,
+#if _WIN32
+    WindowsCreationFlags(
+      // disconnect child process from Ctrl+C signals issued to parent
+      boost::winapi::CREATE_NEW_PROCESS_GROUP_
+    ),
+#else
+    NewProcessGroup(),
+#endif
+    *processTuningUptr_,
+    *cgroupUptr_
+  );
+/*
+  }
+*/
+  if (!processImplUptr_->processUptr_)
+  {
+    std::cout << "ERROR: Failed to create server process handle" << std::endl;
+    return false;
+  }
+  if (errorCode)
+  {
+    std::cout << "ERROR: Error creating server process: " << errorCode.message() << std::endl;
+    startupMonitorSptr_->End();
+    processImplUptr_->Reset();
+    return false;
+  }
+  processImplUptr_->Watch();
+  // start draining output pipes right away, so that the server never blocks
+  //  on a full pipe
+  PipeReader::Start(std::move(stdOutReaderSptr));
+  PipeReader::Start(std::move(stdErrReaderSptr));
+  // report any priority settings that didn't take
+  processTuningUptr_->Verify(
+    processImplUptr_->processUptr_->id(), "RustDedicated");
+  cgroupUptr_->Verify(processImplUptr_->processUptr_->id(), "RustDedicated");
+  if (resourceSamplerUptr_)
+  {
+    resourceSamplerUptr_->Start(processImplUptr_->processUptr_->id());
+  }
+  // auto& process(*processImplUptr_->process_);
+  if (!IsRunning())
+  {
+    std::cout << "ERROR: Server failed to launch" << std::endl;
+    ReportCrash();
+    startupMonitorSptr_->End();
+    processImplUptr_->Reset();
+    return false;
+  }
+  std::cout << "Server launched successfully; waiting for it to finish booting" << std::endl;
+  // std::cout
+  //   << "id=" << processImplUptr_->processUptr_->id()
+  //   << ", handle=" << processImplUptr_->processUptr_->native_handle()
+  //   << std::endl;
+  return true;
+}
+
+void Server::Stop(
+  const CancellationToken& cancel, const std::string& reason, const bool hung)
+{
+  if (!IsRunning())
+  {
+    // std::cout << "WARNING: Can't stop server because it's not running" << std::endl;
+    // it may have exited on its own (e.g. during a shutdown countdown)
+    HandleUnexpectedExit();
+    return;
+  }
+  std::cout << "Stop(): Stopping server for reason: " << reason << std::endl;
+  if (!processImplUptr_ || !processImplUptr_->processUptr_)
+  {
+    std::cout << "ERROR: Process handle/impl pointer is null" << std::endl;
+    return;
+  }
+  ProcessImpl& impl(*processImplUptr_);
+  const auto stopWallTime(std::chrono::system_clock::now());
+  const auto stopTime(std::chrono::steady_clock::now());
+  // record the duration of each phase of the shutdown
+  nlohmann::json phases(nlohmann::json::array());
+  auto phaseStartTime(stopTime);
+  const auto endPhase([&phases, &phaseStartTime](const std::string& phase)
+  {
+    const auto now(std::chrono::steady_clock::now());
+    phases.push_back({
+      {"phase", phase},
+      {"seconds", std::chrono::duration<double>(now - phaseStartTime).count()}
+    });
+    phaseStartTime = now;
+  });
+  // TODO: notify Discord someday?
+  if (hung)
+  {
+    std::cout << "WARNING: Server is hung; skipping graceful shutdown" << std::endl;
+#if !_WIN32
+    // the Mono runtime responds to SIGQUIT by writing a dump of all managed
+    //  thread stacks to the console, where the output buffer captures it
+    if (threadDumpSeconds_ && IsRunning())
+    {
+      std::cout << "Requesting server thread dump via SIGQUIT; waiting " << threadDumpSeconds_ << " second(s) for it to be written" << std::endl;
+      impl.Signal(SIGQUIT);
+      impl.WaitForExit(std::chrono::seconds(threadDumpSeconds_));
+      endPhase("threadDump");
+    }
+#endif
+  }
+  else if (rconUptr_ && rconUptr_->IsConnected())
+  {
+    // save explicitly first, so that we can measure how long it takes, and
+    //  so that the quit itself doesn't have much left to do
+    if (saveTimeoutSeconds_ && IsRunning() && !cancel.IsCancelled())
+    {
+      Save(cancel);
+      endPhase("save");
+    }
+    // send RCON quit command and wait for the server to exit
+    std::cout << "Commanding server quit via RCON; waiting up to " << quitTimeoutSeconds_ << " second(s) for it to exit" << std::endl;
+    SendRconCommand("quit", false);
+    if (!impl.WaitForExit(std::chrono::seconds(quitTimeoutSeconds_)))
+    {
+      std::cout << "WARNING: Server did not exit within " << quitTimeoutSeconds_ << " second(s) of quit command" << std::endl;
+    }
+    endPhase("quit");
+  }
+  else
+  {
+    std::cout << "WARNING: RCON is not available; cannot issue shutdown commands" << std::endl;
+  }
+#if !_WIN32
+  // ask the OS to terminate the server, which gives it a chance to clean up
+  if (!hung && IsRunning() && terminateTimeoutSeconds_)
+  {
+    std::cout << "WARNING: Server still running; sending SIGTERM and waiting up to " << terminateTimeoutSeconds_ << " second(s) for it to exit" << std::endl;
+    impl.Signal(SIGTERM);
+    impl.WaitForExit(std::chrono::seconds(terminateTimeoutSeconds_));
+    endPhase("terminate");
+  }
+#endif
+  if (IsRunning())
+  {
+    std::cout << "WARNING: Server still running; performing process kill" << std::endl;
+    impl.Kill();
+    // the kill should be immediate, so anything beyond a few seconds is a
+    //  sign that something is badly wrong
+    if (!impl.WaitForExit(std::chrono::seconds(10)))
+    {
+      std::cout << "ERROR: Server process did not exit after kill; waiting indefinitely" << std::endl;
+    }
+    endPhase("kill");
+  }
+  // this is where we block indefinitely if the kill didn't take, since it's
+  //  unsafe to discard the process handle while it's still running
+  impl.WaitForExit();
+  const int exitCode(impl.processUptr_->exit_code());
+  if (exitCode)
+  {
+    std::cout << "WARNING: Server process returned nonzero exit code: " << exitCode << std::endl;
+  }
+  const nlohmann::json record
+  {
+    {"stopTime", History::ToIsoString(stopWallTime)},
+    {"reason", reason},
+    {"totalSeconds",
+      std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - stopTime).count()},
+    {"phases", phases},
+    {"exitCode", exitCode}
+  };
+  std::cout << "Server shutdown profile: " << record.dump() << std::endl;
+  shutdownHistorySptr_->Append(record.dump());
+  if (hung) { PreserveCrashArtifacts(exitCode); }
+  // record startup profile if the server was stopped before finishing boot
+  startupMonitorSptr_->End();
+  if (resourceSamplerUptr_) { resourceSamplerUptr_->Stop(); }
+  if (logTailerUptr_) { logTailerUptr_->Stop(); }
+  // dump the handle, since we can't re-launch the process at this point
+  impl.Reset();
+}
+
+void Server::HandleUnexpectedExit()
+{
+  if (IsRunning() || !processImplUptr_ || !processImplUptr_->processUptr_)
+  {
+    return;
+  }
+  ReportCrash();
+  startupMonitorSptr_->End();
+  processImplUptr_->Reset();
+}
+
+void Server::ReportCrash() const
+{
+  if (!processImplUptr_ || !processImplUptr_->processUptr_) { return; }
+  const int exitCode(processImplUptr_->processUptr_->exit_code());
+  std::cout << "WARNING: Server process exited with code: " << exitCode << std::endl;
+  PreserveCrashArtifacts(exitCode);
+  if (resourceSamplerUptr_)
+  {
+    std::cout << "***** Server resource usage leading up to exit:" << std::endl;
+    resourceSamplerUptr_->Dump(std::cout);
+    std::cout << "***** End of server resource usage" << std::endl;
+  }
+  if (const auto& events(GetLogEvents()); !events.empty())
+  {
+    std::cout << "***** Server log events:" << std::endl;
+    for (const auto& [name, event] : events)
+    {
+      std::cout << name << ": count=" << event.count_ << ", last=" << event.lastLine_ << std::endl;
+    }
+    std::cout << "***** End of server log events" << std::endl;
+  }
+  if (!outputBufferSptr_) { return; }
+  std::cout << "***** Server output leading up to exit:" << std::endl;
+  outputBufferSptr_->Dump(std::cout);
+  std::cout << "***** End of server output" << std::endl;
+}
+
+void Server::PreserveCrashArtifacts(const int exitCode) const
+{
+  if (!crashArtifactsRetained_) { return; }
+  const std::time_t t(
+    std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+  std::tm tm{};
+#if _MSC_VER
+  localtime_s(&tm, &t);
+#else
+  localtime_r(&t, &tm);
+#endif
+  std::ostringstream name;
+  name << std::put_time(&tm, "%Y%m%d-%H%M%S");
+  const auto path(crashArtifactsPath_ / name.str());
+  std::error_code ec;
+  std::filesystem::create_directories(path, ec);
+  if (ec)
+  {
+    std::cout << "WARNING: Failed to create crash artifacts directory " << path << ": " << ec.message() << std::endl;
+    return;
+  }
+  {
+    std::ofstream summary(path / "summary.txt");
+    summary << "exitCode=" << exitCode << '\n';
+    for (const auto& [eventName, event] : GetLogEvents())
+    {
+      summary << "log." << eventName << ": count=" << event.count_
+              << ", last=" << event.lastLine_ << '\n';
+    }
+  }
+  if (outputBufferSptr_)
+  {
+    std::ofstream output(path / "output.txt");
+    outputBufferSptr_->Dump(output);
+  }
+  if (resourceSamplerUptr_)
+  {
+    std::ofstream resources(path / "resources.txt");
+    resourceSamplerUptr_->Dump(resources);
+  }
+  // the server truncates its log file on launch, so this is the last chance
+  //  to grab it
+  if (!logFilePath_.empty() && std::filesystem::exists(logFilePath_, ec))
+  {
+    std::filesystem::copy_file(
+      logFilePath_, path / logFilePath_.filename(),
+      std::filesystem::copy_options::overwrite_existing, ec);
+    if (ec)
+    {
+      std::cout << "WARNING: Failed to copy server log file " << logFilePath_ << " to crash artifacts directory: " << ec.message() << std::endl;
+    }
+  }
+  std::cout << "Preserved crash artifacts in " << path << std::endl;
+  // prune oldest directories; names sort chronologically
+  std::vector<std::filesystem::path> dirs;
+  for (std::filesystem::directory_iterator it(crashArtifactsPath_, ec), end;
+    !ec && it != end; it.increment(ec))
+  {
+    if (it->is_directory()) { dirs.push_back(it->path()); }
+  }
+  if (dirs.size() <= crashArtifactsRetained_) { return; }
+  std::sort(dirs.begin(), dirs.end());
+  for (std::size_t i(0); i < dirs.size() - crashArtifactsRetained_; ++i)
+  {
+    std::filesystem::remove_all(dirs[i], ec);
+  }
+}
+}
@@ -1,126 +1,323 @@
-#ifndef SERVER_H
-#define SERVER_H
-
-#include <filesystem>
-#include <memory>
-#include <string>
-#include <string_view>
-#include <vector>
-
-namespace rustLaunchSite
-{
-class  Config;
-class  Rcon;
-struct ProcessImpl;
-
-/// @brief rustLaunchSite server management facility
-/// @details Implements use cases and state relating to the management of a
-///  potentially-running dedicated server application instance. Only the
-///  constructor should throw exceptions.
-class Server
-{
-public:
-
-  /// @brief Primary constructor
-  /// @param cfgSptr Shared pointer to application configuration
-  /// @details Starts RCON service immediately.
-  /// @throw @c std::invalid_argument if dedicated server binary or install
-  ///  path are not found, or @c std::runtime_error if RCON facility
-  ///  creation failed
-  explicit Server(std::shared_ptr<const Config> cfgSptr);
-
-  /// @brief Destructor
-  /// @details For some reason this needs to be explicitly declared in order
-  ///  to support having a member @c unique_ptr to a forward-declared type.
-  ~Server();
-
-  /// @brief Server info of interest that can be retrieved via RCON queries
-  struct Info
-  {
-    /// @brief @c true if data valid, @c false if query failed
-    bool valid_{false};
-    /// @brief Number of players currently connected
-    std::size_t players_{0};
-    /// @brief Client-server protocol version
-    std::string protocol_{};
-  };
-
-  /// @brief Query server for various info via RCON
-  /// @details All fields should be populated if validity indicator set.
-  ///  Will immediately fail if server is not running. May block the caller
-  ///  for a period of time to give the server a chance to respond.
-  /// @return Struct containing results
-  Info GetInfo();
-
-  /// @brief Query whether the server is running
-  /// @details This may be based on a cached value. Does not imply that the
-  ///  server is fully started, or that RCON is available. Does not imply
-  ///  that a @c Start() call is needed to (re)start the server.
-  /// @return @c true if the server process is currently running, @c false
-  ///  if it is in a stopped/restart state
-  bool IsRunning() const;
-
-  /// @brief Send RCON command to server, optionally waiting for a response
-  /// @param command RCON console command to send
-  /// @param waitForResponse @c true to block for a limited amount of time
-  ///  while waiting for a response, or @c false to return immediately after
-  ///  sending command
-  /// @return Response message from server, or empty if none due to RCON not
-  ///  available, timeout, error, @c waitForResponse=false etc.
-  std::string SendRconCommand(
-    const std::string& command,
-    const bool waitForResponse
-  );
-
-  /// @brief Start the server
-  /// @details This is a non-blocking call. A successful return value does
-  ///  not guarantee that the server will manage to come all the way up.
-  /// @return @c true if server appeared to launch or is already running,
-  ///  or @c false if an error was detected
-  bool Start();
-
-  /// @brief Stop the server
-  /// @details Blocks until the server shuts down. Attempts a graceful
-  ///  shutdown, but will graduate to more forceful methods if/as needed.
-  ///  The server will not be automatically restarted when stopped via this
-  ///  method, so bringing it back up will require calling @c Start() again.
-  ///  Does nothing if the server is already stopped.
-  /// @param reason Optional shutdown reason, provided to anyone monitoring
-  ///  the server (online players, Discord integrations, etc.)
-  void Stop(const std::string& reason = {});
-
-private:
-
-  // disabled constructors/operators
-
-  Server() = delete;
-  Server(const Server&) = delete;
-  Server& operator= (const Server&) = delete;
-
-  // perform stop delay processing
-  // if a stop delay is configured, loop until it has elapsed, or until all
-  //  players have disconnected (whichever occurs first)
-  void StopDelay(std::string_view reason = {});
-
-  // unique pointer to low-level server process management interface
-  // this is a pointer to an opaque type to avoid leaking a dependency on
-  //  underlying process management API headers
-  std::unique_ptr<ProcessImpl> processImplUptr_;
-  // unique pointer to RCON interface
-  // this is a pointer because it gets allocated and destroyed as the server
-  //  process is started and stopped
-  std::unique_ptr<Rcon> rconUptr_;
-  // ordered list of command-line arugments to be passed to Rust dedicated
-  //  server binary on launch
-  std::vector<std::string> rustDedicatedArguments_;
-  // path to Rust dedicated server binary
-  std::filesystem::path rustDedicatedPath_;
-  // number of seconds to delay server shutdown when users logged on
-  // zero means don't wait even if users are logged on
-  std::size_t stopDelaySeconds_;
-  // path that should be used as working directory when launching server
-  std::filesystem::path workingDirectory_;
-};
-}
-
-#endif // SERVER_H
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "LogTailer.h"
+#include "OutputBuffer.h"
+#include "ResourceSampler.h"
+#include "Telemetry.h"
+
+#include <chrono>
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rustLaunchSite
+{
+class  CancellationToken;
+class  Cgroup;
+class  Config;
+class  History;
+class  ProcessTuning;
+class  Rcon;
+class  StartupMonitor;
+struct ProcessImpl;
+struct SaveTracker;
+
+/// @brief rustLaunchSite server management facility
+/// @details Implements use cases and state relating to the management of a
+///  potentially-running dedicated server application instance. Only the
+///  constructor should throw exceptions.
+class Server
+{
+public:
+
+  /// @brief Primary constructor
+  /// @param cfgSptr Shared pointer to application configuration
+  /// @details Starts RCON service immediately.
+  /// @throw @c std::invalid_argument if dedicated server binary or install
+  ///  path are not found, or @c std::runtime_error if RCON facility
+  ///  creation failed
+  explicit Server(std::shared_ptr<const Config> cfgSptr);
+
+  /// @brief Destructor
+  /// @details For some reason this needs to be explicitly declared in order
+  ///  to support having a member @c unique_ptr to a forward-declared type.
+  ~Server();
+
+  /// @brief Server info of interest that can be retrieved via RCON queries
+  struct Info
+  {
+    /// @brief @c true if data valid, @c false if query failed
+    bool valid_{false};
+    /// @brief Number of players currently connected
+    std::size_t players_{0};
+    /// @brief Number of players waiting in queue
+    std::size_t queued_{0};
+    /// @brief Number of players in the process of joining
+    std::size_t joining_{0};
+    /// @brief Client-server protocol version
+    std::string protocol_{};
+    /// @brief Current server framerate
+    double framerate_{0.0};
+    /// @brief Managed (garbage-collected) memory usage in MB
+    std::size_t memoryMb_{0};
+    /// @brief Process memory usage in MB, as reported by the server
+    std::size_t memoryUsageSystemMb_{0};
+    /// @brief Number of entities in the world
+    std::size_t entityCount_{0};
+    /// @brief Number of garbage collections since server started
+    std::size_t collections_{0};
+    /// @brief Network receive rate
+    std::size_t networkIn_{0};
+    /// @brief Network send rate
+    std::size_t networkOut_{0};
+    /// @brief Number of seconds since server finished booting
+    std::size_t uptimeSeconds_{0};
+  };
+
+  /// @brief Query server for various info via RCON
+  /// @details Player count and protocol should be populated if validity
+  ///  indicator set; other fields are left at zero if not reported.
+  ///  Will immediately fail if server is not running. May block the caller
+  ///  for a period of time to give the server a chance to respond. Valid
+  ///  results are recorded to telemetry history at the configured interval.
+  /// @return Struct containing results
+  Info GetInfo();
+
+  /// @brief Get the most recent lines of console output captured from the
+  ///  server process
+  /// @details Output is captured across (re)launches, so this may include
+  ///  lines from a previous server process instance. Always returns empty if
+  ///  output capture is disabled.
+  /// @param maxLines Maximum number of lines to return, or zero for all
+  ///  lines currently retained
+  /// @return Captured lines, oldest first
+  std::vector<OutputBuffer::Line> GetOutput(std::size_t maxLines = 0) const;
+
+  /// @brief Get counts of notable events (crashes, exceptions, plugin errors
+  ///  etc.) found in the server log file
+  /// @details Counts cover the current server process instance, or the most
+  ///  recent one if the server is not running. Always returns empty if log
+  ///  monitoring is disabled, or no @c -logfile parameter is configured.
+  /// @return Map of event category names to events
+  LogTailer::EventMapType GetLogEvents() const;
+
+  /// @brief Get total number of console output and log file lines the server
+  ///  has produced
+  /// @details Intended for liveness checks: only changes in this value are
+  ///  significant, as it is not reset when the server is relaunched.
+  /// @return Number of lines
+  std::uint64_t GetOutputLineCount() const;
+
+  /// @brief Get the most recent resource usage samples taken of the server
+  ///  process
+  /// @details Samples are retained after the server exits, until it is
+  ///  (re)launched. Always returns empty if resource sampling is disabled or
+  ///  unsupported.
+  /// @param maxSamples Maximum number of samples to return, or zero for all
+  ///  samples currently retained
+  /// @return Resource usage samples, oldest first
+  std::vector<ResourceSampler::Sample> GetResourceSamples(
+    std::size_t maxSamples = 0) const;
+
+  /// @brief Get the most recent server metrics recorded to telemetry history
+  /// @details History spans server (re)launches, and restarts of
+  ///  rustLaunchSite itself. Always returns empty if telemetry is disabled.
+  /// @param maxRecords Maximum number of records to return, or zero for all
+  ///  records currently retained
+  /// @return Telemetry records, oldest first
+  std::vector<Telemetry::Record> GetTelemetry(
+    std::size_t maxRecords = 0) const;
+
+  /// @brief Set the map seed to pass to the server on launch
+  /// @details Must be called before the first @c Start(). Takes effect on the
+  ///  next @c Start().
+  /// @param seed Map seed
+  void SetSeed(int seed);
+
+  /// @brief Get the configured map size
+  /// @return Map size, or zero if not configured
+  int GetWorldSize() const { return worldSize_; }
+
+  /// @brief Query whether the server is running
+  /// @details This may be based on a cached value. Does not imply that the
+  ///  server is fully started, or that RCON is available. Does not imply
+  ///  that a @c Start() call is needed to (re)start the server.
+  /// @return @c true if the server process is currently running, @c false
+  ///  if it is in a stopped/restart state
+  bool IsRunning() const;
+
+  /// @brief Query whether the server has finished booting
+  /// @details Readiness is detected via configured console output markers,
+  ///  or via the first successful @c GetInfo() call if no marker was seen.
+  /// @return @c true if the server is running and has finished booting, or
+  ///  @c false if it is stopped or still booting
+  bool IsReady() const;
+
+  /// @brief Save the server world
+  /// @details Commands the server to save via RCON, and blocks until it
+  ///  reports that the save completed, or until the configured save timeout
+  ///  elapses. The save duration and entity count are appended to the save
+  ///  history file, so that growth can be tracked across a wipe.
+  /// @param cancel Token that stops the wait for completion early
+  /// @return @c true if the save completed, or @c false if RCON is not
+  ///  available, or the save timed out or was cancelled
+  bool Save(const CancellationToken& cancel);
+
+  /// @brief Send RCON command to server, optionally waiting for a response
+  /// @param command RCON console command to send
+  /// @param waitForResponse @c true to block for a limited amount of time
+  ///  while waiting for a response, or @c false to return immediately after
+  ///  sending command
+  /// @return Response message from server, or empty if none due to RCON not
+  ///  available, timeout, error, @c waitForResponse=false etc.
+  std::string SendRconCommand(
+    const std::string& command,
+    const bool waitForResponse
+  );
+
+  /// @brief Start the server
+  /// @details This is a non-blocking call. A successful return value does
+  ///  not guarantee that the server will manage to come all the way up.
+  /// @return @c true if server appeared to launch or is already running,
+  ///  or @c false if an error was detected
+  bool Start();
+
+  /// @brief Stop the server
+  /// @details Blocks until the server shuts down. Attempts a graceful
+  ///  shutdown, but will graduate to more forceful methods if/as needed,
+  ///  each with its own configurable timeout. The world is explicitly saved
+  ///  before commanding the server to quit. Returns as soon as the server
+  ///  process exits, and records the duration of each shutdown phase.
+  ///  The server will not be automatically restarted when stopped via this
+  ///  method, so bringing it back up will require calling @c Start() again.
+  ///  Does nothing if the server is already stopped, except for handling its
+  ///  exit as per @c HandleUnexpectedExit() if that hasn't been done yet.
+  ///  Does not delay for or warn online players; callers should use a
+  ///  @c Countdown for that.
+  ///  If the server is known to be hung, the graceful phases are skipped, as
+  ///  they would only time out; instead, the server is asked to write a
+  ///  thread dump to its console (non-Windows only, if the runtime supports
+  ///  it), and crash artifacts are preserved after it is killed.
+  /// @param cancel Token that skips the wait for the explicit save; the
+  ///  server is still shut down via its quit command
+  /// @param reason Optional shutdown reason, which is logged and recorded in
+  ///  shutdown history
+  /// @param hung @c true if the server is unresponsive and should be killed
+  ///  after capturing diagnostics
+  void Stop(
+    const CancellationToken& cancel, const std::string& reason = {},
+    bool hung = false);
+
+  /// @brief Handle an unexpected exit of the server process
+  /// @details Logs the exit status and what the server wrote to the console
+  ///  right before exiting, preserves crash artifacts (including a copy of
+  ///  the server log file), and then discards the defunct process handle.
+  ///  Should be called as soon as the exit is detected, before anything else
+  ///  touches the server installation (e.g. a relaunch, update or rollback).
+  ///  Does nothing if the server is running, or its exit was already
+  ///  handled (including by @c Stop()).
+  void HandleUnexpectedExit();
+
+private:
+
+  // disabled constructors/operators
+
+  Server() = delete;
+  Server(const Server&) = delete;
+  Server& operator= (const Server&) = delete;
+
+  // log the exit status of a defunct server process, along with whatever it
+  //  wrote to the console right before exiting, and preserve crash artifacts
+  void ReportCrash() const;
+
+  // save console output, resource usage, log events, and a copy of the server
+  //  log file to a new timestamped crash artifacts directory, before they get
+  //  overwritten by a relaunch, and then prune old artifact directories
+  void PreserveCrashArtifacts(int exitCode) const;
+
+  // shared pointer to server console output capture buffer
+  // this is shared with pipe reader threads, which may outlive a server
+  //  process instance; null if output capture is disabled
+  std::shared_ptr<OutputBuffer> outputBufferSptr_;
+  // shared pointer to startup readiness/profiling facility
+  // this is shared with pipe reader threads, which may outlive a server
+  //  process instance
+  std::shared_ptr<StartupMonitor> startupMonitorSptr_;
+  // shared pointer to world save completion tracker
+  // this is shared with pipe reader threads and the RCON message handler
+  std::shared_ptr<SaveTracker> saveTrackerSptr_;
+  // unique pointer to low-level server process management interface
+  // this is a pointer to an opaque type to avoid leaking a dependency on
+  //  underlying process management API headers
+  std::unique_ptr<ProcessImpl> processImplUptr_;
+  // unique pointer to launch-time process priority settings
+  // this is a pointer to avoid leaking process management API headers
+  std::unique_ptr<ProcessTuning> processTuningUptr_;
+  // unique pointer to launch-time cgroup resource isolation facility
+  // this is a pointer to avoid leaking process management API headers
+  std::unique_ptr<Cgroup> cgroupUptr_;
+  // shared pointer to save duration history file
+  std::shared_ptr<History> saveHistorySptr_;
+  // shared pointer to shutdown profile history file
+  std::shared_ptr<History> shutdownHistorySptr_;
+  // unique pointer to server process resource sampler
+  // null if resource sampling is disabled
+  std::unique_ptr<ResourceSampler> resourceSamplerUptr_;
+  // unique pointer to long-term server metrics history
+  // null if telemetry is disabled
+  std::unique_ptr<Telemetry> telemetryUptr_;
+  // minimum time between telemetry records
+  std::chrono::seconds telemetryInterval_;
+  // mutex protecting telemetryTime_, as GetInfo() is called from multiple
+  //  threads (e.g. main and countdown)
+  std::mutex telemetryMutex_;
+  // time at which last telemetry record was added
+  std::chrono::steady_clock::time_point telemetryTime_{};
+  // unique pointer to server log file tailer
+  // null if log monitoring is disabled, or server isn't logging to a file
+  std::unique_ptr<LogTailer> logTailerUptr_;
+  // unique pointer to RCON interface
+  // this is a pointer because it gets allocated and destroyed as the server
+  //  process is started and stopped
+  std::unique_ptr<Rcon> rconUptr_;
+  // ordered list of command-line arugments to be passed to Rust dedicated
+  //  server binary on launch
+  std::vector<std::string> rustDedicatedArguments_;
+  // name of configured launch environment profile, or empty if none
+  std::string environmentProfile_;
+  // path to server log file, or empty if not configured
+  std::filesystem::path logFilePath_;
+  // path to Rust dedicated server binary
+  std::filesystem::path rustDedicatedPath_;
+  // map seed passed to server
+  int seed_;
+  // index of map seed value in launch arguments
+  std::size_t seedArgumentIndex_{0};
+  // map size passed to server, or zero if not configured
+  int worldSize_;
+  // number of seconds to wait for server to save before RCON quit command
+  // zero means skip the explicit save
+  std::size_t saveTimeoutSeconds_;
+  // number of seconds to wait for server to exit after RCON quit command
+  std::size_t quitTimeoutSeconds_;
+  // number of seconds to wait for server to exit after SIGTERM (non-Windows)
+  // zero means skip straight to SIGKILL
+  std::size_t terminateTimeoutSeconds_;
+  // path that should be used as working directory when launching server
+  std::filesystem::path workingDirectory_;
+  // directory under which crash artifacts are preserved
+  std::filesystem::path crashArtifactsPath_;
+  // number of crash artifact directories to retain; zero disables
+  std::size_t crashArtifactsRetained_;
+  // number of seconds to wait for a hung server to write a thread dump
+  // zero means don't request one
+  std::size_t threadDumpSeconds_;
+};
+}
+
+#endif // SERVER_H
@@ -0,0 +1,154 @@
+#include "ServerState.h"
+
+#include <cstdint>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+using State = rustLaunchSite::ServerState::State;
+
+// get the bit representing a state in a transition mask
+constexpr std::uint16_t Bit(const State state)
+{
+  return static_cast<std::uint16_t>(1u << static_cast<unsigned>(state));
+}
+
+// states each state may transition to, indexed by state
+constexpr std::array<std::uint16_t, rustLaunchSite::ServerState::STATE_COUNT>
+  TRANSITIONS
+{
+  // STOPPED
+  Bit(State::UPDATING) | Bit(State::STARTING),
+  // UPDATING
+  Bit(State::STARTING) | Bit(State::STOPPED),
+  // STARTING
+  Bit(State::BOOTING) | Bit(State::STOPPED),
+  // BOOTING
+  Bit(State::READY) | Bit(State::DRAINING) | Bit(State::STOPPING) |
+    Bit(State::CRASHED),
+  // READY
+  Bit(State::DRAINING) | Bit(State::STOPPING) | Bit(State::CRASHED),
+  // DRAINING
+  Bit(State::STOPPING),
+  // STOPPING
+  Bit(State::STOPPED) | Bit(State::CRASHED),
+  // CRASHED
+  Bit(State::BACKOFF) | Bit(State::UPDATING) | Bit(State::STARTING) |
+    Bit(State::STOPPED),
+  // BACKOFF
+  Bit(State::STARTING) | Bit(State::STOPPED)
+};
+
+// convert a duration to (fractional) seconds
+double ToSeconds(const rustLaunchSite::ServerState::Clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+}
+
+namespace rustLaunchSite
+{
+ServerState::ServerState(std::filesystem::path historyPath)
+  : history_(std::move(historyPath))
+  , startTime_(Clock::now())
+  , enteredTime_(startTime_)
+{
+}
+
+void ServerState::SetListener(Listener listener)
+{
+  std::scoped_lock lock(mutex_);
+  listener_ = std::move(listener);
+}
+
+bool ServerState::Transition(const State state, const std::string& reason)
+{
+  std::scoped_lock lock(mutex_);
+  if (state == state_) { return true; }
+  const auto from(state_);
+  if (!(TRANSITIONS[static_cast<std::size_t>(from)] & Bit(state)))
+  {
+    std::cout << "WARNING: Rejected invalid server state transition from " << ToString(from) << " to " << ToString(state) << std::endl;
+    return false;
+  }
+  const auto now(Clock::now());
+  const auto duration(now - enteredTime_);
+  totals_[static_cast<std::size_t>(from)] += duration;
+  state_ = state;
+  enteredTime_ = now;
+  const auto seconds(std::chrono::round<std::chrono::seconds>(duration));
+  std::cout << "Server state: " << ToString(from) << " -> " << ToString(state) << " after " << seconds.count() << " second(s)" << (reason.empty() ? "" : " (" + reason + ")") << std::endl;
+  const nlohmann::json record
+  {
+    {"time", History::ToIsoString(std::chrono::system_clock::now())},
+    {"from", ToString(from)},
+    {"to", ToString(state)},
+    {"seconds", ToSeconds(duration)},
+    {"reason", reason}
+  };
+  history_.Append(record.dump());
+  if (listener_) { listener_(from, state); }
+  return true;
+}
+
+ServerState::State ServerState::GetState() const
+{
+  std::scoped_lock lock(mutex_);
+  return state_;
+}
+
+ServerState::Clock::duration ServerState::GetTimeInState() const
+{
+  std::scoped_lock lock(mutex_);
+  return Clock::now() - enteredTime_;
+}
+
+ServerState::Clock::duration ServerState::GetTotalTime(
+  const State state) const
+{
+  std::scoped_lock lock(mutex_);
+  auto total(totals_[static_cast<std::size_t>(state)]);
+  if (state == state_) { total += Clock::now() - enteredTime_; }
+  return total;
+}
+
+double ServerState::GetAvailability() const
+{
+  std::scoped_lock lock(mutex_);
+  const auto now(Clock::now());
+  const auto elapsed(now - startTime_);
+  if (elapsed.count() <= 0) { return 0.0; }
+  auto available(
+    totals_[static_cast<std::size_t>(State::READY)] +
+    totals_[static_cast<std::size_t>(State::DRAINING)]);
+  if (state_ == State::READY || state_ == State::DRAINING)
+  {
+    available += now - enteredTime_;
+  }
+  return ToSeconds(available) / ToSeconds(elapsed);
+}
+
+bool ServerState::IsUp(const State state)
+{
+  return state == State::BOOTING || state == State::READY ||
+    state == State::DRAINING;
+}
+
+std::string ServerState::ToString(const State state)
+{
+  switch (state)
+  {
+    case State::STOPPED:  return "Stopped";
+    case State::UPDATING: return "Updating";
+    case State::STARTING: return "Starting";
+    case State::BOOTING:  return "Booting";
+    case State::READY:    return "Ready";
+    case State::DRAINING: return "Draining";
+    case State::STOPPING: return "Stopping";
+    case State::CRASHED:  return "Crashed";
+    case State::BACKOFF:  return "Backoff";
+  }
+  return "Unknown";
+}
+}
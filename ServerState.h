@@ -0,0 +1,131 @@
+#ifndef SERVER_STATE_H
+#define SERVER_STATE_H
+
+#include "History.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace rustLaunchSite
+{
+/// @brief Server lifecycle state machine
+/// @details Tracks which stage of its lifecycle the server is in, as driven
+///  by rustLaunchSite: a server is updated and started, boots until it's
+///  ready for players, is drained of players by a shutdown countdown, and is
+///  stopped, or crashes and is relaunched (after a backoff delay if it keeps
+///  crashing). Only the transitions listed in the state descriptions below
+///  are allowed; anything else is rejected and logged, as it indicates a bug.
+///  The time spent in each state is accumulated, in order to account for
+///  availability, and each transition is appended to a history file along
+///  with how long the previous state lasted. A listener can be notified of
+///  transitions (e.g. to pause jobs while the server is down). All methods
+///  are thread-safe. Should not throw any exceptions.
+class ServerState
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Lifecycle state, and the states it may transition to
+  enum class State
+  {
+    STOPPED,  // not running; -> UPDATING, STARTING
+    UPDATING, // installing updates; -> STARTING, STOPPED
+    STARTING, // launching process; -> BOOTING, STOPPED
+    BOOTING,  // running, but not ready; -> READY, DRAINING, STOPPING, CRASHED
+    READY,    // ready for players; -> DRAINING, STOPPING, CRASHED
+    DRAINING, // shutdown countdown in progress; -> STOPPING
+    STOPPING, // being stopped; -> STOPPED, CRASHED
+    CRASHED,  // stopped unexpectedly; -> BACKOFF, UPDATING, STARTING, STOPPED
+    BACKOFF   // waiting to relaunch after crash looping; -> STARTING, STOPPED
+  };
+
+  /// @brief Number of states
+  static constexpr std::size_t STATE_COUNT{9};
+
+  /// @brief Transition listener
+  /// @details Invoked with the previous and new state.
+  using Listener = std::function<void(State, State)>;
+
+  /// @brief Primary constructor
+  /// @details Starts out in the @c STOPPED state.
+  /// @param historyPath Path to state transition history file
+  explicit ServerState(std::filesystem::path historyPath);
+
+  /// @brief Set the transition listener
+  /// @details The listener is invoked on the thread that made the transition,
+  ///  while holding an internal lock, so it must be quick and must not call
+  ///  back into this.
+  /// @param listener Listener to invoke on each transition, or null for none
+  void SetListener(Listener listener);
+
+  /// @brief Transition to a new state
+  /// @details Does nothing if already in that state.
+  /// @param state State to transition to
+  /// @param reason Human-readable reason, logged and recorded in history
+  /// @return @c true if now in the requested state, or @c false if the
+  ///  transition isn't allowed
+  bool Transition(State state, const std::string& reason = {});
+
+  /// @brief Get the current state
+  /// @return Current state
+  State GetState() const;
+
+  /// @brief Get how long the server has been in the current state
+  /// @return Time since last transition
+  Clock::duration GetTimeInState() const;
+
+  /// @brief Get how long the server has spent in a given state in total
+  /// @param state State to query
+  /// @return Cumulative time spent in state since construction, including
+  ///  the current stint if it's the current state
+  Clock::duration GetTotalTime(State state) const;
+
+  /// @brief Get the fraction of time the server has been available
+  /// @details The server is considered available while it's @c READY or
+  ///  @c DRAINING, as players can play in both.
+  /// @return Fraction of time since construction, from 0 to 1
+  double GetAvailability() const;
+
+  /// @brief Query whether the server process is expected to be up in a
+  ///  given state
+  /// @param state State to query
+  /// @return @c true for @c BOOTING, @c READY and @c DRAINING
+  static bool IsUp(State state);
+
+  /// @brief Get the name of a state
+  /// @param state State to name
+  /// @return Title-case name (e.g. @c Ready)
+  static std::string ToString(State state);
+
+private:
+
+  // disabled constructors/operators
+
+  ServerState() = delete;
+  ServerState(const ServerState&) = delete;
+  ServerState& operator= (const ServerState&) = delete;
+
+  // state transition history file
+  History history_;
+  // mutex protecting everything below
+  mutable std::mutex mutex_;
+  // transition listener
+  Listener listener_;
+  // current state
+  State state_{State::STOPPED};
+  // time of construction
+  Clock::time_point startTime_;
+  // time of last transition
+  Clock::time_point enteredTime_;
+  // cumulative time spent in each state, excluding the current stint
+  std::array<Clock::duration, STATE_COUNT> totals_{};
+};
+}
+
+#endif // SERVER_STATE_H
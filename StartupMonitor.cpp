@@ -0,0 +1,179 @@
+#include "StartupMonitor.h"
+
+#include "History.h"
+
+#include <algorithm>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+// seconds between two time points, as a double
+template<typename T>
+double Seconds(const T& from, const T& to)
+{
+  return std::chrono::duration<double>(to - from).count();
+}
+
+std::string_view ToString(const rustLaunchSite::StartupMonitor::ReadyMethod m)
+{
+  switch (m)
+  {
+    case rustLaunchSite::StartupMonitor::ReadyMethod::NONE:   return "none";
+    case rustLaunchSite::StartupMonitor::ReadyMethod::MARKER: return "marker";
+    case rustLaunchSite::StartupMonitor::ReadyMethod::RCON:   return "rcon";
+  }
+  return {};
+}
+}
+
+namespace rustLaunchSite
+{
+StartupMonitor::StartupMonitor(
+  std::vector<std::string> readyMarkers,
+  PhaseMarkerMapType phaseMarkers,
+  std::shared_ptr<History> historySptr
+)
+  : readyMarkers_(std::move(readyMarkers))
+  , phaseMarkers_(std::move(phaseMarkers))
+  , historySptr_(std::move(historySptr))
+{
+}
+
+StartupMonitor::~StartupMonitor() = default;
+
+void StartupMonitor::Begin(
+  const int seed, const int worldSize, const std::string& environment)
+{
+  std::scoped_lock lock(mutex_);
+  persisted_ = false;
+  readyMethod_ = ReadyMethod::NONE;
+  seed_ = seed;
+  worldSize_ = worldSize;
+  environment_ = environment;
+  launchWallTime_ = std::chrono::system_clock::now();
+  launchTime_ = Clock::now();
+  firstOutputTime_ = {};
+  readyTime_ = {};
+  phaseStarts_.clear();
+  protocol_.clear();
+  version_ = 0;
+  ready_ = false;
+  active_ = true;
+}
+
+void StartupMonitor::ProcessLine(std::string_view line)
+{
+  // this is called for every line the server ever writes, so bail out as
+  //  cheaply as possible once boot is complete
+  if (!active_ || ready_) { return; }
+  const auto now(Clock::now());
+  std::scoped_lock lock(mutex_);
+  if (!active_ || ready_) { return; }
+  if (firstOutputTime_ == Clock::time_point{}) { firstOutputTime_ = now; }
+  // a phase starts the first time any of its markers is seen
+  for (const auto& [phase, markers] : phaseMarkers_)
+  {
+    if (std::any_of(
+      phaseStarts_.begin(), phaseStarts_.end(),
+      [&phase](const auto& p) { return p.first == phase; }
+    ))
+    {
+      continue;
+    }
+    if (std::any_of(
+      markers.begin(), markers.end(),
+      [line](const std::string& m) { return line.find(m) != line.npos; }
+    ))
+    {
+      phaseStarts_.emplace_back(phase, now);
+    }
+  }
+  if (std::any_of(
+    readyMarkers_.begin(), readyMarkers_.end(),
+    [line](const std::string& m) { return line.find(m) != line.npos; }
+  ))
+  {
+    SetReady(ReadyMethod::MARKER);
+  }
+}
+
+void StartupMonitor::ProcessServerInfo(
+  const std::string& protocol, const int version)
+{
+  std::scoped_lock lock(mutex_);
+  if (!active_ || persisted_) { return; }
+  protocol_ = protocol;
+  version_ = version;
+  if (!ready_)
+  {
+    SetReady(ReadyMethod::RCON);
+  }
+  Persist();
+}
+
+void StartupMonitor::End()
+{
+  std::scoped_lock lock(mutex_);
+  if (!active_) { return; }
+  if (!persisted_) { Persist(); }
+  active_ = false;
+}
+
+bool StartupMonitor::IsReady() const
+{
+  return ready_;
+}
+
+void StartupMonitor::SetReady(const ReadyMethod method)
+{
+  readyMethod_ = method;
+  readyTime_ = Clock::now();
+  ready_ = true;
+  std::cout << "Server ready after " << static_cast<int>(Seconds(launchTime_, readyTime_)) << " second(s) (detected via " << ToString(method) << ")" << std::endl;
+}
+
+void StartupMonitor::Persist()
+{
+  persisted_ = true;
+  // boot is considered to have ended at readiness, or now if it never came
+  const Clock::time_point endTime(ready_ ? readyTime_ : Clock::now());
+  // phases are recorded as an array in order to preserve their ordering
+  nlohmann::json phases(nlohmann::json::array());
+  // time from launch until the first phase marker
+  phases.push_back({
+    {"phase", "launch"},
+    {"seconds", Seconds(launchTime_,
+      phaseStarts_.empty() ? endTime : phaseStarts_.front().second)}
+  });
+  // each phase lasts until the next one starts, or until boot ends
+  for (std::size_t i(0); i < phaseStarts_.size(); ++i)
+  {
+    const auto& [phase, startTime] = phaseStarts_[i];
+    const auto& phaseEndTime(
+      i + 1 < phaseStarts_.size() ? phaseStarts_[i + 1].second : endTime);
+    phases.push_back({
+      {"phase", phase}, {"seconds", Seconds(startTime, phaseEndTime)}
+    });
+  }
+  nlohmann::json record
+  {
+    {"launchTime", History::ToIsoString(launchWallTime_)},
+    {"ready", ready_.load()},
+    {"readyMethod", ToString(readyMethod_)},
+    {"totalSeconds", Seconds(launchTime_, endTime)},
+    {"firstOutputSeconds",
+      firstOutputTime_ == Clock::time_point{} ?
+        nlohmann::json() : nlohmann::json(Seconds(launchTime_, firstOutputTime_))},
+    {"phases", phases},
+    {"seed", seed_},
+    {"worldSize", worldSize_},
+    {"environment",
+      environment_.empty() ? nlohmann::json() : nlohmann::json(environment_)},
+    {"protocol", protocol_},
+    {"version", version_}
+  };
+  std::cout << "Server startup profile: " << record.dump() << std::endl;
+  if (historySptr_) { historySptr_->Append(record.dump()); }
+}
+}
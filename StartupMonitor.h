@@ -0,0 +1,138 @@
+#ifndef STARTUPMONITOR_H
+#define STARTUPMONITOR_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rustLaunchSite
+{
+class History;
+
+/// @brief Server startup readiness detection and boot profiling facility
+/// @details Watches server console output for configurable marker strings in
+///  order to determine when the server has finished booting, and to break the
+///  boot down into phases (asset loading, world generation/loading, plugin
+///  loading, etc.). A successful RCON query can also be reported in order to
+///  detect readiness when no ready marker is seen. One record is appended to
+///  the startup history file per launch. All methods are thread-safe. Should
+///  not throw any exceptions.
+class StartupMonitor
+{
+public:
+
+  /// @brief Map of boot phase names to console output markers indicating
+  ///  that the phase has started
+  using PhaseMarkerMapType = std::map<std::string, std::vector<std::string>>;
+
+  /// @brief How readiness was detected
+  enum class ReadyMethod { NONE, MARKER, RCON };
+
+  /// @brief Primary constructor
+  /// @param readyMarkers Console output substrings indicating that the
+  ///  server has finished booting
+  /// @param phaseMarkers Console output substrings indicating that each boot
+  ///  phase has started
+  /// @param historySptr Startup history file facility, or null to disable
+  ///  persistence of startup records
+  StartupMonitor(
+    std::vector<std::string> readyMarkers,
+    PhaseMarkerMapType phaseMarkers,
+    std::shared_ptr<History> historySptr
+  );
+
+  /// @brief Destructor
+  ~StartupMonitor();
+
+  /// @brief Begin tracking a new server launch
+  /// @details Discards state from any previous launch; callers should call
+  ///  @c End() first if they want its record persisted.
+  /// @param seed Map seed the server is being launched with
+  /// @param worldSize Map size the server is being launched with, or zero if
+  ///  not known
+  /// @param environment Name of launch environment profile the server is
+  ///  being launched with, or empty if none
+  void Begin(int seed, int worldSize, const std::string& environment = {});
+
+  /// @brief Process a line of server console output
+  /// @details Cheap no-op once the server is ready or no launch is active.
+  /// @param line Line of console output
+  void ProcessLine(std::string_view line);
+
+  /// @brief Report a successful RCON server info query
+  /// @details Marks the server as ready if no ready marker has been seen, and
+  ///  records the protocol/version for the startup record, which is then
+  ///  persisted if the server is ready.
+  /// @param protocol Client-server protocol reported by server
+  /// @param version Server version number reported by server
+  void ProcessServerInfo(const std::string& protocol, int version);
+
+  /// @brief Stop tracking the current launch
+  /// @details Persists the startup record if this hasn't happened yet, even
+  ///  if the server never became ready (e.g. because it crashed or was
+  ///  stopped during boot). Does nothing if no launch is active.
+  void End();
+
+  /// @brief Query whether the server has finished booting
+  /// @return @c true if readiness has been detected for the current launch
+  bool IsReady() const;
+
+private:
+
+  // mark current launch as ready
+  // must be called under mutex lock
+  void SetReady(ReadyMethod method);
+
+  // log the startup breakdown and append it to the history file
+  // must be called under mutex lock
+  void Persist();
+
+  // disabled constructors/operators
+
+  StartupMonitor() = delete;
+  StartupMonitor(const StartupMonitor&) = delete;
+  StartupMonitor& operator= (const StartupMonitor&) = delete;
+
+  using Clock = std::chrono::steady_clock;
+
+  // configured markers
+  std::vector<std::string> readyMarkers_;
+  PhaseMarkerMapType phaseMarkers_;
+  // startup history file facility (may be null)
+  std::shared_ptr<History> historySptr_;
+  // mutex protecting everything below
+  mutable std::mutex mutex_;
+  // whether a launch is being tracked
+  // atomic so that lines can be skipped without locking once boot is complete
+  std::atomic<bool> active_{false};
+  // whether readiness has been detected
+  std::atomic<bool> ready_{false};
+  // whether the record for the current launch has been persisted
+  bool persisted_{false};
+  // how readiness was detected
+  ReadyMethod readyMethod_{ReadyMethod::NONE};
+  // launch parameters
+  int seed_{0};
+  int worldSize_{0};
+  std::string environment_{};
+  // launch time in both clocks (wall clock for record, steady for durations)
+  std::chrono::system_clock::time_point launchWallTime_{};
+  Clock::time_point launchTime_{};
+  // time of first output line
+  Clock::time_point firstOutputTime_{};
+  // time readiness was detected
+  Clock::time_point readyTime_{};
+  // phase start times, in the order phases were first seen
+  std::vector<std::pair<std::string, Clock::time_point>> phaseStarts_;
+  // info reported via RCON
+  std::string protocol_;
+  int version_{0};
+};
+}
+
+#endif // STARTUPMONITOR_H
@@ -0,0 +1,412 @@
+#include "Telemetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+
+namespace
+{
+// spill file header: magic string, followed by format version and column
+//  count bytes
+constexpr std::string_view SPILL_MAGIC{"RLSTLM"};
+constexpr std::uint8_t SPILL_VERSION{1};
+
+// map signed deltas to unsigned values such that small magnitudes (of either
+//  sign) become small numbers
+std::uint64_t ZigZag(const std::int64_t v)
+{
+  return (static_cast<std::uint64_t>(v) << 1) ^
+    static_cast<std::uint64_t>(v >> 63);
+}
+
+std::int64_t UnZigZag(const std::uint64_t v)
+{
+  return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+// append an unsigned value using 7 bits per byte, low bits first
+void PutVarint(std::vector<std::uint8_t>& data, std::uint64_t v)
+{
+  while (v >= 0x80)
+  {
+    data.push_back(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  data.push_back(static_cast<std::uint8_t>(v));
+}
+
+// read a value written by `PutVarint()`, advancing `pos`
+// returns false if data ends mid-value or value is too long
+bool GetVarint(
+  const std::vector<std::uint8_t>& data, std::size_t& pos, std::uint64_t& v)
+{
+  v = 0;
+  for (unsigned shift(0); shift < 64 && pos < data.size(); shift += 7)
+  {
+    const std::uint8_t byte(data[pos++]);
+    v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) { return true; }
+  }
+  return false;
+}
+
+// little-endian 32-bit integer I/O for spill file block headers
+void PutU32(std::ostream& os, const std::uint32_t v)
+{
+  for (unsigned shift(0); shift < 32; shift += 8)
+  {
+    os.put(static_cast<char>((v >> shift) & 0xFF));
+  }
+}
+
+bool GetU32(std::istream& is, std::uint32_t& v)
+{
+  v = 0;
+  for (unsigned shift(0); shift < 32; shift += 8)
+  {
+    const auto c(is.get());
+    if (c == std::istream::traits_type::eof()) { return false; }
+    v |= static_cast<std::uint32_t>(c & 0xFF) << shift;
+  }
+  return true;
+}
+
+// convert a size to a signed column value
+std::int64_t ToInt(const std::size_t v)
+{
+  return static_cast<std::int64_t>(
+    std::min<std::size_t>(v, static_cast<std::size_t>(INT64_MAX)));
+}
+
+// convert a signed column value to a size
+std::size_t ToSize(const std::int64_t v)
+{
+  return v < 0 ? 0 : static_cast<std::size_t>(v);
+}
+}
+
+namespace rustLaunchSite
+{
+Telemetry::Telemetry(
+  const std::size_t capacity, std::filesystem::path spillPath
+)
+  : capacity_(std::max(capacity, BLOCK_RECORDS))
+  , spillPath_(std::move(spillPath))
+{
+  spillPath_.make_preferred();
+  open_.reserve(BLOCK_RECORDS);
+  std::scoped_lock lock(mutex_);
+  Load();
+}
+
+Telemetry::~Telemetry()
+{
+  std::scoped_lock lock(mutex_);
+  if (!open_.empty()) { Seal(); }
+}
+
+void Telemetry::Add(const Record& record)
+{
+  std::scoped_lock lock(mutex_);
+  open_.push_back(ToRow(record));
+  if (open_.size() >= BLOCK_RECORDS) { Seal(); }
+  else { Trim(); }
+}
+
+std::vector<Telemetry::Record> Telemetry::GetRecords(
+  const std::size_t maxRecords) const
+{
+  std::vector<Row> rows;
+  {
+    std::scoped_lock lock(mutex_);
+    const std::size_t size(blockRecords_ + open_.size());
+    const std::size_t wanted(
+      maxRecords ? std::min(maxRecords, size) : size);
+    rows.reserve(wanted + BLOCK_RECORDS);
+    // only decode blocks that contain wanted records
+    std::size_t skip(size - wanted);
+    auto it(blocks_.begin());
+    for (; it != blocks_.end() && skip >= it->count_; ++it)
+    {
+      skip -= it->count_;
+    }
+    for (; it != blocks_.end(); ++it) { Decode(*it, rows); }
+    rows.insert(rows.end(), open_.begin(), open_.end());
+    // discard leading records from first decoded block that weren't wanted
+    rows.erase(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(
+      std::min(skip, rows.size())));
+  }
+  std::vector<Record> retVal;
+  retVal.reserve(rows.size());
+  for (const auto& row : rows) { retVal.push_back(FromRow(row)); }
+  return retVal;
+}
+
+std::size_t Telemetry::GetSize() const
+{
+  std::scoped_lock lock(mutex_);
+  return blockRecords_ + open_.size();
+}
+
+std::size_t Telemetry::GetStorageBytes() const
+{
+  std::scoped_lock lock(mutex_);
+  std::size_t retVal(open_.capacity() * sizeof(Row));
+  for (const auto& block : blocks_)
+  {
+    retVal += sizeof(Block) + block.data_.capacity();
+  }
+  return retVal;
+}
+
+Telemetry::Row Telemetry::ToRow(const Record& record)
+{
+  return
+  {
+    std::chrono::duration_cast<std::chrono::seconds>(
+      record.time_.time_since_epoch()).count(),
+    ToInt(record.players_),
+    ToInt(record.queued_),
+    ToInt(record.joining_),
+    ToInt(record.entityCount_),
+    std::llround(record.framerate_ * 10),
+    ToInt(record.memoryMb_),
+    ToInt(record.memoryUsageSystemMb_),
+    ToInt(record.collections_),
+    ToInt(record.networkIn_),
+    ToInt(record.networkOut_),
+    ToInt(record.uptimeSeconds_),
+    ToInt(record.cpuThrottledUsec_),
+    ToInt(record.memoryHighEvents_),
+    ToInt(record.oomKills_),
+    ToInt(record.memoryStallUsec_)
+  };
+}
+
+Telemetry::Record Telemetry::FromRow(const Row& row)
+{
+  Record record;
+  record.time_ = std::chrono::system_clock::time_point(
+    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+      std::chrono::seconds(row[0])));
+  record.players_ = ToSize(row[1]);
+  record.queued_ = ToSize(row[2]);
+  record.joining_ = ToSize(row[3]);
+  record.entityCount_ = ToSize(row[4]);
+  record.framerate_ = static_cast<double>(row[5]) / 10;
+  record.memoryMb_ = ToSize(row[6]);
+  record.memoryUsageSystemMb_ = ToSize(row[7]);
+  record.collections_ = ToSize(row[8]);
+  record.networkIn_ = ToSize(row[9]);
+  record.networkOut_ = ToSize(row[10]);
+  record.uptimeSeconds_ = ToSize(row[11]);
+  record.cpuThrottledUsec_ = ToSize(row[12]);
+  record.memoryHighEvents_ = ToSize(row[13]);
+  record.oomKills_ = ToSize(row[14]);
+  record.memoryStallUsec_ = ToSize(row[15]);
+  return record;
+}
+
+Telemetry::Block Telemetry::Encode(const std::vector<Row>& rows)
+{
+  Block block;
+  block.count_ = static_cast<std::uint32_t>(rows.size());
+  // column-major, so that each column's deltas sit together; most metrics
+  //  change little from one record to the next, so most deltas fit in a
+  //  single byte
+  for (std::size_t column(0); column < COLUMNS; ++column)
+  {
+    std::int64_t previous(0);
+    for (const auto& row : rows)
+    {
+      // wrapping subtraction, so that extreme values round-trip exactly
+      PutVarint(block.data_, ZigZag(static_cast<std::int64_t>(
+        static_cast<std::uint64_t>(row[column]) -
+        static_cast<std::uint64_t>(previous))));
+      previous = row[column];
+    }
+  }
+  block.data_.shrink_to_fit();
+  return block;
+}
+
+bool Telemetry::Decode(
+  const Block& block, std::vector<Row>& rows, const std::size_t columns)
+{
+  const std::size_t first(rows.size());
+  rows.resize(first + block.count_, Row{});
+  std::size_t pos(0);
+  for (std::size_t column(0); column < std::min(columns, COLUMNS); ++column)
+  {
+    std::int64_t previous(0);
+    for (std::size_t i(0); i < block.count_; ++i)
+    {
+      std::uint64_t v(0);
+      if (!GetVarint(block.data_, pos, v))
+      {
+        rows.resize(first);
+        return false;
+      }
+      previous = static_cast<std::int64_t>(
+        static_cast<std::uint64_t>(previous) +
+        static_cast<std::uint64_t>(UnZigZag(v)));
+      rows[first + i][column] = previous;
+    }
+  }
+  return true;
+}
+
+void Telemetry::Seal()
+{
+  blocks_.push_back(Encode(open_));
+  blockRecords_ += open_.size();
+  open_.clear();
+  Spill(blocks_.back());
+  Trim();
+}
+
+void Telemetry::Trim()
+{
+  while (!blocks_.empty() && blockRecords_ + open_.size() > capacity_)
+  {
+    blockRecords_ -= blocks_.front().count_;
+    blocks_.pop_front();
+  }
+}
+
+void Telemetry::Load()
+{
+  if (spillPath_.empty()) { return; }
+  std::ifstream file(spillPath_, std::ios::binary);
+  if (!file.is_open()) { return; }
+  std::string magic(SPILL_MAGIC.size(), '\0');
+  file.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+  const auto version(file.get());
+  const auto columns(file.get());
+  if (!file || magic != SPILL_MAGIC || version != SPILL_VERSION ||
+    columns <= 0 || columns > static_cast<int>(COLUMNS))
+  {
+    std::cout << "WARNING: Ignoring telemetry spill file " << spillPath_ << " due to unrecognized format; it will be overwritten" << std::endl;
+    // force a rewrite on first spill
+    spilledBlocks_ = SIZE_MAX;
+    return;
+  }
+  const bool convert(columns != static_cast<int>(COLUMNS));
+  // a partially-written last block (e.g. due to power loss) is discarded
+  bool torn(false);
+  Block block;
+  for (std::uint32_t length(0);
+    file.peek() != std::ifstream::traits_type::eof();)
+  {
+    if (!GetU32(file, block.count_) || !GetU32(file, length))
+    {
+      torn = true;
+      break;
+    }
+    block.data_.resize(length);
+    if (!file.read(
+      reinterpret_cast<char*>(block.data_.data()),
+      static_cast<std::streamsize>(length)))
+    {
+      torn = true;
+      break;
+    }
+    ++spilledBlocks_;
+    // convert blocks from older files that have fewer metrics
+    if (convert)
+    {
+      std::vector<Row> rows;
+      if (!Decode(block, rows, static_cast<std::size_t>(columns)))
+      {
+        torn = true;
+        break;
+      }
+      block = Encode(rows);
+    }
+    blockRecords_ += block.count_;
+    blocks_.push_back(std::move(block));
+    block = {};
+    // trim as we go, so that a huge file doesn't balloon memory usage
+    Trim();
+  }
+  // force a rewrite on first spill, so that formats aren't mixed, and so that
+  //  blocks aren't appended after unreadable ones, where the next load would
+  //  never get to them
+  if (torn)
+  {
+    std::cout << "WARNING: Discarding unreadable trailing data from telemetry spill file " << spillPath_ << "; it will be rewritten" << std::endl;
+  }
+  if (convert || torn) { spilledBlocks_ = SIZE_MAX; }
+}
+
+void Telemetry::Spill(const Block& block)
+{
+  if (spillPath_.empty()) { return; }
+  if (
+    std::error_code ec{};
+    spillPath_.has_parent_path() &&
+    !std::filesystem::create_directories(spillPath_.parent_path(), ec) && ec
+  )
+  {
+    std::cout << "WARNING: Failed to create telemetry directory " << spillPath_.parent_path() << ": " << ec.message() << std::endl;
+    return;
+  }
+  const auto writeBlock([](std::ostream& os, const Block& b)
+  {
+    PutU32(os, b.count_);
+    PutU32(os, static_cast<std::uint32_t>(b.data_.size()));
+    os.write(
+      reinterpret_cast<const char*>(b.data_.data()),
+      static_cast<std::streamsize>(b.data_.size()));
+  });
+  const auto writeHeader([](std::ostream& os)
+  {
+    os.write(
+      SPILL_MAGIC.data(), static_cast<std::streamsize>(SPILL_MAGIC.size()));
+    os.put(static_cast<char>(SPILL_VERSION));
+    os.put(static_cast<char>(COLUMNS));
+  });
+  // the file only ever grows, so rewrite it with just the retained blocks
+  //  once it holds a lot more than that
+  if (spilledBlocks_ > 2 * blocks_.size() + 1)
+  {
+    auto tempPath(spillPath_);
+    tempPath += ".tmp";
+    {
+      std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+      writeHeader(file);
+      for (const auto& b : blocks_) { writeBlock(file, b); }
+      if (!file.flush())
+      {
+        std::cout << "WARNING: Failed to write telemetry spill file " << tempPath << std::endl;
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, spillPath_, ec);
+    if (ec)
+    {
+      std::cout << "WARNING: Failed to replace telemetry spill file " << spillPath_ << ": " << ec.message() << std::endl;
+      return;
+    }
+    spilledBlocks_ = blocks_.size();
+    return;
+  }
+  std::error_code ec;
+  const bool empty(
+    !std::filesystem::exists(spillPath_, ec) ||
+    !std::filesystem::file_size(spillPath_, ec));
+  std::ofstream file(spillPath_, std::ios::binary | std::ios::app);
+  if (empty) { writeHeader(file); }
+  writeBlock(file, block);
+  if (!file.flush())
+  {
+    std::cout << "WARNING: Failed to append to telemetry spill file " << spillPath_ << std::endl;
+    return;
+  }
+  ++spilledBlocks_;
+}
+}
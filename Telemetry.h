@@ -0,0 +1,176 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+namespace rustLaunchSite
+{
+/// @brief Long-term server performance metrics history
+/// @details Stores periodic snapshots of server metrics in a compact columnar
+///  ring: records are grouped into fixed-size blocks, and each full block is
+///  encoded column by column as variable-length deltas, which typically
+///  shrinks a record to a byte or two per metric. This allows weeks of
+///  per-minute history to be kept in a few MB, in order to spot performance
+///  regressions after updates or plugin changes. Each encoded block is also
+///  appended to a spill file, from which history is reloaded on startup, so
+///  that it survives restarts of rustLaunchSite itself. All methods are
+///  thread-safe. Should not throw any exceptions.
+class Telemetry
+{
+public:
+
+  /// @brief Server metrics at a point in time
+  struct Record
+  {
+    /// @brief Wall clock time at which metrics were collected (stored with
+    ///  one second resolution)
+    std::chrono::system_clock::time_point time_{};
+    /// @brief Number of players connected
+    std::size_t players_{0};
+    /// @brief Number of players waiting in queue
+    std::size_t queued_{0};
+    /// @brief Number of players in the process of joining
+    std::size_t joining_{0};
+    /// @brief Number of entities in the world
+    std::size_t entityCount_{0};
+    /// @brief Server framerate (stored with 0.1 resolution)
+    double framerate_{0.0};
+    /// @brief Managed (garbage-collected) memory usage in MB
+    std::size_t memoryMb_{0};
+    /// @brief Process memory usage in MB, as reported by the server
+    std::size_t memoryUsageSystemMb_{0};
+    /// @brief Number of garbage collections since server started
+    std::size_t collections_{0};
+    /// @brief Network receive rate, as reported by the server
+    std::size_t networkIn_{0};
+    /// @brief Network send rate, as reported by the server
+    std::size_t networkOut_{0};
+    /// @brief Number of seconds since server finished booting
+    std::size_t uptimeSeconds_{0};
+    /// @brief Cumulative time server CPU usage was throttled by its cgroup,
+    ///  in microseconds (zero if not running in a cgroup)
+    std::uint64_t cpuThrottledUsec_{0};
+    /// @brief Cumulative number of times server memory usage exceeded its
+    ///  cgroup's high limit (zero if not running in a cgroup)
+    std::uint64_t memoryHighEvents_{0};
+    /// @brief Cumulative number of server cgroup processes killed due to
+    ///  running out of memory (zero if not running in a cgroup)
+    std::uint64_t oomKills_{0};
+    /// @brief Cumulative time server cgroup tasks were stalled waiting on
+    ///  memory, in microseconds (zero if not running in a cgroup)
+    std::uint64_t memoryStallUsec_{0};
+  };
+
+  /// @brief Number of records per encoded block
+  static constexpr std::size_t BLOCK_RECORDS{60};
+
+  /// @brief Primary constructor
+  /// @details Loads history from the spill file, if it exists.
+  /// @param capacity Maximum number of records to retain (minimum one block)
+  /// @param spillPath Path to spill file, or empty to keep history in memory
+  ///  only
+  Telemetry(std::size_t capacity, std::filesystem::path spillPath);
+
+  /// @brief Destructor
+  /// @details Spills any records that don't yet fill a block, so that they
+  ///  aren't lost.
+  ~Telemetry();
+
+  /// @brief Add a record
+  /// @param record Record to add; must not be older than the previous one
+  void Add(const Record& record);
+
+  /// @brief Get up to the given number of most recent records
+  /// @details This decodes records, and so is relatively expensive.
+  /// @param maxRecords Maximum number of records to return, or zero for all
+  /// @return Records in order added (oldest first)
+  std::vector<Record> GetRecords(std::size_t maxRecords = 0) const;
+
+  /// @brief Get number of records currently retained
+  /// @return Number of records
+  std::size_t GetSize() const;
+
+  /// @brief Get memory used for record storage
+  /// @return Approximate number of bytes used
+  std::size_t GetStorageBytes() const;
+
+private:
+
+  // number of metrics per record, including time
+  // new metrics must only ever be added at the end, so that spill files
+  //  written with fewer columns can still be loaded
+  static constexpr std::size_t COLUMNS{16};
+
+  // record in integer form, as stored
+  using Row = std::array<std::int64_t, COLUMNS>;
+
+  // block of encoded records
+  struct Block
+  {
+    std::uint32_t count_{0};
+    std::vector<std::uint8_t> data_;
+  };
+
+  // disabled constructors/operators
+
+  Telemetry() = delete;
+  Telemetry(const Telemetry&) = delete;
+  Telemetry& operator= (const Telemetry&) = delete;
+
+  // convert between records and rows
+  static Row ToRow(const Record& record);
+  static Record FromRow(const Row& row);
+
+  // encode rows into a block
+  static Block Encode(const std::vector<Row>& rows);
+
+  // decode a block, appending its rows to `rows`
+  // `columns` is the number of columns encoded in the block; any missing
+  //  trailing columns are zeroed
+  // returns false if block data is malformed
+  static bool Decode(
+    const Block& block, std::vector<Row>& rows,
+    std::size_t columns = COLUMNS);
+
+  // encode open rows into a block, store it, and spill it
+  // caller must hold mutex
+  void Seal();
+
+  // discard oldest blocks until within capacity
+  // caller must hold mutex
+  void Trim();
+
+  // load blocks from spill file
+  // caller must hold mutex
+  void Load();
+
+  // append a block to the spill file, rewriting the file if it has grown
+  //  well beyond what's retained in memory
+  // caller must hold mutex
+  void Spill(const Block& block);
+
+  // maximum number of records to retain
+  std::size_t capacity_;
+  // path to spill file, or empty if spilling is disabled
+  std::filesystem::path spillPath_;
+  // mutex protecting everything below
+  mutable std::mutex mutex_;
+  // encoded blocks, oldest first
+  std::deque<Block> blocks_;
+  // total number of records in encoded blocks
+  std::size_t blockRecords_{0};
+  // records that don't yet fill a block
+  std::vector<Row> open_;
+  // number of blocks in spill file
+  std::size_t spilledBlocks_{0};
+};
+}
+
+#endif // TELEMETRY_H
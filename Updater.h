@@ -1,142 +1,202 @@
-#ifndef UPDATER_H
-#define UPDATER_H
-
-#include <filesystem>
-#include <memory>
-#include <string>
-#include <string_view>
-#include <utility>
-
-namespace rustLaunchSite
-{
-class Config;
-class Downloader;
-
-/// @brief Rust server and Carbon/Oxide modding framework updater facility
-/// @details Implements all facilities and logic relating to checking for,
-///  downloading, and installing updates for the Rust dedicated server and
-///  Carbon/Oxide modding framework software, based on rustLaunchSite's
-///  application configuration. Does *not* implement periodic update checking,
-///  server (re)starts, etc. Only the constructor should throw exceptions.
-/// @todo Support non-release builds of Carbon/Oxide?
-class Updater
-{
-public:
-
-  /// @brief Primary constructor
-  /// @details Reads relevant config settings into member variables. Validates
-  ///  configuration, adjusting operating modes as necessary to account for
-  ///  recoverable discrepencies between confgiuration and detected
-  ///  installation/system states - or aborting in the case of unrecoverable
-  ///  issues.
-  /// @param cfgSptr Shared pointer to application configuration instance
-  /// @param downloaderUptr Shared pointer to download facility instance
-  /// @throw @c std::invalid_argument or @c std::runtime_error if unrecoverable
-  ///  conditions are detected (e.g. unable to allocate dependencies, basic
-  ///  application configuration appears invalid, etc.)
-  explicit Updater(
-    std::shared_ptr<const Config> cfgSptr,
-    std::shared_ptr<Downloader> downloaderSptr
-  );
-
-  /// @brief Destructor
-  virtual ~Updater();
-
-  /// @brief Check whether an update is available for the configured modding
-  ///  framework (i.e. Carbon/Oxide)
-  /// @details This can be called regardless of server state, except maybe when
-  ///  an update is being installed. Does nothing if no modding framework is
-  ///  configured, or configuration was deemed unusable.
-  /// @return Boolean indication of whether a modding framework update is
-  ///  available, or @c false if check skipped due to configuration
-  bool CheckFramework() const;
-
-  /// @brief Check whether Rust dedicated server update is available
-  /// @details This can be called regardless of server state, except maybe when
-  ///  an update is being installed. Will check regardless of configuration
-  ///  options, so it is up to the caller to enforce these.
-  /// @return Boolean indication of whether a server update is available
-  bool CheckServer() const;
-
-  /// @brief Download and install latest configured modding framework release
-  /// @details Verifies download and then overwrites current install. Caller is
-  ///  responsible for determining whether this is actually warranted, as well
-  ///  as for ensuring the server is not running. Logs a warning if an
-  ///  installation of the configured modding framework was not detected at
-  ///  startup, unless @c suppressWarning is set to @c true.
-  /// @param suppressWarning @c false (default) if a warning should be logged
-  ///  when called and no preexisting modding framework installation was
-  ///  detected, or @c true to suppress the warning (NOTE: Carbon/Oxide still
-  ///  won't be updated in this case)
-  void UpdateFramework(const bool suppressWarning = false) const;
-
-  /// @brief Check for, install, and validate latest RustDedicated release
-  /// @details Runs SteamCMD to do all the work. Caller is responsible for
-  ///  determining whether this is actually warranted, as well as for ensuring
-  ///  the server is not running.
-  void UpdateServer() const;
-
-private:
-
-  // Open Steam app manifest file at given path, find key with given
-  //  period-delimited path, and return corresponding value with double quotes
-  //  stripped off.
-  // Returns empty string on error or key not found.
-  // Logs a warning if warn=true (default) and the specified path could not be
-  //  found.
-  static std::string GetAppManifestValue(
-    const std::filesystem::path& appManifestPath,
-    const std::string_view keyPath,
-    const bool warn = true
-  );
-
-  // Get version number of the current Carbon/Oxide installation, or empty if
-  //  not found
-  std::string GetInstalledFrameworkVersion() const;
-
-  // Get beta/branch of the current rust dedicated server installation, or empty
-  //  if not found (which indicates the default "public" branch)
-  std::string GetInstalledServerBranch() const;
-
-  // Get build number of the current rust dedicated server installation, or
-  //  empty if not found
-  std::string GetInstalledServerBuild() const;
-
-  // Get build number of the latest server release available on steam for the
-  //  given branch/beta name, or empty if not found. If branch name is empty,
-  //  "public" will be assumed
-  std::string GetLatestServerBuild(const std::string_view branch = {}) const;
-
-  // Get download URL for latest Carbon/Oxide release on GitHub, or empty if not
-  //  found
-  std::string GetLatestFrameworkURL() const;
-
-  // Get version number of the latest Carbon/Oxide release available on GitHub,
-  //  or empty if not found
-  std::string GetLatestFrameworkVersion() const;
-
-  // disabled constructors/operators
-
-  Updater() = delete;
-  Updater(const Updater&) = delete;
-  Updater& operator= (const Updater&) = delete;
-
-  // shared pointer to Config facility
-  std::shared_ptr<const Config> cfgSptr_;
-  // shared pointer to Downloader facility
-  std::shared_ptr<Downloader> downloaderSptr_;
-  // server installation base path from rustLaunchSite configuration
-  std::filesystem::path serverInstallPath_;
-  // path to Steam manifest file for server installation
-  std::filesystem::path appManifestPath_;
-  // path to SteamCMD binary as reported by manifest file
-  std::filesystem::path steamCmdPath_;
-  // directory in which modding framework downloads should be temporarily stored
-  std::filesystem::path downloadPath_;
-  // path to Carbon/Oxide modding framework DLL derived from server install path
-  // may be empty if not installed, and/or modding framework updating disabled
-  std::filesystem::path frameworkDllPath_;
-};
-}
-
-#endif // UPDATER_H
+#ifndef UPDATER_H
+#define UPDATER_H
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace rustLaunchSite
+{
+class CancellationToken;
+class Config;
+class Downloader;
+
+/// @brief Rust server and Carbon/Oxide modding framework updater facility
+/// @details Implements all facilities and logic relating to checking for,
+///  downloading, and installing updates for the Rust dedicated server and
+///  Carbon/Oxide modding framework software, based on rustLaunchSite's
+///  application configuration. Does *not* implement periodic update checking,
+///  server (re)starts, etc. Only the constructor should throw exceptions.
+/// @todo Support non-release builds of Carbon/Oxide?
+class Updater
+{
+public:
+
+  /// @brief Primary constructor
+  /// @details Reads relevant config settings into member variables. Validates
+  ///  configuration, adjusting operating modes as necessary to account for
+  ///  recoverable discrepencies between confgiuration and detected
+  ///  installation/system states - or aborting in the case of unrecoverable
+  ///  issues.
+  /// @param cfgSptr Shared pointer to application configuration instance
+  /// @param downloaderUptr Shared pointer to download facility instance
+  /// @throw @c std::invalid_argument or @c std::runtime_error if unrecoverable
+  ///  conditions are detected (e.g. unable to allocate dependencies, basic
+  ///  application configuration appears invalid, etc.)
+  explicit Updater(
+    std::shared_ptr<const Config> cfgSptr,
+    std::shared_ptr<Downloader> downloaderSptr
+  );
+
+  /// @brief Destructor
+  virtual ~Updater();
+
+  /// @brief Check whether an update is available for the configured modding
+  ///  framework (i.e. Carbon/Oxide)
+  /// @details This can be called regardless of server state, except maybe when
+  ///  an update is being installed. Does nothing if no modding framework is
+  ///  configured, or configuration was deemed unusable.
+  /// @return Boolean indication of whether a modding framework update is
+  ///  available, or @c false if check skipped due to configuration
+  bool CheckFramework() const;
+
+  /// @brief Check whether Rust dedicated server update is available
+  /// @details This can be called regardless of server state, except maybe when
+  ///  an update is being installed. Will check regardless of configuration
+  ///  options, so it is up to the caller to enforce these. SteamCMD is killed
+  ///  if the check is cancelled.
+  /// @param cancel Token that may be used to abandon the check
+  /// @return Boolean indication of whether a server update is available, or
+  ///  @c false if cancelled
+  bool CheckServer(const CancellationToken& cancel) const;
+
+  /// @brief Download and install latest configured modding framework release
+  /// @details Verifies download and then overwrites current install. Files
+  ///  that get overwritten are first backed up to the download directory, so
+  ///  that @c RollbackFramework() can undo the update. Caller is
+  ///  responsible for determining whether this is actually warranted, as well
+  ///  as for ensuring the server is not running. Logs a warning if an
+  ///  installation of the configured modding framework was not detected at
+  ///  startup, unless @c suppressWarning is set to @c true.
+  /// @param suppressWarning @c false (default) if a warning should be logged
+  ///  when called and no preexisting modding framework installation was
+  ///  detected, or @c true to suppress the warning (NOTE: Carbon/Oxide still
+  ///  won't be updated in this case)
+  void UpdateFramework(const bool suppressWarning = false) const;
+
+  /// @brief Undo the last modding framework update
+  /// @details Restores files that were overwritten by the last call to
+  ///  @c UpdateFramework() from backup, removes files that it added, and then
+  ///  discards the backup. Caller is responsible for ensuring the server is
+  ///  not running. Note that update checks will consider the rolled back
+  ///  framework outdated, so callers may want to hold off on those for a
+  ///  while.
+  /// @return @c true if the update was rolled back, or @c false if there was
+  ///  no backup to roll back to, or restoring it failed
+  bool RollbackFramework() const;
+
+  /// @brief Check for, install, and validate latest RustDedicated release
+  /// @details Runs SteamCMD to do all the work. As SteamCMD is told to
+  ///  validate the installation, this also repairs missing or corrupt server
+  ///  files, even if no update is available. Caller is responsible for
+  ///  determining whether this is actually warranted, as well as for ensuring
+  ///  the server is not running. SteamCMD is killed if the update is
+  ///  cancelled, which may leave the installation in need of validation.
+  /// @param cancel Token that may be used to abandon the update
+  void UpdateServer(const CancellationToken& cancel) const;
+
+  /// @brief Take a snapshot of the server installation, if enabled
+  /// @details Should be called right before installing updates. The
+  ///  installation is cloned via reflinks to a directory next to it,
+  ///  replacing any previous snapshot, which takes milliseconds regardless of
+  ///  size. Data directories (server identities, modding framework
+  ///  configuration/data/plugins, extra backup paths, and any rustLaunchSite
+  ///  paths under the installation) are left out, so that only software is
+  ///  captured. Nothing is copied if the filesystem doesn't support reflinks.
+  ///  Caller is responsible for ensuring the server is not running.
+  /// @return @c true if a snapshot was taken
+  bool SnapshotInstall() const;
+
+  /// @brief Restore the server installation from the last snapshot
+  /// @details Swaps the snapshot directory with the installation directory,
+  ///  moves the data directories left out of the snapshot over from the
+  ///  latter, and then discards it. Refuses to do so if the snapshot has been
+  ///  marked stale by @c ExpireInstallSnapshot(). Caller is responsible for
+  ///  ensuring the server is not running, and that nothing else (e.g. a
+  ///  backup) is accessing the installation. Note that update checks will
+  ///  consider the restored installation outdated.
+  /// @return @c true if the installation was restored, or @c false if there
+  ///  was no usable snapshot, or swapping failed
+  bool RollbackInstall() const;
+
+  /// @brief Mark the last snapshot stale, so that it's no longer rolled back
+  /// @details Should be called once the server has proven healthy on the
+  ///  updated installation, as rolling back after that would likely undo a
+  ///  good update in response to an unrelated crash. The mark persists until
+  ///  the next snapshot is taken. Does nothing if there's no snapshot, or
+  ///  it's already stale.
+  void ExpireInstallSnapshot() const;
+
+  /// @brief Get build number of the current Rust dedicated server installation
+  /// @details Reads the Steam app manifest, so this is fairly cheap.
+  /// @return Build number, or empty if not found
+  std::string GetInstalledServerBuild() const;
+
+private:
+
+  // Open Steam app manifest file at given path, find key with given
+  //  period-delimited path, and return corresponding value with double quotes
+  //  stripped off.
+  // Returns empty string on error or key not found.
+  // Logs a warning if warn=true (default) and the specified path could not be
+  //  found.
+  static std::string GetAppManifestValue(
+    const std::filesystem::path& appManifestPath,
+    const std::string_view keyPath,
+    const bool warn = true
+  );
+
+  // Get paths relative to the server installation of directories holding
+  //  data rather than software, which are left out of snapshots
+  std::vector<std::filesystem::path> GetInstallDataPaths() const;
+
+  // Get version number of the current Carbon/Oxide installation, or empty if
+  //  not found
+  std::string GetInstalledFrameworkVersion() const;
+
+  // Get beta/branch of the current rust dedicated server installation, or empty
+  //  if not found (which indicates the default "public" branch)
+  std::string GetInstalledServerBranch() const;
+
+  // Get build number of the latest server release available on steam for the
+  //  given branch/beta name, or empty if not found. If branch name is empty,
+  //  "public" will be assumed. Returns empty if cancelled
+  std::string GetLatestServerBuild(
+    const std::string_view branch, const CancellationToken& cancel) const;
+
+  // Get download URL for latest Carbon/Oxide release on GitHub, or empty if not
+  //  found
+  std::string GetLatestFrameworkURL() const;
+
+  // Get version number of the latest Carbon/Oxide release available on GitHub,
+  //  or empty if not found
+  std::string GetLatestFrameworkVersion() const;
+
+  // disabled constructors/operators
+
+  Updater() = delete;
+  Updater(const Updater&) = delete;
+  Updater& operator= (const Updater&) = delete;
+
+  // shared pointer to Config facility
+  std::shared_ptr<const Config> cfgSptr_;
+  // shared pointer to Downloader facility
+  std::shared_ptr<Downloader> downloaderSptr_;
+  // server installation base path from rustLaunchSite configuration
+  std::filesystem::path serverInstallPath_;
+  // path to Steam manifest file for server installation
+  std::filesystem::path appManifestPath_;
+  // path to SteamCMD binary as reported by manifest file
+  std::filesystem::path steamCmdPath_;
+  // directory in which modding framework downloads should be temporarily stored
+  std::filesystem::path downloadPath_;
+  // path to Carbon/Oxide modding framework DLL derived from server install path
+  // may be empty if not installed, and/or modding framework updating disabled
+  std::filesystem::path frameworkDllPath_;
+};
+}
+
+#endif // UPDATER_H
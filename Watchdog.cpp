@@ -0,0 +1,58 @@
+#include "Watchdog.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace rustLaunchSite
+{
+Watchdog::Watchdog(const Config::WatchdogSettings& settings)
+  : settings_(settings)
+{
+}
+
+void Watchdog::Reset()
+{
+  started_ = false;
+}
+
+std::string Watchdog::Evaluate(const Observation& observation)
+{
+  if (!IsEnabled()) { return {}; }
+  const auto& time(observation.time_);
+  // every signal starts out fresh, so that a hang is only reported after a
+  //  full threshold of observations
+  if (!started_)
+  {
+    started_ = true;
+    lastResponseTime_ = time;
+    lastOutputTime_ = time;
+    lastOutputLines_ = observation.outputLines_;
+    return {};
+  }
+  // an RCON response only counts if the server is actually making progress;
+  //  one that still answers while crawling along at a fraction of a frame per
+  //  second is just as unplayable
+  if (observation.responsive_ &&
+    observation.framerate_ >= settings_.minFramerate_)
+  {
+    lastResponseTime_ = time;
+  }
+  if (observation.outputLines_ != lastOutputLines_)
+  {
+    lastOutputTime_ = time;
+    lastOutputLines_ = observation.outputLines_;
+  }
+  const auto lastAlive(std::max(lastResponseTime_, lastOutputTime_));
+  if (time - lastAlive < std::chrono::seconds(settings_.hangSeconds_))
+  {
+    return {};
+  }
+  std::ostringstream reason;
+  reason << "no RCON response with framerate >= " << settings_.minFramerate_
+         << " and no console/log output for "
+         << std::chrono::duration_cast<std::chrono::seconds>(
+              time - lastAlive).count()
+         << " second(s)";
+  return reason.str();
+}
+}
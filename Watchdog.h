@@ -0,0 +1,79 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include "Config.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace rustLaunchSite
+{
+/// @brief Hung server detection facility
+/// @details Detects a server whose process is still running, but whose main
+///  thread is wedged, by tracking several independent liveness signals: RCON
+///  responses, the framerate the server reports in them, and console/log
+///  output. The server is considered hung only once all of them have been
+///  stale for the configured threshold, so that a single quiet signal (e.g.
+///  RCON dropping out, or nothing being logged for a while) doesn't trigger a
+///  restart. Only makes decisions; acting on them is up to the caller. Should
+///  not throw any exceptions.
+class Watchdog
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Server liveness signals at a point in time
+  struct Observation
+  {
+    /// @brief Time at which signals were collected
+    Clock::time_point time_{};
+    /// @brief @c true if the server responded to an RCON query
+    bool responsive_{false};
+    /// @brief Server framerate reported via RCON (ignored if not responsive)
+    double framerate_{0.0};
+    /// @brief Total number of console/log lines the server has produced;
+    ///  only changes in this value are significant
+    std::uint64_t outputLines_{0};
+  };
+
+  /// @brief Primary constructor
+  /// @param settings Hang detection settings
+  explicit Watchdog(const Config::WatchdogSettings& settings);
+
+  /// @brief Query whether hang detection is enabled
+  /// @return @c true if a hang threshold is configured
+  bool IsEnabled() const { return settings_.hangSeconds_ > 0; }
+
+  /// @brief Discard all tracked signals
+  /// @details Should be called whenever the server is (re)started, or isn't
+  ///  expected to be responsive (e.g. while booting).
+  void Reset();
+
+  /// @brief Record an observation and check whether the server is hung
+  /// @param observation Current server liveness signals
+  /// @return Human-readable description of the hang, or empty if the server
+  ///  appears to be alive
+  std::string Evaluate(const Observation& observation);
+
+private:
+
+  // disabled constructors/operators
+
+  Watchdog() = delete;
+
+  // hang detection settings
+  Config::WatchdogSettings settings_;
+  // whether any observation has been recorded since reset
+  bool started_{false};
+  // time of last RCON response with a healthy framerate
+  Clock::time_point lastResponseTime_{};
+  // time at which output line count last changed
+  Clock::time_point lastOutputTime_{};
+  // output line count at that time
+  std::uint64_t lastOutputLines_{0};
+};
+}
+
+#endif // WATCHDOG_H
@@ -0,0 +1,198 @@
+#include "Wiper.h"
+
+#include "History.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+namespace
+{
+// maximum number of threads used to walk the identity directory
+constexpr unsigned int MAX_THREADS{8};
+
+// check whether a file name starts with the given prefix
+inline bool StartsWith(
+  const std::string_view name, const std::string_view prefix)
+{
+  return name.compare(0, prefix.size(), prefix) == 0;
+}
+
+// check whether a file name is that of an SQLite database with the given
+//  prefix, including its journal files
+inline bool IsDatabase(
+  const std::string_view name, const std::string_view prefix)
+{
+  if (!StartsWith(name, prefix)) { return false; }
+  for (const std::string_view suffix :
+    {".db", ".db-journal", ".db-wal", ".db-shm"})
+  {
+    if (name.size() >= suffix.size() &&
+      name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+namespace rustLaunchSite
+{
+Wiper::Wiper(
+  std::filesystem::path identityPath, const bool blueprints,
+  const std::filesystem::path& historyPath)
+  : identityPath_(std::move(identityPath))
+  , blueprints_(blueprints)
+  , historyUptr_(std::make_unique<History>(historyPath))
+{
+}
+
+Wiper::~Wiper() = default;
+
+bool Wiper::IsWipeFile(const std::filesystem::path& path) const
+{
+  const auto& name(path.filename().string());
+  // maps: `<level>.<size>.<seed>.<version>.map`
+  if (path.extension() == ".map") { return true; }
+  // saves: `<level>.<size>.<seed>.<version>.sav`, plus numbered rollovers
+  //  (`.sav.1` etc.)
+  if (path.extension() == ".sav" || name.find(".sav.") != std::string::npos)
+  {
+    return true;
+  }
+  // file storage for world entities (e.g. sign images)
+  if (IsDatabase(name, "sv.files.")) { return true; }
+  return blueprints_ && IsDatabase(name, "player.blueprints.");
+}
+
+Wiper::Result Wiper::Wipe(
+  const std::string& reason, const KeepFunction& keep) const
+{
+  std::cout << "Wiping server identity directory " << identityPath_ << " (" << reason << (blueprints_ ? "; including blueprints" : "") << ")" << std::endl;
+  const auto wallTime(std::chrono::system_clock::now());
+  const auto startTime(std::chrono::steady_clock::now());
+  Result result;
+  // work queue of directories still to be walked
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::filesystem::path> queue{identityPath_};
+  // number of directories queued or being walked; workers exit once this
+  //  reaches zero
+  std::size_t pending(1);
+  const auto worker([&]()
+  {
+    std::vector<std::filesystem::path> subdirs;
+    std::vector<std::filesystem::path> removed;
+    std::uintmax_t bytes(0);
+    std::size_t errors(0);
+    while (true)
+    {
+      std::filesystem::path dir;
+      {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&]() { return !queue.empty() || !pending; });
+        if (queue.empty()) { break; }
+        dir = std::move(queue.front());
+        queue.pop_front();
+      }
+      std::error_code ec;
+      for (std::filesystem::directory_iterator it(dir, ec), end;
+        !ec && it != end; it.increment(ec))
+      {
+        // don't follow symlinks out of the identity directory
+        std::error_code typeEc;
+        const bool isSymlink(it->is_symlink(typeEc));
+        const bool isDirectory(!typeEc && !isSymlink &&
+          it->is_directory(typeEc));
+        if (typeEc)
+        {
+          std::cout << "WARNING: Skipping " << it->path() << ": " << typeEc.message() << std::endl;
+          ++errors;
+          continue;
+        }
+        if (isSymlink) { continue; }
+        if (isDirectory)
+        {
+          subdirs.push_back(it->path());
+          continue;
+        }
+        if (!IsWipeFile(it->path()) || (keep && keep(it->path())))
+        {
+          continue;
+        }
+        std::error_code sizeEc;
+        const auto size(it->file_size(sizeEc));
+        std::error_code removeEc;
+        if (std::filesystem::remove(it->path(), removeEc))
+        {
+          removed.push_back(it->path());
+          bytes += sizeEc ? 0 : size;
+        }
+        else
+        {
+          std::cout << "WARNING: Failed to delete " << it->path() << ": " << removeEc.message() << std::endl;
+          ++errors;
+        }
+      }
+      if (ec)
+      {
+        std::cout << "WARNING: Failed to walk directory " << dir << ": " << ec.message() << std::endl;
+      }
+      std::scoped_lock lock(mutex);
+      pending += subdirs.size();
+      std::move(subdirs.begin(), subdirs.end(), std::back_inserter(queue));
+      subdirs.clear();
+      --pending;
+      cv.notify_all();
+    }
+    std::scoped_lock lock(mutex);
+    std::move(
+      removed.begin(), removed.end(), std::back_inserter(result.removed_));
+    result.bytes_ += bytes;
+    result.errors_ += errors;
+  });
+  const unsigned int threadCount(
+    std::clamp(std::thread::hardware_concurrency(), 1u, MAX_THREADS));
+  std::vector<std::thread> threads;
+  for (unsigned int i(0); i < threadCount; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads) { thread.join(); }
+  result.duration_ = std::chrono::steady_clock::now() - startTime;
+
+  // report
+  std::sort(result.removed_.begin(), result.removed_.end());
+  nlohmann::json files(nlohmann::json::array());
+  for (const auto& path : result.removed_)
+  {
+    std::cout << "Wipe deleted: " << path << std::endl;
+    files.push_back(path.lexically_relative(identityPath_).generic_string());
+  }
+  std::cout << "Wipe deleted " << result.removed_.size() << " file(s) totaling " << (result.bytes_ >> 20) << " MiB in " << result.duration_.count() << " second(s)";
+  if (result.errors_)
+  {
+    std::cout << "; failed to delete " << result.errors_ << " file(s)";
+  }
+  std::cout << std::endl;
+  const nlohmann::json record
+  {
+    {"wipeTime", History::ToIsoString(wallTime)},
+    {"reason", reason},
+    {"blueprints", blueprints_},
+    {"files", files},
+    {"bytes", result.bytes_},
+    {"errors", result.errors_},
+    {"seconds", result.duration_.count()}
+  };
+  historyUptr_->Append(record.dump());
+  return result;
+}
+}
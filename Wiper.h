@@ -0,0 +1,87 @@
+#ifndef WIPER_H
+#define WIPER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rustLaunchSite
+{
+class History;
+
+/// @brief Server wipe facility
+/// @details Deletes the map, save and (optionally) blueprint files under a
+///  server identity directory, including the copies the server keeps in its
+///  backup directories. Other files (e.g. server configuration, and plugin
+///  data) are left alone. The directory tree is walked by a pool of threads,
+///  as it can contain many backups on slow storage. Each wipe is logged in
+///  detail, and recorded in a history file. Caller is responsible for
+///  ensuring that the server is not running. Should not throw any exceptions.
+class Wiper
+{
+public:
+
+  /// @brief Function that decides whether a file that would otherwise be
+  ///  deleted should be kept (e.g. a pre-generated map)
+  /// @details May be called concurrently from multiple threads.
+  using KeepFunction = std::function<bool(const std::filesystem::path&)>;
+
+  /// @brief Outcome of a wipe
+  struct Result
+  {
+    /// @brief Files that were deleted, in no particular order
+    std::vector<std::filesystem::path> removed_;
+    /// @brief Total size of deleted files in bytes
+    std::uintmax_t bytes_{0};
+    /// @brief Number of files that matched but could not be deleted
+    std::size_t errors_{0};
+    /// @brief Time the wipe took
+    std::chrono::duration<double> duration_{};
+  };
+
+  /// @brief Primary constructor
+  /// @param identityPath Server identity directory to wipe
+  /// @param blueprints @c true if blueprint databases should be deleted too
+  /// @param historyPath Path to wipe history file
+  Wiper(
+    std::filesystem::path identityPath, bool blueprints,
+    const std::filesystem::path& historyPath);
+
+  /// @brief Destructor
+  ~Wiper();
+
+  /// @brief Check whether a file is one that a wipe deletes
+  /// @param path File path (only the file name is checked)
+  /// @return @c true if file would be deleted
+  bool IsWipeFile(const std::filesystem::path& path) const;
+
+  /// @brief Wipe the server
+  /// @details Blocks until done.
+  /// @param reason Human-readable reason for wipe, recorded in history
+  /// @param keep Optional function to exempt files from deletion
+  /// @return Outcome of wipe
+  Result Wipe(const std::string& reason, const KeepFunction& keep = {}) const;
+
+private:
+
+  // disabled constructors/operators
+
+  Wiper() = delete;
+  Wiper(const Wiper&) = delete;
+  Wiper& operator= (const Wiper&) = delete;
+
+  // server identity directory
+  std::filesystem::path identityPath_;
+  // whether blueprint databases should be deleted
+  bool blueprints_;
+  // wipe history file
+  std::unique_ptr<History> historyUptr_;
+};
+}
+
+#endif // WIPER_H
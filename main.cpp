@@ -1,522 +1,1264 @@
-#include "Config.h"
-#include "Downloader.h"
-#include "Server.h"
-#include "Updater.h"
-
-#include "ctrl-c.h"
-
-#include <chrono>
-#include <condition_variable>
-#include <iostream>
-#include <memory>
-#include <mutex>
-#include <thread>
-
-namespace
-{
-// exit codes
-// TODO: use standard codes instead?
-//  see https://en.cppreference.com/w/cpp/error/errc
-enum RLS_EXIT
-{
-  SUCCESS = 0,
-  ARG,      // invalid_argument
-  HANDLER,  // io_error / state_not_recoverable
-  START,    // no_child_process
-  UPDATE,   // no_child_process
-  RESTART,  // no_child_process
-  EXCEPTION // interrupted
-};
-
-// timer thread state, controlled by main()
-enum class TimerState
-{
-  RUN,    // timer thread should start/continue running normally
-  PAUSE,  // timer thread should sleep until ordered to run or stop
-  STOP    // timer thread should exit
-};
-// mutex and mutex-controlled thread data
-namespace threadData
-{
-  // mutex that controls access to sibling variables
-  std::mutex mutex_;
-  // CV on which main() waits for notifications
-  std::condition_variable cvMain_;
-  // CV on which timer thread waits for notifications
-  std::condition_variable cvTimer_;
-  // timer thread state commanded by main()
-  TimerState timerState_{TimerState::RUN};
-  // whether Ctrl+C handler is notifying main() to shut down
-  bool notifyMainCtrlC_{false};
-  // whether timer thread is notifying main() to check server health
-  bool notifyMainServer_{false};
-  // whether timer thread is notifying main() to check for updates
-  bool notifyMainUpdater_{false};
-  // whether main() is notifying timer thread to change state
-  bool notifyTimerThread_{false};
-};
-
-bool HandleCtrlC(CtrlCLibrary::CtrlSignal s)
-{
-  if (s != CtrlCLibrary::kCtrlCSignal)
-  {
-    std::cout << "rustLaunchSite: WARNING: Ignoring unknown signal" << std::endl;
-    return false;
-  }
-  // attempt to signal main()
-  // CtrlCLibrary is pretty dodgy in terms of threading, so I don't know how
-  //  safe/robust a solution this will be
-  std::unique_lock lock{threadData::mutex_};
-  threadData::notifyMainCtrlC_ = true;
-  threadData::cvMain_.notify_all();
-  return true;
-}
-
-// (re)set start time and wake/notification times based on duration inputs
-inline void ResetTimers(
-  const std::size_t duration1Minutes,
-  const std::size_t duration2Minutes,
-  std::chrono::steady_clock::time_point& timeStart,
-  std::chrono::steady_clock::time_point& time1,
-  std::chrono::steady_clock::time_point& time2
-)
-{
-  timeStart = std::chrono::steady_clock::now();
-  time1 = timeStart + std::chrono::minutes(duration1Minutes);
-  time2 = timeStart + std::chrono::minutes(duration2Minutes);
-}
-
-void TimerFunction(
-  const std::size_t sleepDurationMinutes,
-  const std::size_t updateIntervalMinutes
-)
-{
-  const std::chrono::minutes sleepDuration(sleepDurationMinutes);
-  const std::chrono::minutes updateInterval(updateIntervalMinutes);
-  std::chrono::steady_clock::time_point startTime;
-  std::chrono::steady_clock::time_point wakeTime;
-  std::chrono::steady_clock::time_point updateTime;
-  ResetTimers(
-    sleepDurationMinutes, updateIntervalMinutes,
-    startTime, wakeTime, updateTime
-  );
-  while (true)
-  {
-    // grab mutex for safe state variable access in loop when awake
-    std::unique_lock lock(threadData::mutex_);
-    // release mutex and sleep, unless or until one of the following:
-    // - wake time reached
-    // - notification received from main()
-    // if notified, handle new timer state
-    if
-    (
-      const auto notified(threadData::cvTimer_.wait_until(
-        lock, wakeTime,
-        [](){return threadData::notifyTimerThread_;}
-      ));
-      notified
-    )
-    {
-      // mark notification as processed
-      threadData::notifyTimerThread_ = false;
-      if (threadData::timerState_ == TimerState::RUN)
-      {
-        // assume PAUSE->RUN
-        // reset notification target times and loop back around
-        ResetTimers(
-          sleepDurationMinutes, updateIntervalMinutes,
-          startTime, wakeTime, updateTime
-        );
-        continue;
-      }
-      // don't care about PAUSE here
-      if (threadData::timerState_ == TimerState::STOP)
-      {
-        // assume RUN->STOP or PAUSE->STOP
-        // break out of loop
-        break;
-      }
-    }
-    // wait time elapsed, or got PAUSE notification
-    const bool notifyMain(threadData::timerState_ != TimerState::PAUSE);
-    const bool updateTimeElapsed(
-      updateIntervalMinutes && std::chrono::steady_clock::now() >= updateTime
-    );
-    // update target times
-    wakeTime += sleepDuration;
-    if (updateTimeElapsed) { updateTime += updateInterval; }
-    // skip notifying main() if "paused"
-    if (!notifyMain) { continue; }
-    // set notification flags
-    threadData::notifyMainServer_ = true;
-    threadData::notifyMainUpdater_ = updateTimeElapsed;
-    // notify main()
-    // it will wake up and grab mutex when we loop around and go back to sleep
-    threadData::cvMain_.notify_all();
-    // end of loop body
-  }
-}
-
-// change timer state and notify timer thread of change
-// meant to be called by main() under mutex lock
-void SetTimerState(const TimerState ts)
-{
-  threadData::timerState_ = ts;
-  threadData::notifyTimerThread_ = true;
-  threadData::cvTimer_.notify_all();
-}
-
-// check for updates according to provided options
-// return pair indicating whether server and/or mod framework needs updating,
-//  respectively
-std::pair<bool, bool> UpdateCheck(
-  const rustLaunchSite::Updater& updater
-, const bool checkServer
-, const bool checkModFramework
-, const bool updateModFrameworkOnServer)
-{
-  std::pair<bool, bool> retVal{false, false};
-  if (checkServer)
-  {
-    std::cout << "rustLaunchSite: Performing server update check" << std::endl;
-    retVal.first = updater.CheckServer();
-  }
-  const bool forceCheck{updateModFrameworkOnServer && retVal.first};
-  if (checkModFramework || forceCheck)
-  {
-    std::cout << "rustLaunchSite: Performing mod framework update check" << std::endl;
-    retVal.second = updater.CheckFramework();
-  }
-  return retVal;
-}
-
-// wrapper around Updater::UpdateFramework() to loop until update succeeds
-void UpdateFramework(
-  const rustLaunchSite::Updater& updater,
-  const int retryDelaySeconds = 0, const bool suppressWarning = false)
-{
-  std::cout << "rustLaunchSite: Entering plugin framework update loop" << std::endl;
-  bool firstTry{true};
-  for(bool update{true}; update; update = updater.CheckFramework())
-  {
-    if (!firstTry)
-    {
-      std::cout << "rustLaunchSite: WARNING: Detected plugin framework version mismatch after update attempt; ";
-      if (retryDelaySeconds > 0)
-      {
-        std::cout << "waiting for " << retryDelaySeconds << " second(s) and then trying again..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::seconds(retryDelaySeconds));
-      }
-      else
-      {
-        std::cout << "trying again..." << std::endl;
-      }
-    }
-
-    updater.UpdateFramework(suppressWarning);
-
-    firstTry = false;
-  }
-  std::cout << "rustLaunchSite: Completed plugin framework update loop" << std::endl;
-}
-
-// wrapper around Updater::UpdateServer() to loop until update succeeds
-void UpdateServer(
-  const rustLaunchSite::Updater& updater,
-  const int retryDelaySeconds = 0)
-{
-  std::cout << "rustLaunchSite: Entering server update loop" << std::endl;
-  bool firstTry{true};
-  for(bool update{true}; update; update = updater.CheckServer())
-  {
-    if (!firstTry)
-    {
-      std::cout << "rustLaunchSite: WARNING: Detected server version mismatch after update attempt; " << std::endl;
-      if (retryDelaySeconds > 0)
-      {
-        std::cout << "waiting for " << retryDelaySeconds << " second(s) and then trying again..." << std::endl;
-        std::this_thread::sleep_for(std::chrono::seconds(retryDelaySeconds));
-      }
-      else
-      {
-        std::cout << "trying again..." << std::endl;
-      }
-    }
-
-    updater.UpdateServer();
-
-    firstTry = false;
-  }
-  std::cout << "rustLaunchSite: Completed server update loop" << std::endl;
-}
-}
-
-int main(int argc, char* argv[])
-{
-  std::cout << "rustLaunchSite: Starting" << std::endl;
-
-  if (argc <= 1)
-  {
-    std::cout << "rustLaunchSite: ERROR: Configuration file/path must be specified as an argument" << std::endl;
-    return RLS_EXIT::ARG;
-  }
-
-  // install Ctrl+C handler
-  // TODO: change this to an RAII wrapper so that we clean up at the end
-  const auto handlerId(CtrlCLibrary::SetCtrlCHandler(HandleCtrlC));
-  if (handlerId == CtrlCLibrary::kErrorID)
-  {
-    std::cout << "rustLaunchSite: ERROR: Failed to install Ctrl+C handler" << std::endl;
-    return RLS_EXIT::HANDLER;
-  }
-
-  // create null pointers for all facilities we'll be instantiating, so that we
-  //  can clean them up if an exception is caught
-  std::shared_ptr<rustLaunchSite::Config> configSptr;
-  std::unique_ptr<rustLaunchSite::Server> serverUptr;
-  std::unique_ptr<rustLaunchSite::Updater> updaterUptr;
-  std::unique_ptr<std::thread> timerThreadUptr;
-
-  RLS_EXIT retVal(RLS_EXIT::SUCCESS);
-  try
-  {
-    // load config file
-    configSptr = std::make_shared<rustLaunchSite::Config>(argv[1]);
-    // instantiate server manager
-    serverUptr = std::make_unique<rustLaunchSite::Server>(configSptr);
-    // instantiate update manager
-    updaterUptr = std::make_unique<rustLaunchSite::Updater>(
-      configSptr, std::make_shared<rustLaunchSite::Downloader>()
-    );
-
-    {
-      const auto [updateServerOnStartup, updateModFrameworkOnStartup] =
-        UpdateCheck(
-          *updaterUptr
-        , configSptr->GetUpdateServerOnStartup()
-        , configSptr->GetUpdateModFrameworkOnStartup()
-        , configSptr->GetUpdateModFrameworkOnServerUpdate())
-      ;
-      if (updateServerOnStartup)
-      {
-        UpdateServer(
-          *updaterUptr, configSptr->GetUpdateServerRetryDelaySeconds());
-      }
-      if (updateModFrameworkOnStartup)
-      {
-        UpdateFramework(
-          *updaterUptr
-        , configSptr->GetUpdateModFrameworkRetryDelaySeconds()
-        , updateServerOnStartup);
-      }
-    }
-
-    // launch server
-    std::cout << "rustLaunchSite: Starting server" << std::endl;
-    if (!serverUptr->Start())
-    {
-      std::cout << "rustLaunchSite: Server failed to start; shutting down" << std::endl;
-      // okay to just abort at this point
-      return RLS_EXIT::START;
-    }
-
-    // start timer thread
-    std::cout << "rustLaunchSite: Starting timer thread" << std::endl;
-    timerThreadUptr = std::make_unique<std::thread>(
-      &TimerFunction, 1, configSptr->GetUpdateIntervalMinutes()
-    );
-    if (!timerThreadUptr)
-    {
-      throw std::runtime_error("rustLaunchSite: Failed to instantiate timer thread");
-    }
-
-    // main loop
-    // bool gotProtocol(false);
-    std::cout << "rustLaunchSite: Starting main event loop" << std::endl;
-    while (true)
-    {
-      // grab mutex for safe state variable access in loop when awake
-      std::unique_lock lock(threadData::mutex_);
-      // sleep until we get a notification from the timer thread
-      // std::cout << "rustLaunchSite: Waiting for events" << std::endl;
-      threadData::cvMain_.wait
-      (
-        lock,
-        [](){
-          return (
-            threadData::notifyMainCtrlC_ ||
-            threadData::notifyMainServer_ ||
-            threadData::notifyMainUpdater_
-          );
-        }
-      );
-      // std::cout << "rustLauchSite: Woke up with state:"
-      //   << " CtrlC=" << threadData::notifyMainCtrlC_
-      //   << ", Server=" << threadData::notifyMainServer_
-      //   << ", Updater=" << threadData::notifyMainUpdater_
-      //   << std::endl;
-      // handle Ctrl+C notification
-      if (threadData::notifyMainCtrlC_)
-      {
-        // attempt an orderly shutdown
-        std::cout << "rustLaunchSite: Ctrl+C signal caught; stopping server" << std::endl;
-        ::SetTimerState(TimerState::STOP);
-        serverUptr->Stop("Server manager terminated");
-        // as Ctrl+C is the only orderly shutdown stimulus, we want to report a
-        //  successful exit
-        retVal = RLS_EXIT::SUCCESS;
-        break;
-      }
-      // handle update check timer notification
-      if (threadData::notifyMainUpdater_)
-      {
-        threadData::notifyMainUpdater_ = false;
-        // check for updates
-        const auto [updateServerOnInterval, updateModFrameworkOnInterval] =
-          UpdateCheck(
-            *updaterUptr
-          , configSptr->GetUpdateServerOnStartup()
-          , configSptr->GetUpdateModFrameworkOnStartup()
-          , configSptr->GetUpdateModFrameworkOnServerUpdate())
-        ;
-        // if any are needed: take server down, install updates, relaunch server
-        if (updateServerOnInterval || updateModFrameworkOnInterval)
-        {
-          // pause timer thread
-          // ...although this probably doesn't matter, since we hold the mutex
-          ::SetTimerState(TimerState::PAUSE);
-          // stop server
-          std::cout << "rustLaunchSite: Update(s) required; stopping server" << std::endl;
-          // install updates
-          serverUptr->Stop("Installing updates");
-          if (updateServerOnInterval)
-          {
-            UpdateServer(
-              *updaterUptr, configSptr->GetUpdateServerRetryDelaySeconds());
-          }
-          if (updateModFrameworkOnInterval)
-          {
-            UpdateFramework(
-              *updaterUptr
-            , configSptr->GetUpdateModFrameworkRetryDelaySeconds()
-            , updateServerOnInterval);
-          }
-          std::cout << "rustLaunchSite: Update(s) complete; starting server" << std::endl;
-          if (!serverUptr->Start())
-          {
-            std::cout << "rustLaunchSite: Server failed to start; shutting down" << std::endl;
-            retVal = RLS_EXIT::UPDATE;
-            break;
-          }
-          // resume timer thread
-          ::SetTimerState(TimerState::RUN);
-        }
-      }
-      // handle server health check timer notification
-      if (threadData::notifyMainServer_)
-      {
-        threadData::notifyMainServer_ = false;
-        // check if server is running
-        if (serverUptr->IsRunning())
-        {
-          // server is running; check for protocol via RCON
-          // just poll every time, as RCON connection seems to die if we don't
-          //  use it?
-          // if (!gotProtocol)
-          // {
-          if
-          (
-            const auto& serverInfo(serverUptr->GetInfo());
-            serverInfo.valid_
-          )
-          {
-            // gotProtocol = true;
-            std::cout
-              << "rustLaunchSite: Got server info via RCON:"
-              << "\n\tplayers=" << serverInfo.players_
-              << "\n\tprotocol=" << serverInfo.protocol_
-              << std::endl;
-    // TODO: poll server for protocol version via RCON, triggering wipe
-    //  processing if a change is detected since last run
-            // }
-          }
-        }
-        // server is not running
-        else if (configSptr->GetProcessAutoRestart())
-        {
-          // configured to automatically restart
-          // pause timers during server restart
-          ::SetTimerState(TimerState::PAUSE);
-          std::cout << "rustLaunchSite: Server stopped unexpectedly" << std::endl;
-          // check for updates while the server is down
-          const auto [updateServerOnRelaunch, updateModFrameworkOnRelaunch] =
-            UpdateCheck(
-              *updaterUptr
-            , configSptr->GetUpdateServerOnRelaunch()
-            , configSptr->GetUpdateModFrameworkOnRelaunch()
-            , configSptr->GetUpdateModFrameworkOnServerUpdate())
-          ;
-          if (updateServerOnRelaunch)
-          {
-            UpdateServer(
-              *updaterUptr, configSptr->GetUpdateServerRetryDelaySeconds());
-          }
-          if (updateModFrameworkOnRelaunch)
-          {
-            UpdateFramework(
-              *updaterUptr
-            , configSptr->GetUpdateModFrameworkRetryDelaySeconds()
-            , updateServerOnRelaunch);
-          }
-          // relaunch server
-          std::cout << "rustLaunchSite: Relaunching server" << std::endl;
-          if (!serverUptr->Start())
-          {
-            std::cout << "rustLaunchSite: Server failed to relaunch; shutting down" << std::endl;
-            retVal = RLS_EXIT::RESTART;
-            break;
-          }
-          ::SetTimerState(TimerState::RUN);
-        }
-        else
-        {
-          // configured to shutdown on unexpected server stop
-          ::SetTimerState(TimerState::STOP);
-          std::cout << "rustLaunchSite: Server stopped unexpectedly; shutting down" << std::endl;
-          retVal = RLS_EXIT::RESTART;
-          break;
-        }
-      }
-      // end of main loop
-    }
-
-    std::cout << "rustLaunchSite: Exited main loop; beginning shutdown process" << std::endl;
-    std::cout << "rustLaunchSite: Stopping timer thread" << std::endl;
-    ::SetTimerState(TimerState::STOP);
-    timerThreadUptr->join();
-    std::cout << "rustLaunchSite: Stopping server (if running)" << std::endl;
-    serverUptr->Stop("Server manager shutting down");
-  }
-  catch (const std::exception& e)
-  {
-    std::cout << "rustLaunchSite: ERROR: Unhandled exception: " << e.what() << std::endl;
-    retVal = RLS_EXIT::EXCEPTION;
-  }
-  catch(...)
-  {
-    std::cout << "rustLaunchSite: ERROR: Unknown exception" << std::endl;
-    retVal = RLS_EXIT::EXCEPTION;
-  }
-
-  // std::thread blows up the application if not joined before exit, so check
-  //  again in case we're here due to catching an exception
-  if (timerThreadUptr && timerThreadUptr->joinable())
-  {
-    ::SetTimerState(TimerState::STOP);
-    timerThreadUptr->join();
-  }
-
-  std::cout << "rustLaunchSite: Exiting" << std::endl;
-
-  return retVal;
-}
+#include "Backup.h"
+#include "Cache.h"
+#include "CancellationToken.h"
+#include "Config.h"
+#include "Countdown.h"
+#include "CrashLoop.h"
+#include "Cron.h"
+#include "Downloader.h"
+#include "History.h"
+#include "LifecycleWorker.h"
+#include "MapPregen.h"
+#include "RestartPolicy.h"
+#include "Scheduler.h"
+#include "SeedEngine.h"
+#include "Server.h"
+#include "ServerState.h"
+#include "Updater.h"
+#include "Watchdog.h"
+#include "Wiper.h"
+
+#include "ctrl-c.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+// cache key under which the last seen server protocol version is stored
+const std::string PROTOCOL_CACHE_KEY("protocol");
+// cache keys under which the last seen server build ID, and the time at which
+//  it was first seen, are stored
+const std::string BUILD_CACHE_KEY("serverBuild");
+const std::string BUILD_TIME_CACHE_KEY("serverBuildTime");
+// cache key under which the time of the last healthy server check is stored
+const std::string HEALTHY_TIME_CACHE_KEY("lastHealthyTime");
+
+// exit codes
+// TODO: use standard codes instead?
+//  see https://en.cppreference.com/w/cpp/error/errc
+enum RLS_EXIT
+{
+  SUCCESS = 0,
+  ARG,      // invalid_argument
+  HANDLER,  // io_error / state_not_recoverable
+  START,    // no_child_process
+  UPDATE,   // no_child_process
+  RESTART,  // no_child_process
+  EXCEPTION, // interrupted
+  RESTORE   // io_error
+};
+
+// what main() should do once the active shutdown countdown finishes
+enum class CountdownAction
+{
+  NONE,   // no countdown active
+  UPDATE, // stop server, install updates, and restart server
+  RESTART,// stop server and restart it (proactive restart policy)
+  WIPE,   // stop server, wipe it, and restart it
+  EXIT    // stop server and exit
+};
+
+// events that other threads post to main()
+enum class Event
+{
+  CTRL_C,            // Ctrl+C handler: shut down
+  OPERATION_DONE,    // lifecycle worker: an operation finished
+  HEALTH_CHECK,      // health check job: check server health
+  UPDATE_CHECK,      // update check job: check for updates
+  BACKUP_DUE,        // backup job: a periodic backup is due
+  COUNTDOWN_DONE,    // scheduler thread: the shutdown countdown finished
+  RELAUNCH,          // scheduler thread: relaunch after an unexpected stop
+  SCHEDULED_RESTART, // cron job: a scheduled restart is due
+  SCHEDULED_WIPE     // cron job: a scheduled wipe is due
+};
+
+// mutex and mutex-controlled thread data
+namespace threadData
+{
+  // mutex that controls access to sibling variables
+  std::mutex mutex_;
+  // CV on which main() waits for events
+  std::condition_variable cvMain_;
+  // events waiting to be handled by main(), in order of arrival
+  // an event that's already pending isn't queued again, as handling it once
+  //  covers both
+  std::deque<Event> events_;
+};
+
+// cancellation token for updates installed at startup, before main() starts
+//  handling Ctrl+C
+// this is thread-safe on its own, so it isn't protected by threadData::mutex_
+rustLaunchSite::CancellationToken startupCancel;
+
+// queue an event for main(), unless it's already pending
+// caller must hold threadData::mutex_
+void QueueEvent(const Event event)
+{
+  auto& events(threadData::events_);
+  if (std::find(events.begin(), events.end(), event) != events.end())
+  {
+    return;
+  }
+  events.push_back(event);
+  threadData::cvMain_.notify_all();
+}
+
+// post an event to main(), and wake it
+// meant to be invoked by jobs on the scheduler thread
+void NotifyMain(const Event event)
+{
+  std::unique_lock lock{threadData::mutex_};
+  QueueEvent(event);
+}
+
+bool HandleCtrlC(CtrlCLibrary::CtrlSignal s)
+{
+  if (s != CtrlCLibrary::kCtrlCSignal)
+  {
+    std::cout << "rustLaunchSite: WARNING: Ignoring unknown signal" << std::endl;
+    return false;
+  }
+  // attempt to signal main()
+  // CtrlCLibrary is pretty dodgy in terms of threading, so I don't know how
+  //  safe/robust a solution this will be
+  startupCancel.Cancel();
+  NotifyMain(Event::CTRL_C);
+  return true;
+}
+
+// notify main() that the shutdown countdown has finished
+// meant to be invoked by Countdown on the scheduler thread
+void HandleCountdown(const bool /*early*/)
+{
+  NotifyMain(Event::COUNTDOWN_DONE);
+}
+
+// notify main() that the crash loop backoff delay has elapsed
+// meant to be invoked on the scheduler thread
+void HandleRelaunch()
+{
+  NotifyMain(Event::RELAUNCH);
+}
+
+// schedule a job on a cron schedule, and log when it will first run
+rustLaunchSite::Scheduler::JobId ScheduleCron(
+  rustLaunchSite::Scheduler& scheduler,
+  const std::string& expression,
+  const std::string& description,
+  rustLaunchSite::Scheduler::Job job)
+{
+  const rustLaunchSite::Cron cron(expression);
+  const auto next(cron.Next(rustLaunchSite::Cron::Clock::now()));
+  if (next == rustLaunchSite::Cron::Clock::time_point::max())
+  {
+    std::cout << "rustLaunchSite: WARNING: Schedule `" << expression << "` for " << description << " never matches" << std::endl;
+  }
+  else
+  {
+    std::cout << "rustLaunchSite: Scheduled " << description << " on `" << expression << "`; next at " << rustLaunchSite::History::ToIsoString(next) << std::endl;
+  }
+  return scheduler.ScheduleCron(cron, std::move(job));
+}
+
+// check for updates according to provided options
+// return pair indicating whether server and/or mod framework needs updating,
+//  respectively, or neither if cancelled
+std::pair<bool, bool> UpdateCheck(
+  const rustLaunchSite::Updater& updater
+, const rustLaunchSite::CancellationToken& cancel
+, const bool checkServer
+, const bool checkModFramework
+, const bool updateModFrameworkOnServer)
+{
+  std::pair<bool, bool> retVal{false, false};
+  if (checkServer)
+  {
+    std::cout << "rustLaunchSite: Performing server update check" << std::endl;
+    retVal.first = updater.CheckServer(cancel);
+  }
+  if (cancel.IsCancelled()) { return {false, false}; }
+  const bool forceCheck{updateModFrameworkOnServer && retVal.first};
+  if (checkModFramework || forceCheck)
+  {
+    std::cout << "rustLaunchSite: Performing mod framework update check" << std::endl;
+    retVal.second = updater.CheckFramework();
+  }
+  return retVal;
+}
+
+// wrapper around Updater::UpdateFramework() to loop until update succeeds or
+//  is cancelled
+void UpdateFramework(
+  const rustLaunchSite::Updater& updater,
+  const rustLaunchSite::CancellationToken& cancel,
+  const int retryDelaySeconds = 0, const bool suppressWarning = false)
+{
+  std::cout << "rustLaunchSite: Entering plugin framework update loop" << std::endl;
+  bool firstTry{true};
+  for(bool update{true}; update && !cancel.IsCancelled();
+    update = updater.CheckFramework())
+  {
+    if (!firstTry)
+    {
+      std::cout << "rustLaunchSite: WARNING: Detected plugin framework version mismatch after update attempt; ";
+      if (retryDelaySeconds > 0)
+      {
+        std::cout << "waiting for " << retryDelaySeconds << " second(s) and then trying again..." << std::endl;
+        if (cancel.WaitFor(std::chrono::seconds(retryDelaySeconds))) { break; }
+      }
+      else
+      {
+        std::cout << "trying again..." << std::endl;
+      }
+    }
+
+    updater.UpdateFramework(suppressWarning);
+
+    firstTry = false;
+  }
+  std::cout << "rustLaunchSite: Completed plugin framework update loop" << std::endl;
+}
+
+// wrapper around Updater::UpdateServer() to loop until update succeeds or is
+//  cancelled
+void UpdateServer(
+  const rustLaunchSite::Updater& updater,
+  const rustLaunchSite::CancellationToken& cancel,
+  const int retryDelaySeconds = 0)
+{
+  std::cout << "rustLaunchSite: Entering server update loop" << std::endl;
+  bool firstTry{true};
+  for(bool update{true}; update && !cancel.IsCancelled();
+    update = updater.CheckServer(cancel))
+  {
+    if (!firstTry)
+    {
+      std::cout << "rustLaunchSite: WARNING: Detected server version mismatch after update attempt; " << std::endl;
+      if (retryDelaySeconds > 0)
+      {
+        std::cout << "waiting for " << retryDelaySeconds << " second(s) and then trying again..." << std::endl;
+        if (cancel.WaitFor(std::chrono::seconds(retryDelaySeconds))) { break; }
+      }
+      else
+      {
+        std::cout << "trying again..." << std::endl;
+      }
+    }
+
+    updater.UpdateServer(cancel);
+
+    firstTry = false;
+  }
+  std::cout << "rustLaunchSite: Completed server update loop" << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  std::cout << "rustLaunchSite: Starting" << std::endl;
+
+  if (argc <= 1)
+  {
+    std::cout << "rustLaunchSite: ERROR: Configuration file/path must be specified as an argument" << std::endl;
+    return RLS_EXIT::ARG;
+  }
+  // optional second argument selects restore mode, with an optional third
+  //  argument naming the backup snapshot to restore
+  const bool restore(argc > 2 && std::string_view(argv[2]) == "--restore");
+  if ((argc > 2 && !restore) || argc > 4)
+  {
+    std::cout << "rustLaunchSite: ERROR: Unrecognized arguments; usage: rustLaunchSite <config> [--restore [snapshot]]" << std::endl;
+    return RLS_EXIT::ARG;
+  }
+
+  // install Ctrl+C handler
+  // TODO: change this to an RAII wrapper so that we clean up at the end
+  const auto handlerId(CtrlCLibrary::SetCtrlCHandler(HandleCtrlC));
+  if (handlerId == CtrlCLibrary::kErrorID)
+  {
+    std::cout << "rustLaunchSite: ERROR: Failed to install Ctrl+C handler" << std::endl;
+    return RLS_EXIT::HANDLER;
+  }
+
+  // create null pointers for all facilities we'll be instantiating, so that we
+  //  can clean them up if an exception is caught
+  std::shared_ptr<rustLaunchSite::Config> configSptr;
+  std::unique_ptr<rustLaunchSite::Server> serverUptr;
+  std::unique_ptr<rustLaunchSite::Updater> updaterUptr;
+
+  RLS_EXIT retVal(RLS_EXIT::SUCCESS);
+  try
+  {
+    // load config file
+    configSptr = std::make_shared<rustLaunchSite::Config>(argv[1]);
+    // restore a backup instead of running the server, if requested
+    if (restore)
+    {
+      rustLaunchSite::Backup backup(configSptr);
+      return backup.Restore(argc > 3 ? argv[3] : "") ?
+        RLS_EXIT::SUCCESS : RLS_EXIT::RESTORE;
+    }
+    // instantiate server manager
+    serverUptr = std::make_unique<rustLaunchSite::Server>(configSptr);
+    // load persistent state, and determine map seeds
+    rustLaunchSite::Cache cache(configSptr->GetPathsCache());
+    if (const auto& healthyTime(cache.Get(HEALTHY_TIME_CACHE_KEY));
+      !healthyTime.empty())
+    {
+      std::cout << "rustLaunchSite: Server was last seen healthy at " << healthyTime << std::endl;
+    }
+    rustLaunchSite::SeedEngine seedEngine(configSptr, cache);
+    serverUptr->SetSeed(seedEngine.GetSeed());
+    // instantiate update manager
+    updaterUptr = std::make_unique<rustLaunchSite::Updater>(
+      configSptr, std::make_shared<rustLaunchSite::Downloader>()
+    );
+    // track server lifecycle state, and how long is spent in each state
+    using State = rustLaunchSite::ServerState::State;
+    rustLaunchSite::ServerState serverState(
+      configSptr->GetPathsData() / "stateHistory.jsonl");
+    // stop/start server, keeping its state up to date
+    const auto stopServer([&serverState, &serverUptr](
+      const rustLaunchSite::CancellationToken& cancel,
+      const std::string& reason)
+    {
+      if (rustLaunchSite::ServerState::IsUp(serverState.GetState()))
+      {
+        serverState.Transition(State::STOPPING, reason);
+      }
+      serverUptr->Stop(cancel, reason);
+      serverState.Transition(State::STOPPED);
+    });
+    const auto startServer([&serverState, &serverUptr](
+      const rustLaunchSite::CancellationToken& cancel,
+      const std::string& reason)
+    {
+      // don't start the server if whatever was being done got cancelled
+      if (cancel.IsCancelled())
+      {
+        serverState.Transition(State::STOPPED, "Cancelled");
+        return false;
+      }
+      serverState.Transition(State::STARTING, reason);
+      if (!serverUptr->Start())
+      {
+        serverState.Transition(State::STOPPED, "Failed to start");
+        return false;
+      }
+      serverState.Transition(State::BOOTING);
+      return true;
+    });
+
+    {
+      const auto [updateServerOnStartup, updateModFrameworkOnStartup] =
+        UpdateCheck(
+          *updaterUptr
+        , startupCancel
+        , configSptr->GetUpdateServerOnStartup()
+        , configSptr->GetUpdateModFrameworkOnStartup()
+        , configSptr->GetUpdateModFrameworkOnServerUpdate())
+      ;
+      if (updateServerOnStartup || updateModFrameworkOnStartup)
+      {
+        serverState.Transition(State::UPDATING, "Startup update(s)");
+        updaterUptr->SnapshotInstall();
+      }
+      if (updateServerOnStartup)
+      {
+        UpdateServer(
+          *updaterUptr, startupCancel,
+          configSptr->GetUpdateServerRetryDelaySeconds());
+      }
+      if (updateModFrameworkOnStartup)
+      {
+        UpdateFramework(
+          *updaterUptr
+        , startupCancel
+        , configSptr->GetUpdateModFrameworkRetryDelaySeconds()
+        , updateServerOnStartup);
+      }
+    }
+    // don't launch the server if Ctrl+C was pressed during startup updates
+    if (startupCancel.IsCancelled())
+    {
+      std::cout << "rustLaunchSite: Ctrl+C signal caught during startup; shutting down" << std::endl;
+      serverState.Transition(State::STOPPED, "Cancelled");
+      return RLS_EXIT::SUCCESS;
+    }
+
+    // launch server
+    std::cout << "rustLaunchSite: Starting server" << std::endl;
+    if (!startServer(startupCancel, "Startup"))
+    {
+      std::cout << "rustLaunchSite: Server failed to start; shutting down" << std::endl;
+      // okay to just abort at this point
+      return RLS_EXIT::START;
+    }
+
+    // start scheduler thread, and set up countdown used to delay shutdowns
+    //  while players are online
+    // NOTE: these must be destroyed before serverUptr, since countdown jobs
+    //  call into it
+    const auto schedulerSptr(std::make_shared<rustLaunchSite::Scheduler>());
+    rustLaunchSite::Countdown countdown(
+      schedulerSptr,
+      configSptr->GetProcessShutdownDelayMarks(),
+      [&serverUptr]() -> std::size_t
+      {
+        const auto& serverInfo(serverUptr->GetInfo());
+        return serverInfo.valid_ ? serverInfo.players_ : 0;
+      },
+      [&serverUptr](const std::string& message)
+      {
+        // don't wait for response, as it comes in with id=-1
+        serverUptr->SendRconCommand("say " + message, false);
+      }
+    );
+    const std::chrono::seconds shutdownDelay(
+      configSptr->GetProcessShutdownDelaySeconds());
+    // what to do when the active countdown (if any) finishes
+    CountdownAction countdownAction(CountdownAction::NONE);
+    // which updates to install when an update countdown finishes
+    bool updateServerPending(false);
+    bool updateModFrameworkPending(false);
+    // proactive restart policy, and reason for pending restart (if any)
+    rustLaunchSite::RestartPolicy restartPolicy(
+      configSptr->GetProcessRestartPolicy());
+    std::string restartReason;
+    // crash loop detection and relaunch backoff
+    rustLaunchSite::CrashLoop crashLoop(configSptr->GetProcessCrashLoop());
+    // hung server detection
+    rustLaunchSite::Watchdog watchdog(configSptr->GetProcessWatchdog());
+    // background map pre-generation for the next seed
+    rustLaunchSite::MapPregen mapPregen(configSptr);
+    // periodic backups
+    rustLaunchSite::Backup backup(configSptr);
+    // automatic wipe handling
+    rustLaunchSite::Wiper wiper(
+      configSptr->GetInstallPath() / "server" /
+        configSptr->GetInstallIdentity(),
+      configSptr->GetWipeBlueprints(),
+      configSptr->GetPathsData() / "wipeHistory.jsonl");
+    // whether the protocol version of the current server instance has been
+    //  checked, and the new version to be cached once a pending wipe is done
+    bool protocolChecked(false);
+    std::string wipeProtocol;
+    // reason for pending wipe (recorded in wipe history), and message shown
+    //  to players
+    std::string wipeReason;
+    std::string wipeMessage;
+
+    // schedule periodic jobs that notify main() of work to do
+    // health and update checks are paused while the server is being
+    //  (re)started, and resume a full interval after it has been
+    std::cout << "rustLaunchSite: Scheduling periodic jobs" << std::endl;
+    const auto healthJob(schedulerSptr->ScheduleEvery(
+      std::chrono::minutes(1),
+      []() { NotifyMain(Event::HEALTH_CHECK); }));
+    const auto updateJob(configSptr->GetUpdateIntervalMinutes() > 0 ?
+      schedulerSptr->ScheduleEvery(
+        std::chrono::minutes(configSptr->GetUpdateIntervalMinutes()),
+        []() { NotifyMain(Event::UPDATE_CHECK); }) :
+      rustLaunchSite::Scheduler::JobId{0});
+    const auto markBackupDue([]() { NotifyMain(Event::BACKUP_DUE); });
+    const auto backupJob(backup.GetInterval().count() > 0 ?
+      schedulerSptr->ScheduleEvery(backup.GetInterval(), markBackupDue) :
+      rustLaunchSite::Scheduler::JobId{0});
+    // cron-scheduled restarts, wipes and backups
+    // these go through the same countdown and stop/start paths as their
+    //  automatic counterparts, and aren't paused
+    std::vector<rustLaunchSite::Scheduler::JobId> cronJobs;
+    if (const auto& schedule(configSptr->GetProcessRestartSchedule());
+      !schedule.empty())
+    {
+      cronJobs.push_back(ScheduleCron(
+        *schedulerSptr, schedule, "restarts",
+        []() { NotifyMain(Event::SCHEDULED_RESTART); }));
+    }
+    if (const auto& schedule(configSptr->GetWipeSchedule()); !schedule.empty())
+    {
+      cronJobs.push_back(ScheduleCron(
+        *schedulerSptr, schedule, "wipes",
+        []() { NotifyMain(Event::SCHEDULED_WIPE); }));
+    }
+    if (!backup.GetSchedule().empty())
+    {
+      cronJobs.push_back(ScheduleCron(
+        *schedulerSptr, backup.GetSchedule(), "backups", markBackupDue));
+    }
+    const auto pauseTimers([&schedulerSptr, healthJob, updateJob]()
+    {
+      schedulerSptr->Pause(healthJob);
+      schedulerSptr->Pause(updateJob);
+    });
+    const auto resumeTimers([&schedulerSptr, healthJob, updateJob]()
+    {
+      schedulerSptr->Resume(healthJob);
+      schedulerSptr->Resume(updateJob);
+    });
+    // do so whenever the server goes down or comes back up
+    serverState.SetListener(
+      [&pauseTimers, &resumeTimers](const State from, const State to)
+      {
+        const bool up(rustLaunchSite::ServerState::IsUp(to));
+        if (up == rustLaunchSite::ServerState::IsUp(from)) { return; }
+        if (up) { resumeTimers(); }
+        else { pauseTimers(); }
+      });
+    // note that a countdown is draining the server of players, if it's up
+    const auto drain([&serverState](const std::string& reason)
+    {
+      if (const auto state(serverState.GetState());
+        state == State::BOOTING || state == State::READY)
+      {
+        serverState.Transition(State::DRAINING, reason);
+      }
+    });
+
+    // lifecycle operations (i.e. stopping, updating, wiping and starting the
+    //  server) run on a worker thread, so that the main loop only dispatches
+    //  them and stays responsive; in particular, Ctrl+C cancels whatever is in
+    //  progress, and other events are deferred until it has finished
+    // NOTE: this must be destroyed before anything its operations use
+    using Outcome = rustLaunchSite::LifecycleWorker::Outcome;
+    using Continuation = std::function<bool(Outcome)>;
+    rustLaunchSite::LifecycleWorker lifecycle(
+      []() { NotifyMain(Event::OPERATION_DONE); });
+    // what main() should do once the current operation finishes; returns
+    //  false if main loop should exit
+    Continuation onOperationDone;
+    const auto startOperation([&lifecycle, &onOperationDone](
+      const std::string& name,
+      rustLaunchSite::LifecycleWorker::Operation operation,
+      Continuation then)
+    {
+      onOperationDone = std::move(then);
+      lifecycle.Start(name, std::move(operation));
+    });
+    // continuation for operations that end by (re)starting the server
+    const auto afterStart([&retVal, &restartPolicy, &protocolChecked](
+      const RLS_EXIT exitCode, const std::string& failure) -> Continuation
+    {
+      return [&retVal, &restartPolicy, &protocolChecked, exitCode, failure](
+        const Outcome outcome)
+      {
+        if (outcome != Outcome::SUCCEEDED)
+        {
+          std::cout << "rustLaunchSite: " << failure << "; shutting down" << std::endl;
+          retVal = exitCode;
+          return false;
+        }
+        restartPolicy.Reset();
+        protocolChecked = false;
+        return true;
+      };
+    });
+    // whether the server is being stopped so that rustLaunchSite can exit
+    bool exiting(false);
+    const auto shutDown([&exiting, &startOperation, &stopServer, &retVal]()
+    {
+      exiting = true;
+      startOperation(
+        "server shutdown",
+        [&stopServer](const rustLaunchSite::CancellationToken& cancel)
+        {
+          stopServer(cancel, "Server manager terminated");
+          return true;
+        },
+        [&retVal](const Outcome)
+        {
+          // as Ctrl+C is the only orderly shutdown stimulus, we want to report
+          //  a successful exit
+          retVal = RLS_EXIT::SUCCESS;
+          return false;
+        });
+    });
+    // whether Ctrl+C cancelled the current operation, and should be handled
+    //  once it has finished
+    bool ctrlCPending(false);
+    // whether a periodic backup is due; this is handled by the next health
+    //  check, once the server is up
+    bool backupDue(false);
+
+    // main loop
+    // bool gotProtocol(false);
+    std::cout << "rustLaunchSite: Starting main event loop" << std::endl;
+    while (true)
+    {
+      // grab mutex for safe state variable access in loop when awake
+      std::unique_lock lock(threadData::mutex_);
+      // sleep until a scheduled job, the lifecycle worker, or the Ctrl+C
+      //  handler posts an event, and then take the next one to handle
+      // operation completion comes first, so that a finished operation's
+      //  continuation runs before a Ctrl+C that arrived meanwhile is handled,
+      //  and then Ctrl+C; other events are left pending while an operation is
+      //  in progress
+      // std::cout << "rustLaunchSite: Waiting for events" << std::endl;
+      const auto findEvent([&lifecycle]()
+      {
+        auto& events(threadData::events_);
+        for (const auto urgent : {Event::OPERATION_DONE, Event::CTRL_C})
+        {
+          const auto it(std::find(events.begin(), events.end(), urgent));
+          if (it != events.end()) { return it; }
+        }
+        return lifecycle.IsBusy() ? events.end() : events.begin();
+      });
+      threadData::cvMain_.wait(
+        lock,
+        [&findEvent]() { return findEvent() != threadData::events_.end(); });
+      const auto eventIt(findEvent());
+      auto event(*eventIt);
+      threadData::events_.erase(eventIt);
+      // std::cout << "rustLauchSite: Woke up with event " << static_cast<int>(event) << std::endl;
+      // handle lifecycle operation completion notification
+      if (event == Event::OPERATION_DONE)
+      {
+        // the worker has already notified us, so this won't block for long
+        const auto outcome(lifecycle.Finish());
+        const Continuation then(std::move(onOperationDone));
+        onOperationDone = nullptr;
+        // operation was cancelled by Ctrl+C, so handle that instead
+        if (ctrlCPending)
+        {
+          ctrlCPending = false;
+          event = Event::CTRL_C;
+        }
+        else if (then && !then(outcome))
+        {
+          break;
+        }
+      }
+      // handle Ctrl+C notification
+      if (event == Event::CTRL_C)
+      {
+        if (exiting)
+        {
+          std::cout << "rustLaunchSite: Ctrl+C signal caught; already stopping server" << std::endl;
+          continue;
+        }
+        // abandon whatever is in progress, and start shutting down once it has
+        //  returned
+        if (lifecycle.IsBusy())
+        {
+          std::cout << "rustLaunchSite: Ctrl+C signal caught; cancelling " << lifecycle.GetName() << std::endl;
+          lifecycle.Cancel();
+          ctrlCPending = true;
+          continue;
+        }
+        // start an orderly shutdown, giving players a chance to log off, unless
+        //  that's already what we're doing
+        if (countdownAction != CountdownAction::EXIT)
+        {
+          // this overrides any pending update
+          countdown.Cancel();
+          if (countdown.Start(
+            shutdownDelay, "Server manager terminated", &HandleCountdown))
+          {
+            std::cout << "rustLaunchSite: Ctrl+C signal caught; starting shutdown countdown (press Ctrl+C again to skip)" << std::endl;
+            countdownAction = CountdownAction::EXIT;
+            drain("Server manager terminated");
+            continue;
+          }
+        }
+        // Ctrl+C during shutdown countdown: skip the rest of it
+        std::cout << "rustLaunchSite: Ctrl+C signal caught; stopping server" << std::endl;
+        countdown.Cancel();
+        countdownAction = CountdownAction::NONE;
+        shutDown();
+        continue;
+      }
+      // note that a periodic backup is due
+      if (event == Event::BACKUP_DUE)
+      {
+        backupDue = true;
+      }
+      // handle shutdown countdown completion notification
+      if (event == Event::COUNTDOWN_DONE)
+      {
+        const auto action(countdownAction);
+        countdownAction = CountdownAction::NONE;
+        if (action == CountdownAction::EXIT)
+        {
+          shutDown();
+        }
+        if (action == CountdownAction::UPDATE)
+        {
+          std::cout << "rustLaunchSite: Update countdown complete; stopping server" << std::endl;
+          startOperation(
+            "update installation",
+            [&serverState, &stopServer, &startServer, &updaterUptr,
+              &configSptr, &mapPregen,
+              updateServer = updateServerPending,
+              updateModFramework = updateModFrameworkPending]
+            (const rustLaunchSite::CancellationToken& cancel)
+            {
+              stopServer(cancel, "Installing updates");
+              // don't pull the installation out from under map
+              //  pre-generation
+              mapPregen.Cancel();
+              if (cancel.IsCancelled()) { return false; }
+              // install updates
+              serverState.Transition(State::UPDATING, "Installing updates");
+              if (updateServer || updateModFramework)
+              {
+                updaterUptr->SnapshotInstall();
+              }
+              if (updateServer)
+              {
+                UpdateServer(
+                  *updaterUptr, cancel,
+                  configSptr->GetUpdateServerRetryDelaySeconds());
+              }
+              if (updateModFramework)
+              {
+                UpdateFramework(
+                  *updaterUptr
+                , cancel
+                , configSptr->GetUpdateModFrameworkRetryDelaySeconds()
+                , updateServer);
+              }
+              std::cout << "rustLaunchSite: Update(s) complete; starting server" << std::endl;
+              return startServer(cancel, "Update(s) installed");
+            },
+            afterStart(RLS_EXIT::UPDATE, "Server failed to start"));
+          updateServerPending = false;
+          updateModFrameworkPending = false;
+        }
+        if (action == CountdownAction::RESTART)
+        {
+          std::cout << "rustLaunchSite: Restart countdown complete; restarting server" << std::endl;
+          startOperation(
+            "server restart",
+            [&stopServer, &startServer, reason = restartReason]
+            (const rustLaunchSite::CancellationToken& cancel)
+            {
+              stopServer(cancel, reason);
+              return startServer(cancel, "Restart");
+            },
+            afterStart(RLS_EXIT::RESTART, "Server failed to restart"));
+          restartReason.clear();
+        }
+        if (action == CountdownAction::WIPE)
+        {
+          std::cout << "rustLaunchSite: Wipe countdown complete; stopping server" << std::endl;
+          startOperation(
+            "server wipe",
+            [&stopServer, &startServer, &serverUptr, &mapPregen, &backup,
+              &seedEngine, &wiper, &cache, reason = wipeReason,
+              message = wipeMessage, protocol = wipeProtocol]
+            (const rustLaunchSite::CancellationToken& cancel)
+            {
+              stopServer(cancel, message);
+              mapPregen.Cancel();
+              // take a final backup of the old world, which is consistent now
+              //  that the server has stopped
+              if (backup.IsEnabled() && !cancel.IsCancelled())
+              {
+                backup.Run("Before wipe", cancel);
+              }
+              // don't wipe if cancelled, as the world hasn't been touched yet
+              if (cancel.IsCancelled()) { return false; }
+              // move on to the next seed, but keep its map, as it may have
+              //  been pre-generated
+              serverUptr->SetSeed(seedEngine.Advance());
+              wiper.Wipe(
+                reason,
+                [seed = seedEngine.GetSeed(),
+                  worldSize = serverUptr->GetWorldSize()]
+                (const std::filesystem::path& path)
+                {
+                  return rustLaunchSite::MapPregen::IsMapFor(
+                    path, seed, worldSize);
+                });
+              if (!protocol.empty())
+              {
+                cache.Set(PROTOCOL_CACHE_KEY, protocol);
+              }
+              std::cout << "rustLaunchSite: Wipe complete; starting server" << std::endl;
+              return startServer(cancel, "Wipe complete");
+            },
+            afterStart(RLS_EXIT::RESTART, "Server failed to start after wipe"));
+          wipeProtocol.clear();
+        }
+      }
+      // handle relaunch notification
+      if (event == Event::RELAUNCH)
+      {
+        // skip if a shutdown was requested while waiting to relaunch
+        if (countdownAction == CountdownAction::NONE)
+        {
+          std::cout << "rustLaunchSite: Relaunching server" << std::endl;
+          startOperation(
+            "server relaunch",
+            [&startServer](const rustLaunchSite::CancellationToken& cancel)
+            {
+              return startServer(cancel, "Relaunch after backoff");
+            },
+            afterStart(RLS_EXIT::RESTART, "Server failed to relaunch"));
+        }
+      }
+      // handle scheduled restart/wipe notifications
+      // these are skipped if a countdown is already in progress (which will
+      //  stop the server anyway), or if the server isn't running (e.g. it's
+      //  waiting to be relaunched after crashing)
+      if (event == Event::SCHEDULED_RESTART)
+      {
+        if (countdownAction != CountdownAction::NONE ||
+          !serverUptr->IsRunning())
+        {
+          std::cout << "rustLaunchSite: Skipping scheduled restart because a countdown is in progress or the server is not running" << std::endl;
+        }
+        else
+        {
+          std::cout << "rustLaunchSite: Scheduled restart due; starting shutdown countdown" << std::endl;
+          restartReason = "Scheduled restart";
+          countdownAction = CountdownAction::RESTART;
+          countdown.Start(shutdownDelay, restartReason, &HandleCountdown);
+          drain(restartReason);
+        }
+      }
+      if (event == Event::SCHEDULED_WIPE)
+      {
+        if (countdownAction != CountdownAction::NONE ||
+          !serverUptr->IsRunning())
+        {
+          std::cout << "rustLaunchSite: Skipping scheduled wipe because a countdown is in progress or the server is not running" << std::endl;
+        }
+        else
+        {
+          std::cout << "rustLaunchSite: Scheduled wipe due; starting wipe countdown" << std::endl;
+          wipeReason = "Scheduled wipe";
+          wipeMessage = "Wiping server";
+          countdownAction = CountdownAction::WIPE;
+          countdown.Start(shutdownDelay, wipeMessage, &HandleCountdown);
+          drain(wipeReason);
+        }
+      }
+      // handle update check timer notification
+      if (event == Event::UPDATE_CHECK)
+      {
+        // check for updates, unless a countdown is already in progress
+        // this runs SteamCMD, so it's done on the worker as well
+        if (countdownAction == CountdownAction::NONE)
+        {
+          startOperation(
+            "update check",
+            [&updaterUptr, &configSptr, &updateServerPending,
+              &updateModFrameworkPending]
+            (const rustLaunchSite::CancellationToken& cancel)
+            {
+              std::tie(updateServerPending, updateModFrameworkPending) =
+                UpdateCheck(
+                  *updaterUptr
+                , cancel
+                , configSptr->GetUpdateServerOnStartup()
+                , configSptr->GetUpdateModFrameworkOnStartup()
+                , configSptr->GetUpdateModFrameworkOnServerUpdate());
+              return true;
+            },
+            [&updateServerPending, &updateModFrameworkPending,
+              &countdownAction, &countdown, &drain, shutdownDelay]
+            (const Outcome)
+            {
+              // if any are needed: count down to taking server down, and then
+              //  install updates and relaunch server when countdown finishes
+              if (updateServerPending || updateModFrameworkPending)
+              {
+                std::cout << "rustLaunchSite: Update(s) required; starting shutdown countdown" << std::endl;
+                countdownAction = CountdownAction::UPDATE;
+                countdown.Start(
+                  shutdownDelay, "Installing updates", &HandleCountdown);
+                drain("Installing updates");
+              }
+              return true;
+            });
+        }
+      }
+      // handle server health check timer notification
+      if (event == Event::HEALTH_CHECK)
+      {
+        // check if server is running
+        if (serverUptr->IsRunning())
+        {
+          // server is running; check for protocol via RCON
+          // just poll every time, as RCON connection seems to die if we don't
+          //  use it?
+          // if (!gotProtocol)
+          // {
+          // this may wait on RCON for a while, so let go of the mutex in the
+          //  meantime, so that the Ctrl+C handler and scheduled jobs can still
+          //  post notifications; nothing else touches the server while no
+          //  operation is in progress
+          lock.unlock();
+          const auto serverInfo(serverUptr->GetInfo());
+          lock.lock();
+          if (serverInfo.valid_)
+          {
+            rustLaunchSite::RestartPolicy::Observation observation;
+            observation.time_ = std::chrono::steady_clock::now();
+            observation.framerate_ = serverInfo.framerate_;
+            observation.entityCount_ = serverInfo.entityCount_;
+            observation.uptimeSeconds_ = serverInfo.uptimeSeconds_;
+            // prefer resident set size as measured by the OS, and fall back to
+            //  server's own report if that's unavailable
+            observation.memoryMb_ = serverInfo.memoryUsageSystemMb_ ?
+              serverInfo.memoryUsageSystemMb_ : serverInfo.memoryMb_;
+            // this is a cheap append, and tells how long the server was down
+            //  if rustLaunchSite itself dies (e.g. due to power loss)
+            cache.Set(
+              HEALTHY_TIME_CACHE_KEY,
+              rustLaunchSite::History::ToIsoString(
+                std::chrono::system_clock::now()));
+            // gotProtocol = true;
+            // compare protocol version against the one last seen, once per
+            //  server launch, and wipe if it changed
+            if (!protocolChecked && !serverInfo.protocol_.empty() &&
+              countdownAction == CountdownAction::NONE)
+            {
+              protocolChecked = true;
+              // keep track of when the installed server build changed
+              if (const auto& build(updaterUptr->GetInstalledServerBuild());
+                !build.empty() && build != cache.Get(BUILD_CACHE_KEY))
+              {
+                cache.Set(BUILD_CACHE_KEY, build);
+                cache.Set(
+                  BUILD_TIME_CACHE_KEY,
+                  rustLaunchSite::History::ToIsoString(
+                    std::chrono::system_clock::now()));
+              }
+              const auto& lastProtocol(cache.Get(PROTOCOL_CACHE_KEY));
+              if (lastProtocol == serverInfo.protocol_)
+              {
+                // nothing to do
+              }
+              // first run, or wiping disabled: just remember the new version
+              else if (lastProtocol.empty() ||
+                !configSptr->GetWipeOnProtocolChange())
+              {
+                cache.Set(PROTOCOL_CACHE_KEY, serverInfo.protocol_);
+              }
+              else
+              {
+                std::cout << "rustLaunchSite: Server protocol changed from " << lastProtocol << " to " << serverInfo.protocol_ << "; starting wipe countdown" << std::endl;
+                wipeProtocol = serverInfo.protocol_;
+                wipeReason = "Protocol changed from " + lastProtocol + " to " +
+                  serverInfo.protocol_;
+                wipeMessage = "Wiping for new game version";
+                countdownAction = CountdownAction::WIPE;
+                countdown.Start(shutdownDelay, wipeMessage, &HandleCountdown);
+                drain(wipeReason);
+              }
+            }
+            std::cout
+              << "rustLaunchSite: Got server info via RCON:"
+              << "\n\tplayers=" << serverInfo.players_
+              << "\n\tprotocol=" << serverInfo.protocol_
+              << "\n\tready=" << serverUptr->IsReady()
+              << "\n\tstate="
+              << rustLaunchSite::ServerState::ToString(serverState.GetState())
+              << " for " << std::chrono::duration_cast<std::chrono::seconds>(
+                serverState.GetTimeInState()).count() << 's';
+            if
+            (
+              const auto& samples(serverUptr->GetResourceSamples(1));
+              !samples.empty()
+            )
+            {
+              std::cout
+                << "\n\tcpu=" << static_cast<int>(samples.back().cpuPercent_)
+                << "%\n\trss=" << (samples.back().rssBytes_ >> 20) << "MiB";
+              if (samples.back().rssBytes_)
+              {
+                observation.memoryMb_ = samples.back().rssBytes_ >> 20;
+              }
+            }
+            for (const auto& [name, event] : serverUptr->GetLogEvents())
+            {
+              std::cout << "\n\tlog." << name << '=' << event.count_;
+            }
+            std::cout << std::endl;
+            // check whether server has degraded enough to warrant a proactive
+            //  restart, unless a countdown is already in progress
+            if (countdownAction == CountdownAction::NONE)
+            {
+              restartReason = restartPolicy.Evaluate(observation);
+              if (!restartReason.empty())
+              {
+                std::cout << "rustLaunchSite: Restart required (" << restartReason << "); starting shutdown countdown" << std::endl;
+                countdownAction = CountdownAction::RESTART;
+                countdown.Start(
+                  shutdownDelay, "Restarting to restore performance",
+                  &HandleCountdown);
+                drain(restartReason);
+              }
+            }
+            // }
+          }
+          // note when the server has finished booting
+          if (serverState.GetState() == State::BOOTING &&
+            serverUptr->IsReady())
+          {
+            serverState.Transition(State::READY);
+          }
+          // once the server has stayed ready for a whole crash loop detection
+          //  window, the update it's running is evidently fine, so crashing
+          //  after that shouldn't roll it back
+          if (serverState.GetState() == State::READY &&
+            serverState.GetTimeInState() >= std::chrono::minutes(
+              configSptr->GetProcessCrashLoop().windowMinutes_))
+          {
+            updaterUptr->ExpireInstallSnapshot();
+          }
+          // pre-generate the map for the next seed once the server is up, so
+          //  that it doesn't compete with the server's own boot
+          if (serverUptr->IsReady() &&
+            countdownAction == CountdownAction::NONE)
+          {
+            mapPregen.Start(
+              seedEngine.GetNextSeed(), serverUptr->GetWorldSize());
+          }
+          // check whether server is hung; this only applies once it has
+          //  finished booting, as boot times vary wildly, and not during a
+          //  countdown, which will stop the server regardless
+          if (!serverUptr->IsReady() ||
+            countdownAction != CountdownAction::NONE)
+          {
+            watchdog.Reset();
+          }
+          else
+          {
+            rustLaunchSite::Watchdog::Observation liveness;
+            liveness.time_ = std::chrono::steady_clock::now();
+            liveness.responsive_ = serverInfo.valid_;
+            liveness.framerate_ = serverInfo.framerate_;
+            liveness.outputLines_ = serverUptr->GetOutputLineCount();
+            if
+            (
+              const auto& hangReason(watchdog.Evaluate(liveness));
+              !hangReason.empty()
+            )
+            {
+              std::cout << "rustLaunchSite: WARNING: Server appears to be hung (" << hangReason << "); killing it" << std::endl;
+              const auto reason("Server hung: " + hangReason);
+              serverState.Transition(State::STOPPING, reason);
+              watchdog.Reset();
+              startOperation(
+                "hung server termination",
+                [&serverUptr, &serverState, reason]
+                (const rustLaunchSite::CancellationToken& cancel)
+                {
+                  serverUptr->Stop(cancel, reason, true);
+                  serverState.Transition(State::CRASHED, reason);
+                  return true;
+                },
+                [](const Outcome)
+                {
+                  // treat this like any other unexpected stop on the next
+                  //  pass
+                  QueueEvent(Event::HEALTH_CHECK);
+                  return true;
+                });
+            }
+          }
+          // back up periodically once the server is up, right after having it
+          //  save, so that save files are consistent
+          // saving and backing up can take a while, so both are done on the
+          //  worker, where Ctrl+C can cancel them
+          if (backupDue && serverUptr->IsReady() &&
+            countdownAction == CountdownAction::NONE && !lifecycle.IsBusy())
+          {
+            backupDue = false;
+            startOperation(
+              "periodic backup",
+              [&serverUptr, &backup]
+              (const rustLaunchSite::CancellationToken& cancel)
+              {
+                if (!serverUptr->Save(cancel))
+                {
+                  if (!cancel.IsCancelled())
+                  {
+                    std::cout << "WARNING: Skipping periodic backup because server failed to save" << std::endl;
+                  }
+                  return false;
+                }
+                if (cancel.IsCancelled()) { return false; }
+                return backup.Run("Periodic", cancel).success_;
+              },
+              nullptr);
+          }
+        }
+        // server is not running, but a countdown is in progress
+        // nobody can be online, so it will finish shortly and take it from there
+        else if (countdownAction != CountdownAction::NONE)
+        {
+          std::cout << "rustLaunchSite: Server stopped during countdown; waiting for countdown to finish" << std::endl;
+          serverUptr->HandleUnexpectedExit();
+        }
+        // server is not running
+        else if (configSptr->GetProcessAutoRestart())
+        {
+          // configured to automatically restart
+          std::cout << "rustLaunchSite: Server stopped unexpectedly" << std::endl;
+          serverState.Transition(State::CRASHED, "Server stopped unexpectedly");
+          // preserve crash artifacts right away, before recovery (e.g.
+          //  rolling back the installation, which may contain the server log
+          //  file) or a relaunch can destroy them
+          serverUptr->HandleUnexpectedExit();
+          // don't pull the installation out from under map pre-generation
+          mapPregen.Cancel();
+          if
+          (
+            const auto crash(crashLoop.RecordCrash());
+            crash.looping_
+          )
+          {
+            // don't check for updates while crash looping, so that a broken
+            //  server doesn't hammer SteamCMD/GitHub on every relaunch
+            std::cout << "rustLaunchSite: WARNING: Server is crash looping (" << crash.crashes_ << " recent crashes); delaying relaunch by " << std::chrono::duration_cast<std::chrono::seconds>(crash.delay_).count() << " second(s)" << std::endl;
+            serverState.Transition(State::BACKOFF, "Crash looping");
+            startOperation(
+              "crash loop recovery",
+              [&updaterUptr, crash]
+              (const rustLaunchSite::CancellationToken& cancel)
+              {
+                // restoring the whole installation also undoes any plugin
+                //  framework update, so only fall back to rolling that back
+                bool restored(false);
+                if (crash.restore_)
+                {
+                  std::cout << "rustLaunchSite: Restoring server installation from pre-update snapshot" << std::endl;
+                  restored = updaterUptr->RollbackInstall();
+                }
+                if (crash.rollback_ && !restored)
+                {
+                  std::cout << "rustLaunchSite: Rolling back last plugin framework update" << std::endl;
+                  updaterUptr->RollbackFramework();
+                }
+                // SteamCMD can't validate without also updating to the latest
+                //  build, which would undo a restore, so only validate when
+                //  nothing was restored
+                if (crash.validate_ && !restored && !cancel.IsCancelled())
+                {
+                  std::cout << "rustLaunchSite: Validating server installation" << std::endl;
+                  updaterUptr->UpdateServer(cancel);
+                }
+                return true;
+              },
+              [&schedulerSptr, delay = crash.delay_](const Outcome)
+              {
+                // wait on the scheduler thread, so that Ctrl+C is still
+                //  handled
+                schedulerSptr->ScheduleAfter(delay, &HandleRelaunch);
+                return true;
+              });
+          }
+          else
+          {
+            // check for updates while the server is down, and then relaunch
+            //  it immediately
+            startOperation(
+              "server relaunch",
+              [&serverState, &startServer, &updaterUptr, &configSptr]
+              (const rustLaunchSite::CancellationToken& cancel)
+              {
+                const auto
+                  [updateServerOnRelaunch, updateModFrameworkOnRelaunch] =
+                    UpdateCheck(
+                      *updaterUptr
+                    , cancel
+                    , configSptr->GetUpdateServerOnRelaunch()
+                    , configSptr->GetUpdateModFrameworkOnRelaunch()
+                    , configSptr->GetUpdateModFrameworkOnServerUpdate())
+                ;
+                if (updateServerOnRelaunch || updateModFrameworkOnRelaunch)
+                {
+                  serverState.Transition(
+                    State::UPDATING, "Relaunch update(s)");
+                  updaterUptr->SnapshotInstall();
+                }
+                if (updateServerOnRelaunch)
+                {
+                  UpdateServer(
+                    *updaterUptr, cancel,
+                    configSptr->GetUpdateServerRetryDelaySeconds());
+                }
+                if (updateModFrameworkOnRelaunch)
+                {
+                  UpdateFramework(
+                    *updaterUptr
+                  , cancel
+                  , configSptr->GetUpdateModFrameworkRetryDelaySeconds()
+                  , updateServerOnRelaunch);
+                }
+                std::cout << "rustLaunchSite: Relaunching server" << std::endl;
+                return startServer(cancel, "Relaunch");
+              },
+              afterStart(RLS_EXIT::RESTART, "Server failed to relaunch"));
+          }
+        }
+        else
+        {
+          // configured to shutdown on unexpected server stop
+            std::cout << "rustLaunchSite: Server stopped unexpectedly; shutting down" << std::endl;
+          serverState.Transition(State::CRASHED, "Server stopped unexpectedly");
+          serverUptr->HandleUnexpectedExit();
+          retVal = RLS_EXIT::RESTART;
+          break;
+        }
+      }
+      // end of main loop
+    }
+
+    std::cout << "rustLaunchSite: Exited main loop; beginning shutdown process" << std::endl;
+    // don't leave an operation running against a server that's being stopped
+    lifecycle.Cancel();
+    lifecycle.Finish();
+    std::cout << "rustLaunchSite: Cancelling periodic jobs" << std::endl;
+    schedulerSptr->Cancel(healthJob);
+    schedulerSptr->Cancel(updateJob);
+    schedulerSptr->Cancel(backupJob);
+    for (const auto cronJob : cronJobs) { schedulerSptr->Cancel(cronJob); }
+    std::cout << "rustLaunchSite: Stopping server (if running)" << std::endl;
+    stopServer(
+      rustLaunchSite::CancellationToken(), "Server manager shutting down");
+    std::cout << "rustLaunchSite: Time spent in each server state:";
+    for (std::size_t i(0); i < rustLaunchSite::ServerState::STATE_COUNT; ++i)
+    {
+      const auto state(static_cast<State>(i));
+      std::cout
+        << "\n\t" << rustLaunchSite::ServerState::ToString(state) << '='
+        << std::chrono::duration_cast<std::chrono::seconds>(
+          serverState.GetTotalTime(state)).count() << 's';
+    }
+    std::cout
+      << "\n\tavailability=" << serverState.GetAvailability() * 100.0 << '%'
+      << std::endl;
+  }
+  catch (const std::exception& e)
+  {
+    std::cout << "rustLaunchSite: ERROR: Unhandled exception: " << e.what() << std::endl;
+    retVal = RLS_EXIT::EXCEPTION;
+  }
+  catch(...)
+  {
+    std::cout << "rustLaunchSite: ERROR: Unknown exception" << std::endl;
+    retVal = RLS_EXIT::EXCEPTION;
+  }
+
+  std::cout << "rustLaunchSite: Exiting" << std::endl;
+
+  return retVal;
+}